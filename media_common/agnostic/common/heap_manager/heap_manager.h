@@ -222,8 +222,8 @@ private:
     static const uint32_t m_heapAlignment = MOS_PAGE_SIZE;
     //! \brief Timeout in milliseconds for wait, currently fixed
     static const uint32_t m_waitTimeout = 100;
-    //! \brief Wait increment in milliseconds, currently fixed
-    static const uint32_t m_waitIncrement = 10;
+    //! \brief Max interval in microseconds between block state refreshes while waiting
+    static const uint32_t m_waitMaxIntervalUs = 1000;
 
     //! \brief Memory block manager for the heap(s)
     MemoryBlockManager m_blockManager;
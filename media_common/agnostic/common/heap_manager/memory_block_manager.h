@@ -340,6 +340,41 @@ private:
         MemoryBlockInternal *block,
         MemoryBlockInternal::State state);
 
+    //!
+    //! \brief  Links a block into the sorted list for \a state between \a prev and \a next
+    //! \param  [in] block
+    //!         Block to be linked, must not be in any list
+    //! \param  [in] state
+    //!         Type of pool to be added to
+    //! \param  [in] prev
+    //!         Block preceding \a block, nullptr to insert at the beginning
+    //! \param  [in] next
+    //!         Block following \a block, nullptr to insert at the end
+    //!
+    void InsertBlockToSortedList(
+        MemoryBlockInternal *block,
+        MemoryBlockInternal::State state,
+        MemoryBlockInternal *prev,
+        MemoryBlockInternal *next);
+
+    //!
+    //! \brief  Gets the size class of a free block \see m_freeBins
+    //! \param  [in] size
+    //!         Size of the free block
+    //! \return uint32_t
+    //!         Bin index, larger sizes never map to a lower bin
+    //!
+    static uint32_t GetFreeBin(uint32_t size);
+
+    //!
+    //! \brief  Finds the largest non empty free bin below \a bin
+    //! \param  [in] bin
+    //!         Bin to search below
+    //! \return int32_t
+    //!         Bin index, -1 if all lower bins are empty
+    //!
+    int32_t FindFreeBinBelow(uint32_t bin);
+
     //!
     //! \brief  Gets a pool type block from the sorted block pool, if pool is empty allocates a new one
     //!         \see m_sortedBlockList[MemoryBlockInternal::State::pool]
@@ -411,6 +446,10 @@ private:
     static const uint16_t m_heapAlignment = MOS_PAGE_SIZE;
     //! \brief Number of submissions before a refresh, currently fixed
     static const uint16_t m_numSubmissionsForRefresh = 128;
+    //! \brief Log2 of the number of free bins each power of two size range is split into
+    static const uint32_t m_freeBinSubdivisionBits = 3;
+    //! \brief Number of free bins needed to cover all 32 bit block sizes
+    static const uint32_t m_freeBinCount = (32 - m_freeBinSubdivisionBits + 1) << m_freeBinSubdivisionBits;
 
     //! \brief Total size of all managed heaps.
     uint32_t m_totalSizeOfHeaps = 0;
@@ -419,8 +458,15 @@ private:
     //! \brief List of block pools per heap for heaps in deletion process
     std::list<std::shared_ptr<HeapWithAdjacencyBlockList>> m_deletedHeaps;
     //! \brief Pools of memory blocks sorted by their states based on the state indicated
-    //!        by the latest TrackerId. The free pool is sorted in ascending order.
+    //!        by the latest TrackerId. The free pool is sorted in descending size order and
+    //!        the submitted pool in ascending tracker ID order.
     MemoryBlockInternal *m_sortedBlockList[MemoryBlockInternal::State::stateCount] = {nullptr};
+    //! \brief Last block of each sorted block list.
+    MemoryBlockInternal *m_sortedBlockListTail[MemoryBlockInternal::State::stateCount] = {nullptr};
+    //! \brief First (largest) block of each free size class within the free pool \see GetFreeBin
+    MemoryBlockInternal *m_freeBins[m_freeBinCount] = {nullptr};
+    //! \brief Bit set for each non empty entry of \see m_freeBins
+    uint64_t m_freeBinMask[(m_freeBinCount + 63) / 64] = {0};
     //! \brief Number of entries in each sorted block list.
     uint32_t m_sortedBlockListNumEntries[MemoryBlockInternal::State::stateCount] = {0};
     //! \brief Sizes of each block pool.
@@ -73,6 +73,13 @@
 #define DL_CACHE_BLOCK_SIZE (128 * 1024)                                               // Kernel allocation block size
 #define DL_COMBINED_KERNEL_CACHE_SIZE (DL_CACHE_BLOCK_SIZE * DL_NEW_COMBINED_KERNELS)  // Combined kernel size
 
+#define DL_PERSISTENT_CACHE_MAGIC 0x4344444b    // "KDDC"
+#define DL_PERSISTENT_CACHE_VERSION 1           // bump when the record layout changes
+#define DL_PERSISTENT_CACHE_MAX_KERNELS 256     // Max number of kernels in the cache file
+#define DL_PERSISTENT_CACHE_ENV "VP_KDLL_CACHE_FILE"  // Environment variable naming the cache file
+
+#define DL_RULE_INDEX_FORMATS (Format_Count - Format_None)  // Formats in the rule index, Format_None included
+
 #define DL_PROCAMP_DISABLED -1  // procamp is disabled
 #define DL_PROCAMP_MAX 1        // 1 Procamp entry
 
@@ -477,6 +484,14 @@ typedef struct tagKdll_RuleEntrySet
     uint32_t              iSetCount : 12;    // Size of Set Rules (including variable length rules)
 } Kdll_RuleEntrySet;
 
+// Rule sets of a parser state which may match each format, in table order
+typedef struct tagKdll_RuleIndex
+{
+    Kdll_RuleID id;      // Format rule used as key, RID_Op_EOF if the state is not indexed
+    uint32_t *  pStart;  // Candidates for format f are pList[pStart[f - Format_None]] to pList[pStart[f - Format_None + 1]]
+    uint16_t *  pList;   // Rule set indices within the parser state
+} Kdll_RuleIndex;
+
 // Structure that defines a set of procamp parameters
 typedef struct tagKdll_Procamp
 {
@@ -646,6 +661,33 @@ typedef struct tagKdll_KernelHashTable
     Kdll_KernelHashEntry HashEntry[DL_MAX_COMBINED_KERNELS];  // Hash table entries
 } Kdll_KernelHashTable;
 
+//--------------------------------------------------------------
+// Persistent combined kernel cache file
+//--------------------------------------------------------------
+typedef struct tagKdll_PersistentCacheHeader
+{
+    uint32_t dwMagic;     // DL_PERSISTENT_CACHE_MAGIC
+    uint32_t dwVersion;   // DL_PERSISTENT_CACHE_VERSION
+    uint32_t dwLayout;    // Filter and CSC parameter struct sizes
+    uint32_t dwKey;       // Hash of component kernels, patch kernels and rules
+    uint32_t dwCount;     // Number of records
+    uint32_t dwSize;      // Size of the records following the header
+    uint32_t dwChecksum;  // FNV-1a hash of the records
+    uint32_t dwReserved;
+} Kdll_PersistentCacheHeader;
+
+// Record followed by the search filter, the modified filter and the kernel binary
+typedef struct tagKdll_PersistentCacheRecord
+{
+    uint32_t        dwSize;            // Record size including payload (8 byte aligned)
+    uint32_t        dwHash;            // Search filter hash
+    int32_t         iFilter;           // Search filter size
+    int32_t         iFilterSize;       // Modified filter size
+    int32_t         iKernelSize;       // Kernel size
+    VPHAL_CSPACE    colorfill_cspace;  // Intermediate color space for colorfill
+    Kdll_CSC_Params CscParams;         // Kernel CSC parameters
+} Kdll_PersistentCacheRecord;
+
 //--------------------------------------------------------------
 // Dynamic linking state
 //--------------------------------------------------------------
@@ -674,6 +716,7 @@ typedef struct tagKdll_State
 
     Kdll_RuleEntrySet *pDllRuleTable[Parser_Count];  // Rule acceleration table (one entry for each Parser State)
     int                iDllRuleCount[Parser_Count];  // Rule count (number of entries for each Parser State)
+    Kdll_RuleIndex     RuleIndex[Parser_Count];      // Rule sets indexed by format (one entry for each Parser State)
 
     // Combined kernel cache and hash table
     Kdll_KernelCache     KernelCache;      // Output kernel cache
@@ -685,6 +728,15 @@ typedef struct tagKdll_State
     // Colorfill
     VPHAL_CSPACE colorfill_cspace;  // Selected colorfill Color Space by Kdll
 
+    // Persistent combined kernel cache (shared between processes)
+    char *   pPersistentCachePath;     // Cache file, nullptr if disabled
+    uint32_t dwPersistentCacheKey;     // Hash of component kernels, patch kernels and rules
+    uint8_t *pPersistentCache;         // Kernel records
+    int32_t  iPersistentCacheSize;     // Size of kernel records
+    int32_t  iPersistentCacheMaxSize;  // Allocated size of kernel records
+    int32_t  iPersistentCacheCount;    // Number of kernel records
+    bool     bPersistentCacheDirty;    // Kernels were added after the file was loaded
+
     // Start kernel search
     void (*pfnStartKernelSearch)(PKdll_State pState,
         PKdll_SearchState                    pSearchState,
@@ -884,6 +936,12 @@ Kdll_State *KernelDll_AllocateStates(
 // Release Kernel Dll State
 void KernelDll_ReleaseStates(Kdll_State *pState);
 
+// Load combined kernels linked by earlier processes, new kernels are saved on release
+bool KernelDll_OpenPersistentCache(Kdll_State *pState, const char *pcPath);
+
+// Save combined kernels to the persistent cache file
+bool KernelDll_SavePersistentCache(Kdll_State *pState);
+
 // Update CSC coefficients
 void KernelDll_UpdateCscCoefficients(Kdll_State *pState,
     Kdll_CSC_Matrix *                            pMatrix);
@@ -38,6 +38,7 @@
 #include "mos_bufmgr.h"
 #include "xf86drm.h"
 
+#include <unordered_map>
 #include <vector>
 
 typedef unsigned int MOS_OS_FORMAT;
@@ -501,6 +502,70 @@ struct MOS_CONTEXT_OFFSET
     uint64_t          offset64;
 };
 
+//!
+//! \brief Relocation offsets of target bos as last reported per GEM context
+//! \details Indexed by target bo so that patching and bo release are O(1);
+//!          a bo is seldom shared by more than a couple of contexts, so the
+//!          per bo context list is scanned linearly.
+//!
+class MosContextOffsetCache
+{
+public:
+    //!
+    //! \brief   Find the offset of target bo in GEM context
+    //! \return  true if found and offset64 is updated, otherwise false
+    //!
+    bool Find(MOS_LINUX_CONTEXT *intelContext, MOS_LINUX_BO *targetBo, uint64_t &offset64) const
+    {
+        auto entry = m_offsets.find(targetBo);
+        if (entry == m_offsets.end())
+        {
+            return false;
+        }
+        for (const auto &item : entry->second)
+        {
+            if (item.intel_context == intelContext)
+            {
+                offset64 = item.offset64;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //!
+    //! \brief   Add or update the offset of target bo in GEM context
+    //!
+    void Update(MOS_LINUX_CONTEXT *intelContext, MOS_LINUX_BO *targetBo, uint64_t offset64)
+    {
+        auto &items = m_offsets[targetBo];
+        for (auto &item : items)
+        {
+            if (item.intel_context == intelContext)
+            {
+                item.offset64 = offset64;
+                return;
+            }
+        }
+        items.push_back({intelContext, targetBo, offset64});
+    }
+
+    //!
+    //! \brief   Drop the offsets of target bo in all GEM contexts
+    //!
+    void Remove(MOS_LINUX_BO *targetBo) { m_offsets.erase(targetBo); }
+
+    //!
+    //! \brief   Drop all offsets and release the memory
+    //!
+    void Clear() { std::unordered_map<MOS_LINUX_BO *, std::vector<MOS_CONTEXT_OFFSET>>().swap(m_offsets); }
+
+    bool Empty() const { return m_offsets.empty(); }
+
+private:
+    std::unordered_map<MOS_LINUX_BO *, std::vector<MOS_CONTEXT_OFFSET>> m_offsets;
+};
+
 // APO related
 #define FUTURE_PLATFORM_MOS_APO   1234
 bool SetupApoMosSwitch(int32_t fd, MediaUserSettingSharedPtr userSettingPtr);
@@ -591,7 +656,7 @@ struct _MOS_OS_CONTEXT
     // GPU Status Buffer
     PMOS_RESOURCE       pGPUStatusBuffer        = nullptr;
 
-    std::vector<struct MOS_CONTEXT_OFFSET> contextOffsetList = {};
+    MosContextOffsetCache contextOffsetCache;  //!< Relocation offsets per GEM context and target bo
 
     bool                bSimIsActive            = false;   //!< To indicate if simulation environment
     bool                m_apoMosEnabled         = false;   //!< apo mos or not
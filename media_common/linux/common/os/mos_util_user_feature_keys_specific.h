@@ -40,5 +40,6 @@
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_SOFTPIN       "Enable Softpin"
 #define __MEDIA_USER_FEATURE_VALUE_DISABLE_KMD_WATCHDOG "Disable KMD Watchdog"
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_VM_BIND       "Enable VM Bind"
+#define __MEDIA_USER_FEATURE_VALUE_BO_CACHE_BUDGET_MB   "BO Cache Budget MB"
 
 #endif // __MOS_UTIL_USER_FEATURE_KEYS_SPECIFIC_H__
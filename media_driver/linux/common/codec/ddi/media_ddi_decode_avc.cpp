@@ -387,27 +387,8 @@ VAStatus DdiDecodeAVC::AllocSliceParamContext(
 {
     uint32_t baseSize = sizeof(CODEC_AVC_SLICE_PARAMS);
 
-    if (m_sliceParamBufNum < (m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices                           = numSlices + 10;
-        m_ddiDecodeCtx->DecodeParams.m_sliceParams = realloc(m_ddiDecodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_ddiDecodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_ddiDecodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum),
-            0,
-            baseSize * extraSlices);
-
-        m_sliceParamBufNum += extraSlices;
-    }
-
-    return VA_STATUS_SUCCESS;
+    return GrowParamArray(&m_ddiDecodeCtx->DecodeParams.m_sliceParams, baseSize,
+        m_sliceParamBufNum, m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices);
 }
 
 VAStatus DdiDecodeAVC::RenderPicture(
@@ -605,7 +586,6 @@ VAStatus DdiDecodeAVC::AllocSliceControlBuffer(
 {
     DDI_CODEC_COM_BUFFER_MGR   *bufMgr;
     uint32_t                    availSize;
-    uint32_t                    newSize;
 
     bufMgr     = &(m_ddiDecodeCtx->BufMgr);
     availSize = m_sliceCtrlBufNum - bufMgr->dwNumSliceControl;
@@ -614,14 +594,8 @@ VAStatus DdiDecodeAVC::AllocSliceControlBuffer(
     {
         if(availSize < buf->uiNumElements)
                 {
-            newSize   = sizeof(VASliceParameterBufferBase) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base = (VASliceParameterBufferBase *)realloc(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base, newSize);
-            if(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferBase) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base, sizeof(VASliceParameterBufferBase),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
         }
         buf->pData      = (uint8_t*)bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base;
         buf->uiOffset   = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferBase);
@@ -630,14 +604,8 @@ VAStatus DdiDecodeAVC::AllocSliceControlBuffer(
     {
         if(availSize < buf->uiNumElements)
         {
-            newSize   = sizeof(VASliceParameterBufferH264) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 = (VASliceParameterBufferH264 *)realloc(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264, newSize);
-            if(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferH264) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264, sizeof(VASliceParameterBufferH264),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
          }
          buf->pData      = (uint8_t*)bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264;
          buf->uiOffset   = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferH264);
@@ -498,23 +498,12 @@ VAStatus DdiMediaDecode::AllocBsBuffer(
     /* the pSliceData needs to be reallocated in order to contain more SliceDataBuf */
     if (index >= bufMgr->m_maxNumSliceData)
     {
-        /* In theroy it can resize the m_maxNumSliceData one by one. But in order to
-         * avoid calling realloc frequently, it will try to allocate 10 to  hold more
-         * SliceDataBuf. This is only for the optimized purpose.
-         */
-        int32_t reallocSize = bufMgr->m_maxNumSliceData + 10;
-
-        bufMgr->pSliceData = (DDI_CODEC_BITSTREAM_BUFFER_INFO *)realloc(bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]) * reallocSize);
-
-        if (bufMgr->pSliceData == nullptr)
+        if (GrowParamArray((void **)&bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]),
+                bufMgr->m_maxNumSliceData, index + 1) != VA_STATUS_SUCCESS)
         {
             DDI_ASSERTMESSAGE("fail to reallocate pSliceData\n.");
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
-        memset(bufMgr->pSliceData + bufMgr->m_maxNumSliceData, 0,
-               sizeof(bufMgr->pSliceData[0]) * 10);
-
-        bufMgr->m_maxNumSliceData += 10;
     }
 
     if(index >= 1)
@@ -888,6 +877,49 @@ VAStatus DdiMediaDecode::InitDummyReference(DecodePipelineAdapter& decoder)
     return VA_STATUS_SUCCESS;
 }
 
+VAStatus DdiMediaDecode::GrowParamArray(
+    void    **array,
+    uint32_t  elementSize,
+    uint32_t &capacity,
+    uint32_t  required)
+{
+    DDI_FUNCTION_ENTER();
+
+    DDI_CHK_NULL(array, "nullptr array", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    if (required <= capacity)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    uint64_t newCapacity = MOS_MAX((uint64_t)capacity * 2, (uint64_t)required);
+    newCapacity          = MOS_MAX(newCapacity, (uint64_t)16);
+    if (newCapacity * elementSize > UINT32_MAX)
+    {
+        newCapacity = required;
+    }
+    if (newCapacity * elementSize > UINT32_MAX)
+    {
+        DDI_ASSERTMESSAGE("Param array size overflow.");
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
+    // Keep the old array on failure so that it is still released on context destroy
+    void *newArray = realloc(*array, (size_t)(newCapacity * elementSize));
+    if (newArray == nullptr)
+    {
+        DDI_ASSERTMESSAGE("Fail to grow param array.");
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
+    memset((uint8_t *)newArray + (size_t)capacity * elementSize, 0, (size_t)(newCapacity - capacity) * elementSize);
+
+    *array   = newArray;
+    capacity = (uint32_t)newCapacity;
+
+    return VA_STATUS_SUCCESS;
+}
+
 VAStatus DdiMediaDecode::EndPicture(
     VADriverContextP ctx,
     VAContextID      context)
@@ -437,6 +437,29 @@ protected:
     //!           VA_STATUS_SUCCESS if success, else fail reason
     VAStatus InitDummyReference(DecodePipelineAdapter& decoder);
 
+    //! \brief    Grow a slice parameter array
+    //! \details  The capacity at least doubles on each growth and is kept across frames,
+    //!           so streams with many slices per picture settle after a few reallocs.
+    //!           The existing entries are kept and the new tail is zeroed. On failure
+    //!           the array and capacity are left untouched.
+    //!
+    //! \param    [in/out] array
+    //!           Pointer to the array allocated by MOS_AllocAndZeroMemory or realloc
+    //! \param    [in] elementSize
+    //!           Size of one entry in bytes
+    //! \param    [in/out] capacity
+    //!           Number of entries the array holds
+    //! \param    [in] required
+    //!           Number of entries needed
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    static VAStatus GrowParamArray(
+        void    **array,
+        uint32_t  elementSize,
+        uint32_t &capacity,
+        uint32_t  required);
+
     //! \brief  the type of decode base class
     MOS_SURFACE                 m_destSurface;          //!<Destination Surface structure
     uint32_t                    m_groupIndex;           //!<global Group
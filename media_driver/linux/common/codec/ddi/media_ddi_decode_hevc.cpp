@@ -656,25 +656,8 @@ VAStatus DdiDecodeHEVC::AllocSliceParamContext(
 {
     uint32_t baseSize = sizeof(CODEC_HEVC_SLICE_PARAMS);
 
-    if (m_sliceParamBufNum < (m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices = numSlices + 10;
-
-        m_ddiDecodeCtx->DecodeParams.m_sliceParams = realloc(m_ddiDecodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_ddiDecodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_ddiDecodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum), 0, baseSize * extraSlices);
-        m_sliceParamBufNum += extraSlices;
-    }
-
-    return VA_STATUS_SUCCESS;
+    return GrowParamArray(&m_ddiDecodeCtx->DecodeParams.m_sliceParams, baseSize,
+        m_sliceParamBufNum, m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices);
 }
 
 void DdiDecodeHEVC::DestroyContext(
@@ -840,7 +823,6 @@ VAStatus DdiDecodeHEVC::AllocSliceControlBuffer(
 {
     DDI_CODEC_COM_BUFFER_MGR   *bufMgr;
     uint32_t                    availSize;
-    uint32_t                    newSize;
 
     bufMgr     = &(m_ddiDecodeCtx->BufMgr);
     availSize = m_sliceCtrlBufNum - bufMgr->dwNumSliceControl;
@@ -849,14 +831,8 @@ VAStatus DdiDecodeHEVC::AllocSliceControlBuffer(
     {
         if(availSize < buf->uiNumElements)
         {
-            newSize   = sizeof(VASliceParameterBufferBase) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC = (VASliceParameterBufferBase *)realloc(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC, newSize);
-            if(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferBase) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC, sizeof(VASliceParameterBufferBase),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
         }
         buf->pData      = (uint8_t*)bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC;
         buf->uiOffset   = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferBase);
@@ -865,14 +841,8 @@ VAStatus DdiDecodeHEVC::AllocSliceControlBuffer(
     {
         if(availSize < buf->uiNumElements)
         {
-            newSize   = sizeof(VASliceParameterBufferHEVC) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC = (VASliceParameterBufferHEVC *)realloc(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC, newSize);
-            if(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferHEVC) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC, sizeof(VASliceParameterBufferHEVC),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
         }
         buf->pData      = (uint8_t*)bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC;
         buf->uiOffset   = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferHEVC);
@@ -657,25 +657,8 @@ VAStatus DdiDecodeJPEG::AllocSliceParamContext(
 {
     uint32_t baseSize = sizeof(CodecDecodeJpegScanParameter);
 
-    if (m_sliceParamBufNum < (m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices = numSlices + 10;
-
-        m_ddiDecodeCtx->DecodeParams.m_sliceParams = realloc(m_ddiDecodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_ddiDecodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_ddiDecodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum), 0, baseSize * extraSlices);
-        m_sliceParamBufNum += extraSlices;
-    }
-
-    return VA_STATUS_SUCCESS;
+    return GrowParamArray(&m_ddiDecodeCtx->DecodeParams.m_sliceParams, baseSize,
+        m_sliceParamBufNum, m_ddiDecodeCtx->DecodeParams.m_numSlices + numSlices);
 }
 
 void DdiDecodeJPEG::DestroyContext(
@@ -705,23 +688,12 @@ VAStatus DdiDecodeJPEG::AllocBsBuffer(
     /* the pSliceData needs to be reallocated in order to contain more SliceDataBuf */
     if (index >= bufMgr->m_maxNumSliceData)
     {
-        /* In theroy it can resize the m_maxNumSliceData one by one. But in order to
-         * avoid calling realloc frequently, it will try to allocate 10 to  hold more
-         * SliceDataBuf. This is only for the optimized purpose.
-         */
-        int32_t reallocSize = bufMgr->m_maxNumSliceData + 10;
-
-        bufMgr->pSliceData = (DDI_CODEC_BITSTREAM_BUFFER_INFO *)realloc(bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]) * reallocSize);
-
-        if (bufMgr->pSliceData == nullptr)
+        if (GrowParamArray((void **)&bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]),
+                bufMgr->m_maxNumSliceData, index + 1) != VA_STATUS_SUCCESS)
         {
             DDI_ASSERTMESSAGE("fail to reallocate pSliceData for JPEG\n.");
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
-        memset((void *)(bufMgr->pSliceData + bufMgr->m_maxNumSliceData), 0,
-               sizeof(bufMgr->pSliceData[0]) * 10);
-
-        bufMgr->m_maxNumSliceData += 10;
     }
 
     bsAddr = (uint8_t*)MOS_AllocAndZeroMemory(buf->iSize);
@@ -746,21 +718,14 @@ VAStatus DdiDecodeJPEG::AllocSliceControlBuffer(
 {
     DDI_CODEC_COM_BUFFER_MGR   *bufMgr;
     uint32_t                    availSize;
-    uint32_t                    newSize;
 
     bufMgr     = &(m_ddiDecodeCtx->BufMgr);
     availSize = m_sliceCtrlBufNum - bufMgr->dwNumSliceControl;
 
     if(availSize < buf->uiNumElements)
     {
-        newSize   = sizeof(VASliceParameterBufferJPEGBaseline) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-        bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG = (VASliceParameterBufferJPEGBaseline *)realloc(bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG, newSize);
-        if(bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-        MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferJPEGBaseline) * (buf->uiNumElements - availSize));
-        m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+        DDI_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG, sizeof(VASliceParameterBufferJPEGBaseline),
+            m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
     }
     buf->pData      = (uint8_t*)bufMgr->Codec_Param.Codec_Param_JPEG.pVASliceParaBufJPEG;
     buf->uiOffset   = sizeof(VASliceParameterBufferJPEGBaseline) * bufMgr->dwNumSliceControl;
@@ -31,6 +31,8 @@
 #include "mos_cmdbufmgr.h"
 #include "media_libva_caps.h"
 
+class MediaLibvaBufferPoolNext;
+
 //!
 //! \struct DDI_MEDIA_CONTEXT
 //! \brief  Media heap for shared internal structures
@@ -186,6 +188,7 @@ struct DDI_MEDIA_CONTEXT
     MediaInterfacesHwInfo *m_hwInfo                 = nullptr;
     MediaLibvaCapsNext    *m_capsNext               = nullptr;
     bool                  m_apoDdiEnabled           = false;
+    MediaLibvaBufferPoolNext *m_bufferPool          = nullptr;  // Recycled linear VA buffers
 #endif
     MediaUserSettingSharedPtr m_userSettingPtr      = nullptr;  // used to save user setting instance
 };
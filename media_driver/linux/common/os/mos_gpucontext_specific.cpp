@@ -963,15 +963,7 @@ MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
         uint64_t boOffset = alloc_bo->offset64;
         if (alloc_bo != tempCmdBo)
         {
-            auto item_ctx = osContext->contextOffsetList.begin();
-            for (; item_ctx != osContext->contextOffsetList.end(); item_ctx++)
-            {
-                if (item_ctx->intel_context == osContext->intel_context && item_ctx->target_bo == alloc_bo)
-                {
-                    boOffset = item_ctx->offset64;
-                    break;
-                }
-            }
+            osContext->contextOffsetCache.Find(osContext->intel_context, alloc_bo, boOffset);
         }
 
         MOS_OS_CHK_NULL_RETURN(tempCmdBo->virt);
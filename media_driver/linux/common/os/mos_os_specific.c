@@ -1169,11 +1169,7 @@ void Linux_Destroy(
         Linux_ReleaseGPUStatus(pOsContext);
     }
 
-    if (pOsContext->contextOffsetList.size())
-    {
-         pOsContext->contextOffsetList.clear();
-         pOsContext->contextOffsetList.shrink_to_fit();
-    }
+    pOsContext->contextOffsetCache.Clear();
 
     if (!MODSEnabled && (pOsContext->intel_context))
     {
@@ -1873,11 +1869,7 @@ MOS_STATUS Mos_DestroyInterface(PMOS_INTERFACE pOsInterface)
         perStreamParameters->m_waTable.reset();
         Mos_Specific_ClearGpuContext(perStreamParameters);
 
-        if (perStreamParameters->contextOffsetList.size())
-        {
-            perStreamParameters->contextOffsetList.clear();
-            perStreamParameters->contextOffsetList.shrink_to_fit();
-        }
+        perStreamParameters->contextOffsetCache.Clear();
 
         if(Mos_Solo_IsEnabled(perStreamParameters))
         {
@@ -2807,22 +2799,9 @@ void Mos_Specific_FreeResource(
 
         mos_bo_unreference((MOS_LINUX_BO *)(pOsResource->bo));
 
-        if ( pOsInterface->pOsContext != nullptr && pOsInterface->pOsContext->contextOffsetList.size()) 
+        if (pOsInterface->pOsContext != nullptr)
         {
-          MOS_CONTEXT *pOsCtx = pOsInterface->pOsContext;
-          auto item_ctx = pOsCtx->contextOffsetList.begin();
-
-          for (;item_ctx != pOsCtx->contextOffsetList.end();)
-          {
-             if (item_ctx->target_bo == pOsResource->bo)
-             {
-                item_ctx = pOsCtx->contextOffsetList.erase(item_ctx);
-             }
-             else
-             {
-                item_ctx++;
-             }
-          }
+            pOsInterface->pOsContext->contextOffsetCache.Remove(pOsResource->bo);
         }
 
         pOsResource->bo = nullptr;
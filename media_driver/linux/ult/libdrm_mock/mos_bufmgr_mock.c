@@ -2103,11 +2103,65 @@ mos_gem_bo_wait_rendering(struct mos_linux_bo *bo)
  * Note that some kernels have broken the inifite wait for negative values
  * promise, upgrade to latest stable kernels if this is the case.
  */
+static pthread_mutex_t mock_busy_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct mos_linux_bo *mock_busy_bo = nullptr;
+static int64_t mock_busy_until_ns = 0;
+
+static int64_t mock_get_time_ns()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+/**
+ * Emulate GPU work on \p bo completing \p busy_ns from now, so mos_gem_bo_wait
+ * blocks and times out on it like a timed GEM wait. Used by ULTs of the
+ * callers waiting for completion, one bo can be busy at a time.
+ */
+#if defined(__cplusplus)
+extern "C"
+#endif
+drm_export void
+mos_mock_bo_set_busy(struct mos_linux_bo *bo, int64_t busy_ns)
+{
+    pthread_mutex_lock(&mock_busy_lock);
+    mock_busy_bo = bo;
+    mock_busy_until_ns = mock_get_time_ns() + busy_ns;
+    pthread_mutex_unlock(&mock_busy_lock);
+}
+
+static int
+mos_mock_bo_wait(struct mos_linux_bo *bo, int64_t timeout_ns)
+{
+    int64_t remaining_ns;
+    struct timespec sleep_time;
+
+    pthread_mutex_lock(&mock_busy_lock);
+    remaining_ns = (bo == mock_busy_bo) ? mock_busy_until_ns - mock_get_time_ns() : 0;
+    pthread_mutex_unlock(&mock_busy_lock);
+
+    if (remaining_ns <= 0)
+        return 0;
+
+    if (timeout_ns >= 0 && timeout_ns < remaining_ns) {
+        sleep_time.tv_sec = timeout_ns / 1000000000;
+        sleep_time.tv_nsec = timeout_ns % 1000000000;
+        nanosleep(&sleep_time, nullptr);
+        return -ETIME;
+    }
+
+    sleep_time.tv_sec = remaining_ns / 1000000000;
+    sleep_time.tv_nsec = remaining_ns % 1000000000;
+    nanosleep(&sleep_time, nullptr);
+    return 0;
+}
+
 drm_export int
 mos_gem_bo_wait(struct mos_linux_bo *bo, int64_t timeout_ns)
 {
     if(GetDrmMode())
-        return 0; //libdrm_mock
+        return mos_mock_bo_wait(bo, timeout_ns); //libdrm_mock
 
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
@@ -2674,19 +2728,7 @@ mos_update_buffer_offsets2 (struct mos_bufmgr_gem *bufmgr_gem, mos_linux_context
 
 #if 0//ndef ANDROID
         if (cmd_bo != bo) {
-            auto item_ctx = ctx->pOsContext->contextOffsetList.begin();
-            for (; item_ctx != ctx->pOsContext->contextOffsetList.end(); item_ctx++) {
-                if (item_ctx->intel_context == ctx && item_ctx->target_bo == bo) {
-                    item_ctx->offset64 = bo->offset64;
-                    break;
-                }
-            }
-            if ( item_ctx == ctx->pOsContext->contextOffsetList.end()) {
-                struct MOS_CONTEXT_OFFSET newContext = {ctx,
-                                    bo,
-                                    bo->offset64};
-                ctx->pOsContext->contextOffsetList.push_back(newContext);
-            }
+            ctx->pOsContext->contextOffsetCache.Update(ctx, bo, bo->offset64);
         }
 #endif
     }
@@ -3222,6 +3264,22 @@ mos_bufmgr_gem_enable_reuse(struct mos_bufmgr *bufmgr)
     bufmgr_gem->bo_reuse = true;
 }
 
+void
+mos_bufmgr_gem_set_cache_budget(struct mos_bufmgr *bufmgr, uint64_t budget)
+{
+}
+
+int
+mos_bufmgr_gem_get_cache_stats(struct mos_bufmgr *bufmgr,
+                 struct mos_bufmgr_cache_stats *stats)
+{
+    if (bufmgr == nullptr || stats == nullptr)
+        return -EINVAL;
+
+    memclear(*stats);
+    return 0;
+}
+
 /**
  * Enable use of fenced reloc type.
  *
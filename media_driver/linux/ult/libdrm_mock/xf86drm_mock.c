@@ -330,6 +330,23 @@ mosdrmIoctl(int fd, unsigned long request, void *arg)
         }
             break;
 
+        case DRM_IOCTL_I915_GEM_CREATE:
+        {
+            typedef struct drm_i915_gem_create gem_create_t;
+            gem_create_t* create = (gem_create_t *)arg;
+            static uint32_t gem_handle = 0;
+            create->handle = __sync_add_and_fetch(&gem_handle, 1); //Handles must stay unique when bos are created from several threads
+            ret = 0;
+        }
+        break;
+        case DRM_IOCTL_I915_GEM_MADVISE:
+        {
+            typedef struct drm_i915_gem_madvise madvise_t;
+            madvise_t* madv = (madvise_t *)arg;
+            madv->retained = 1; //Nothing is ever purged without a kernel
+            ret = 0;
+        }
+        break;
         case DRM_IOCTL_I915_GEM_USERPTR:
         case DRM_IOCTL_I915_GEM_CONTEXT_DESTROY:
         case DRM_IOCTL_GEM_CLOSE:
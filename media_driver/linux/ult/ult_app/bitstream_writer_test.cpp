@@ -0,0 +1,255 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "bitstream_writer.h"
+
+using namespace std;
+
+// Byte at a time writer, identical to the original BitstreamWriter bit packing
+class RefBitWriter
+{
+public:
+    RefBitWriter(mfxU8 *bs, mfxU8 bitOffset) : m_bsStart(bs), m_bs(bs), m_bitStart(bitOffset), m_bitOffset(bitOffset)
+    {
+        *m_bs &= 0xFF << (8 - m_bitOffset);
+    }
+
+    void PutBits(mfxU32 n, mfxU32 b)
+    {
+        while (n > 24)
+        {
+            n -= 16;
+            PutBits(16, (b >> n));
+        }
+
+        b <<= (32 - n);
+
+        if (!m_bitOffset)
+        {
+            m_bs[0] = (mfxU8)(b >> 24);
+            m_bs[1] = (mfxU8)(b >> 16);
+        }
+        else
+        {
+            b >>= m_bitOffset;
+            n += m_bitOffset;
+
+            m_bs[0] |= (mfxU8)(b >> 24);
+            m_bs[1] = (mfxU8)(b >> 16);
+        }
+
+        if (n > 16)
+        {
+            m_bs[2] = (mfxU8)(b >> 8);
+            m_bs[3] = (mfxU8)b;
+        }
+
+        m_bs += (n >> 3);
+        m_bitOffset = (n & 7);
+    }
+
+    void PutBit(mfxU32 b)
+    {
+        switch (m_bitOffset)
+        {
+        case 0:
+            m_bs[0]     = (mfxU8)(b << 7);
+            m_bitOffset = 1;
+            break;
+        case 7:
+            m_bs[0] |= (mfxU8)(b & 1);
+            m_bs++;
+            m_bitOffset = 0;
+            break;
+        default:
+            if (b & 1)
+                m_bs[0] |= (mfxU8)(1 << (7 - m_bitOffset));
+            m_bitOffset++;
+            break;
+        }
+    }
+
+    void PutGolomb(mfxU32 b)
+    {
+        if (!b)
+        {
+            PutBit(1);
+        }
+        else
+        {
+            mfxU32 n = 1;
+
+            b++;
+
+            while (b >> n)
+                n++;
+
+            PutBits(n - 1, 0);
+            PutBits(n, b);
+        }
+    }
+
+    void PutSE(mfxI32 b) { (b > 0) ? PutGolomb((b << 1) - 1) : PutGolomb((-b) << 1); }
+
+    void PutTrailingBits(bool bCheckAligned)
+    {
+        if ((!bCheckAligned) || m_bitOffset)
+            PutBit(1);
+
+        if (m_bitOffset)
+        {
+            *(++m_bs)   = 0;
+            m_bitOffset = 0;
+        }
+    }
+
+    mfxU32 GetOffset() { return mfxU32(m_bs - m_bsStart) * 8 + m_bitOffset - m_bitStart; }
+
+private:
+    mfxU8 *m_bsStart;
+    mfxU8 *m_bs;
+    mfxU8  m_bitStart;
+    mfxU8  m_bitOffset;
+};
+
+static mfxU32 RandomValue()
+{
+    // Favour small values so short Exp-Golomb codes are covered as well
+    mfxU32 v = ((mfxU32)rand() << 16) ^ (mfxU32)rand();
+    return v >> (rand() % 32);
+}
+
+TEST(BitstreamWriterTest, BitExactWithByteWriter)
+{
+    const size_t size = 4096;
+
+    srand(0);
+    for (int iter = 0; iter < 500; iter++)
+    {
+        vector<mfxU8> ref(size, 0), out(size, 0);
+        mfxU8         bitOffset = (mfxU8)(rand() % 8);
+
+        ref[0] = out[0] = (mfxU8)rand();
+        RefBitWriter    refWriter(ref.data(), bitOffset);
+        BitstreamWriter writer(out.data(), (mfxU32)size, bitOffset);
+
+        for (int op = 0; op < 400; op++)
+        {
+            mfxU32 n = (rand() % 32) + 1;
+            mfxU32 v = RandomValue();
+            switch (rand() % 6)
+            {
+            case 0:
+                refWriter.PutBits(n, v);
+                writer.PutBits(n, v);
+                break;
+            case 1:
+                refWriter.PutBit(v);
+                writer.PutBit(v);
+                break;
+            case 2:
+                // The byte writer does not terminate for code numbers of 2^31 and up
+                v >>= 1;
+                refWriter.PutGolomb(v);
+                writer.PutUE(v);
+                break;
+            case 3:
+            {
+                mfxI32 se = (mfxI32)(v >> 2) * ((rand() & 1) ? 1 : -1);
+                refWriter.PutSE(se);
+                writer.PutSE(se);
+                break;
+            }
+            case 4:
+                refWriter.PutBits(n, 0);
+                writer.PutBits(n, 0);
+                break;
+            default:
+                if (rand() % 16 == 0)
+                {
+                    bool checkAligned = rand() & 1;
+                    refWriter.PutTrailingBits(checkAligned);
+                    writer.PutTrailingBits(checkAligned);
+                }
+                break;
+            }
+            ASSERT_EQ(refWriter.GetOffset(), writer.GetOffset());
+        }
+
+        writer.Flush();
+        size_t bytes = (writer.GetOffset() + bitOffset + 7) / 8;
+        ASSERT_LT(bytes, size);
+        EXPECT_TRUE(equal(ref.begin(), ref.begin() + bytes, out.begin())) << "iteration " << iter;
+    }
+}
+
+TEST(BitstreamWriterTest, ResetKeepsWrittenData)
+{
+    mfxU8 ref[8] = {0x00, 0x00, 0x01, 0x40, 0xff};
+    mfxU8 out[8] = {0xff, 0xff, 0xff, 0xff, 0xff};
+
+    BitstreamWriter writer(out, sizeof(out));
+    writer.PutBits(24, 0x000001);
+    writer.PutBit(0);
+    writer.PutBits(6, 32);
+    writer.Reset(out + 4, 4, 0);
+    EXPECT_EQ(0u, writer.GetOffset());
+    EXPECT_EQ(0, memcmp(ref, out, 5));
+}
+
+TEST(BitstreamWriterTest, PutBitsBufferMatchesPutBit)
+{
+    mfxU8 src[64];
+    for (auto &v : src)
+    {
+        v = (mfxU8)rand();
+    }
+
+    srand(1);
+    for (int iter = 0; iter < 500; iter++)
+    {
+        mfxU8  ref[128] = {}, out[128] = {};
+        mfxU32 pre      = rand() % 40;
+        mfxU32 o        = rand() % 64;
+        mfxU32 n        = rand() % (sizeof(src) * 8 - o + 1);
+
+        BitstreamWriter refWriter(ref, sizeof(ref));
+        BitstreamWriter writer(out, sizeof(out));
+        refWriter.PutBits(pre % 32, pre);
+        writer.PutBits(pre % 32, pre);
+
+        for (mfxU32 i = o; i < o + n; i++)
+        {
+            refWriter.PutBit(src[i >> 3] >> (7 - (i & 7)));
+        }
+        writer.PutBitsBuffer(n, src, o);
+
+        ASSERT_EQ(refWriter.GetOffset(), writer.GetOffset());
+        refWriter.Flush();
+        writer.Flush();
+        EXPECT_EQ(0, memcmp(ref, out, sizeof(ref))) << "offset " << o << " bits " << n;
+    }
+}
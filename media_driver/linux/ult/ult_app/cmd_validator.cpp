@@ -26,6 +26,7 @@ using namespace std;
 void UltGetCmdBuf(PMOS_COMMAND_BUFFER pCmdBuffer)
 {
     auto cmdValidator = CmdValidator::GetInstance();
+    cmdValidator->Capture(pCmdBuffer);
     cmdValidator->Validate(pCmdBuffer);
 }
 
@@ -61,3 +62,11 @@ void CmdValidator::Validate(const PMOS_COMMAND_BUFFER pCmdBuffer) const
         }
     }
 }
+
+void CmdValidator::Capture(const PMOS_COMMAND_BUFFER pCmdBuffer)
+{
+    if (m_captureEnabled)
+    {
+        m_capturedCmds.insert(m_capturedCmds.end(), pCmdBuffer->pCmdBase, pCmdBuffer->pCmdPtr);
+    }
+}
@@ -50,11 +50,28 @@ public:
 
     void Validate(const PMOS_COMMAND_BUFFER pCmdBuffer) const;
 
+    // Keep a copy of every command buffer submitted until StopCapture
+    void StartCapture()
+    {
+        m_capturedCmds.clear();
+        m_captureEnabled = true;
+    }
+
+    const std::vector<uint32_t> &StopCapture()
+    {
+        m_captureEnabled = false;
+        return m_capturedCmds;
+    }
+
+    void Capture(const PMOS_COMMAND_BUFFER pCmdBuffer);
+
 private:
 
     static CmdValidator *m_instance;
 
     std::vector<pcmditf_t> m_gpuCmds;
+    std::vector<uint32_t>  m_capturedCmds;
+    bool                   m_captureEnabled = false;
 };
 
 #endif // __CMD_VALIDATOR_H__
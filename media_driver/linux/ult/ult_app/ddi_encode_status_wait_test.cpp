@@ -0,0 +1,187 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <dlfcn.h>
+#include <chrono>
+#include "gtest/gtest.h"
+#include "ddi_encode_status_wait.h"
+
+using namespace std;
+using namespace std::chrono;
+
+struct mos_linux_bo;
+
+// Provided by libdrm_mock, which devult runs with in LD_PRELOAD
+typedef int (*MosGemBoWait)(mos_linux_bo *bo, int64_t timeout_ns);
+typedef void (*MosMockBoSetBusy)(mos_linux_bo *bo, int64_t busy_ns);
+
+// Next pending report completes frameTime after construction
+class DelayedStatusReport
+{
+public:
+    DelayedStatusReport(uint32_t pending, microseconds frameTime)
+        : m_submitted(pending), m_start(steady_clock::now()), m_frameTime(frameTime) {}
+
+    bool IsNextReportCompleted() const
+    {
+        m_checks++;
+        return steady_clock::now() - m_start >= m_frameTime;
+    }
+
+    uint32_t GetSubmittedCount() const { return m_submitted; }
+    uint32_t GetReportedCount() const { return 0; }
+    uint32_t GetChecks() const { return m_checks; }
+
+private:
+    uint32_t                 m_submitted;
+    steady_clock::time_point m_start;
+    microseconds             m_frameTime;
+    mutable uint32_t         m_checks = 0;
+};
+
+class DdiEncodeStatusWaitTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_boWait  = (MosGemBoWait)dlsym(RTLD_DEFAULT, "mos_gem_bo_wait");
+        m_setBusy = (MosMockBoSetBusy)dlsym(RTLD_DEFAULT, "mos_mock_bo_set_busy");
+        ASSERT_NE(nullptr, m_boWait);
+        ASSERT_NE(nullptr, m_setBusy);
+    }
+
+    void TearDown() override
+    {
+        if (m_setBusy)
+        {
+            m_setBusy(nullptr, 0);
+        }
+    }
+
+    // The mock keeps one bo busy at a time
+    mos_linux_bo *CounterBo() { return (mos_linux_bo *)&m_counterBo; }
+    mos_linux_bo *FrameBo() { return (mos_linux_bo *)&m_frameBo; }
+
+    VAStatus Wait(const DelayedStatusReport &report, uint32_t timeoutUs)
+    {
+        return encode::WaitStatusReportCompletion(
+            report,
+            [this](int64_t timeoutNs) { m_counterWaits++; return m_boWait(CounterBo(), timeoutNs); },
+            [this](int64_t timeoutNs) { m_frameWaits++; return m_boWait(FrameBo(), timeoutNs); },
+            timeoutUs,
+            m_sliceUs,
+            m_pollUs);
+    }
+
+    MosGemBoWait     m_boWait       = nullptr;
+    MosMockBoSetBusy m_setBusy      = nullptr;
+    int              m_counterBo    = 0;
+    int              m_frameBo      = 0;
+    uint32_t         m_counterWaits = 0;
+    uint32_t         m_frameWaits   = 0;
+
+    static const uint32_t m_sliceUs = 1000;
+    static const uint32_t m_pollUs  = 10;
+};
+
+TEST_F(DdiEncodeStatusWaitTest, SingleFrameBlocksOnBuffer)
+{
+    // Buffer goes idle when the only pending frame completes
+    const microseconds frameTime(5000);
+    DelayedStatusReport report(1, frameTime);
+    m_setBusy(CounterBo(), duration_cast<nanoseconds>(frameTime).count());
+
+    auto     start   = steady_clock::now();
+    VAStatus status  = Wait(report, 1000000);
+    auto     elapsed = steady_clock::now() - start;
+
+    EXPECT_EQ(status, VA_STATUS_SUCCESS);
+    EXPECT_GE(elapsed, frameTime);
+    EXPECT_GT(m_counterWaits, 1u);
+    EXPECT_EQ(m_frameWaits, 0u);
+}
+
+TEST_F(DdiEncodeStatusWaitTest, QueuedFramesBlockOnFrameBuffer)
+{
+    // The counter buffer stays busy until the last queued frame completes, the
+    // buffer of the queried frame goes idle with the next report
+    const microseconds frameTime(20000);
+    DelayedStatusReport report(3, frameTime);
+    m_setBusy(FrameBo(), duration_cast<nanoseconds>(frameTime).count());
+
+    auto     start   = steady_clock::now();
+    VAStatus status  = Wait(report, 1000000);
+    auto     elapsed = steady_clock::now() - start;
+
+    EXPECT_EQ(status, VA_STATUS_SUCCESS);
+    EXPECT_GE(elapsed, frameTime);
+    EXPECT_EQ(m_counterWaits, 0u);
+    EXPECT_GT(m_frameWaits, 1u);
+    // One check per blocking slice, polling every 10us would check about 2000 times
+    EXPECT_LE(report.GetChecks(), m_frameWaits + 2);
+}
+
+TEST_F(DdiEncodeStatusWaitTest, QueuedFramesPollOnceFrameBufferIdle)
+{
+    // Frame buffer is already idle but the report lands 2ms later
+    const microseconds frameTime(2000);
+    DelayedStatusReport report(3, frameTime);
+
+    auto     start   = steady_clock::now();
+    VAStatus status  = Wait(report, 1000000);
+    auto     elapsed = steady_clock::now() - start;
+
+    EXPECT_EQ(status, VA_STATUS_SUCCESS);
+    EXPECT_GE(elapsed, frameTime);
+    EXPECT_EQ(m_counterWaits, 0u);
+    EXPECT_EQ(m_frameWaits, 1u);
+}
+
+TEST_F(DdiEncodeStatusWaitTest, TimesOutWhileBufferBusy)
+{
+    m_setBusy(CounterBo(), 200000000);
+    DelayedStatusReport report(1, seconds(1));
+
+    VAStatus status = Wait(report, 3500);
+
+    EXPECT_EQ(status, VA_STATUS_ERROR_TIMEDOUT);
+    EXPECT_EQ(m_counterWaits, 4u);
+}
+
+TEST_F(DdiEncodeStatusWaitTest, TimesOutWhileFrameBufferBusy)
+{
+    m_setBusy(FrameBo(), 200000000);
+    DelayedStatusReport report(2, seconds(1));
+
+    VAStatus status = Wait(report, 3500);
+
+    EXPECT_EQ(status, VA_STATUS_ERROR_TIMEDOUT);
+    EXPECT_EQ(m_frameWaits, 4u);
+}
+
+TEST_F(DdiEncodeStatusWaitTest, IdleBufferWithPendingReportFallsBackToPolling)
+{
+    DelayedStatusReport report(1, seconds(1));
+
+    VAStatus status = Wait(report, 1000000);
+
+    EXPECT_EQ(status, VA_STATUS_ERROR_UNIMPLEMENTED);
+}
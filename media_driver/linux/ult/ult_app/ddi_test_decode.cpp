@@ -39,6 +39,14 @@ TEST_F(MediaDecodeDdiTest, DecodeAVCLong)
     delete pDecData;
 }
 
+TEST_F(MediaDecodeDdiTest, DecodeAVCMultiSlice)
+{
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeAVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-MultiSlice");
+    ExectueDecodeTest(pDecData);
+    delete pDecData;
+}
+
 void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData)
 {
     vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
@@ -85,6 +93,8 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
 
     for (int i = 0; i < pDecData->m_num_frames; i++)
     {
+        CmdValidator::GetInstance()->StartCapture();
+
         // As BeginPicture would reset some parameters, so it should be called before RenderPicture.
         ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, resources[0]);
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
@@ -119,6 +129,8 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
                 &m_driverLoader.m_ctx, resources[0], &surface_status);
         } while (surface_status != VASurfaceReady);
 
+        pDecData->ValidateCmdBuffers(i, CmdValidator::GetInstance()->StopCapture());
+
         for (int j = 0; j < compBufs[i].size(); j++)
         {
             ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, compBufs[i][j].bufID);
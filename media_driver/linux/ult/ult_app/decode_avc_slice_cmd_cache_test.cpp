@@ -0,0 +1,231 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "decode_avc_slice_cmd_cache.h"
+
+using namespace std;
+using namespace decode;
+
+// The devult platforms decode AVC through the legacy CodecHal, so the softlet slice
+// packet cannot be reached from MediaDecodeDdiTest. This test drives the cache the
+// packet uses with commands packed from the same inputs as the packet SETPARs and
+// checks the command buffer does not change when replay is enabled.
+class AvcSliceCmdCacheTest : public testing::Test
+{
+protected:
+    static const uint32_t m_numSlices     = 48;
+    static const uint32_t m_cmdBufferSize = 256 * 1024;
+    static const uint32_t m_refIdxHeader  = 0x71120008;
+    static const uint32_t m_weightHeader  = 0x71130060;
+
+    struct Picture
+    {
+        uint8_t                        picIdx[CODEC_MAX_NUM_REF_FRAME];
+        uint8_t                        frameId[CODEC_MAX_NUM_REF_FRAME];
+        vector<CODEC_AVC_SLICE_PARAMS> slices;
+    };
+
+    // Ref lists change every 4 slices and weights every 12, the second half of the picture is B slices
+    void BuildPicture(Picture &pic, uint8_t frameIdBase)
+    {
+        for (uint32_t i = 0; i < CODEC_MAX_NUM_REF_FRAME; i++)
+        {
+            pic.picIdx[i]  = (uint8_t)((i * 5) % CODEC_MAX_NUM_REF_FRAME);
+            pic.frameId[i] = (uint8_t)(frameIdBase + 2 * i);
+        }
+        pic.slices.assign(m_numSlices, CODEC_AVC_SLICE_PARAMS());
+        for (uint32_t s = 0; s < m_numSlices; s++)
+        {
+            CODEC_AVC_SLICE_PARAMS &slc = pic.slices[s];
+            memset(&slc, 0, sizeof(slc));
+            slc.slice_type                   = (s < m_numSlices / 2) ? 0 : 1;  // P, B
+            slc.num_ref_idx_l0_active_minus1 = (uint8_t)(2 + (s / 8) % 3);
+            slc.num_ref_idx_l1_active_minus1 = (uint8_t)(1 + (s / 16) % 2);
+            for (uint32_t list = 0; list < 2; list++)
+            {
+                for (uint32_t i = 0; i < 32; i++)
+                {
+                    slc.RefPicList[list][i].FrameIdx = (uint8_t)((i + list) % CODEC_MAX_NUM_REF_FRAME);
+                    slc.RefPicList[list][i].PicFlags = (i & 1) ? PICTURE_BOTTOM_FIELD : PICTURE_TOP_FIELD;
+                }
+                // Only the third entry moves every 4 slices, the active count every 8
+                slc.RefPicList[list][2].FrameIdx = (uint8_t)((2 + list + s / 4) % CODEC_MAX_NUM_REF_FRAME);
+                // Entries past the active part do not reach the command
+                slc.RefPicList[list][31].FrameIdx = (uint8_t)s;
+                for (uint32_t i = 0; i < 32; i++)
+                {
+                    slc.Weights[list][i][0][0] = (int16_t)(64 + i + s / 12);
+                    slc.Weights[list][i][0][1] = (int16_t)(list - (int16_t)i);
+                    slc.Weights[list][i][1][0] = (int16_t)(32 + list);
+                    slc.Weights[list][i][2][1] = (int16_t)(s / 12);
+                }
+            }
+        }
+    }
+
+    // Packs MFX_AVC_REF_IDX_STATE the way the packet SETPAR fills referenceListEntry
+    MOS_STATUS AddRefIdxCmd(MOS_COMMAND_BUFFER &cmdBuffer, const Picture &pic, const CODEC_AVC_SLICE_PARAMS &slc, uint32_t list)
+    {
+        uint32_t cmd[10] = {m_refIdxHeader, list};
+        uint8_t *ref     = (uint8_t *)&cmd[2];
+        uint32_t numRef  = (list == 0) ? slc.num_ref_idx_l0_active_minus1 + 1 : slc.num_ref_idx_l1_active_minus1 + 1;
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            if (i >= numRef)
+            {
+                ref[i] = 0x80;
+                continue;
+            }
+            const CODEC_PICTURE &refPic = slc.RefPicList[list][i];
+            uint8_t              idx    = pic.picIdx[refPic.FrameIdx];
+            ref[i] = (uint8_t)(CodecHal_PictureIsBottomField(refPic) |
+                               ((pic.frameId[idx] & 0xf) << 1) |
+                               (CodecHal_PictureIsField(refPic) << 5));
+        }
+        m_builtCmds++;
+        return Mos_AddCommand(&cmdBuffer, cmd, sizeof(cmd));
+    }
+
+    // Packs MFX_AVC_WEIGHTOFFSET_STATE the way the packet SETPAR fills weightoffset
+    MOS_STATUS AddWeightOffsetCmd(MOS_COMMAND_BUFFER &cmdBuffer, const CODEC_AVC_SLICE_PARAMS &slc, uint32_t list)
+    {
+        uint32_t cmd[2 + 3 * 32] = {m_weightHeader, list};
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                cmd[2 + 3 * i + c] = (slc.Weights[list][i][c][0] & 0xFFFF) | ((slc.Weights[list][i][c][1] & 0xFFFF) << 16);
+            }
+        }
+        m_builtCmds++;
+        return Mos_AddCommand(&cmdBuffer, cmd, sizeof(cmd));
+    }
+
+    // Same order as AddCmd_AVC_SLICE_REF_IDX and AddCmd_AVC_SLICE_WEIGHT_OFFSET
+    vector<uint32_t> Decode(const vector<Picture> &pics, bool replay)
+    {
+        vector<uint32_t>   cmds(m_cmdBufferSize / sizeof(uint32_t));
+        MOS_COMMAND_BUFFER cmdBuffer = {};
+        cmdBuffer.pCmdBase           = cmds.data();
+        cmdBuffer.pCmdPtr            = cmds.data();
+        cmdBuffer.iRemaining         = m_cmdBufferSize;
+
+        AvcSliceCmdCache refIdxCache[2];
+        AvcSliceCmdCache weightOffsetCache[2];
+        for (uint32_t list = 0; list < 2; list++)
+        {
+            refIdxCache[list].Enable(replay);
+            weightOffsetCache[list].Enable(replay);
+        }
+
+        m_builtCmds = 0;
+        for (const Picture &pic : pics)
+        {
+            for (uint32_t list = 0; list < 2; list++)
+            {
+                refIdxCache[list].Reset();
+                weightOffsetCache[list].Reset();
+            }
+            for (const CODEC_AVC_SLICE_PARAMS &slc : pic.slices)
+            {
+                uint32_t numLists = (slc.slice_type == 1) ? 2 : 1;
+                for (uint32_t list = 0; list < numLists; list++)
+                {
+                    EXPECT_EQ(MOS_STATUS_SUCCESS, refIdxCache[list].AddRefIdx(cmdBuffer, slc, list, [&]() {
+                        return AddRefIdxCmd(cmdBuffer, pic, slc, list);
+                    }));
+                }
+                for (uint32_t list = 0; list < numLists; list++)
+                {
+                    EXPECT_EQ(MOS_STATUS_SUCCESS, weightOffsetCache[list].AddWeightOffset(cmdBuffer, slc, list, [&]() {
+                        return AddWeightOffsetCmd(cmdBuffer, slc, list);
+                    }));
+                }
+            }
+        }
+
+        cmds.resize(cmdBuffer.iOffset / sizeof(uint32_t));
+        return cmds;
+    }
+
+    uint32_t m_builtCmds = 0;
+};
+
+TEST_F(AvcSliceCmdCacheTest, ReplayKeepsMultiSliceCmdBufferIdentical)
+{
+    // The second picture repeats the slices of the first one on different reference frames
+    vector<Picture> pics(2);
+    BuildPicture(pics[0], 0);
+    BuildPicture(pics[1], 1);
+
+    vector<uint32_t> direct      = Decode(pics, false);
+    uint32_t         directBuilt = m_builtCmds;
+    vector<uint32_t> replayed    = Decode(pics, true);
+    uint32_t         cachedBuilt = m_builtCmds;
+
+    ASSERT_FALSE(direct.empty());
+    ASSERT_EQ(direct.size(), replayed.size());
+    EXPECT_EQ(0, memcmp(direct.data(), replayed.data(), direct.size() * sizeof(uint32_t)));
+
+    // Every command is built without replay, only the ones with new inputs with it
+    uint32_t refIdxCmds = 0;
+    uint32_t weightCmds = 0;
+    for (uint32_t dw = 0; dw < direct.size(); dw += (direct[dw] == m_refIdxHeader) ? 10 : 98)
+    {
+        ASSERT_TRUE(direct[dw] == m_refIdxHeader || direct[dw] == m_weightHeader);
+        if (direct[dw] == m_refIdxHeader)
+        {
+            refIdxCmds++;
+        }
+        else
+        {
+            weightCmds++;
+        }
+    }
+    EXPECT_EQ(refIdxCmds + weightCmds, directBuilt);
+    EXPECT_EQ(refIdxCmds, weightCmds);
+    EXPECT_GT(cachedBuilt, 0u);
+    EXPECT_LT(cachedBuilt * 4, directBuilt);
+}
+
+TEST_F(AvcSliceCmdCacheTest, ReplayFailsWhenCmdBufferIsFull)
+{
+    vector<Picture> pics(1);
+    BuildPicture(pics[0], 0);
+    const CODEC_AVC_SLICE_PARAMS &slc = pics[0].slices[0];
+
+    uint32_t           cmds[16]  = {};
+    MOS_COMMAND_BUFFER cmdBuffer = {};
+    cmdBuffer.pCmdBase           = cmds;
+    cmdBuffer.pCmdPtr            = cmds;
+    cmdBuffer.iRemaining         = sizeof(cmds);
+
+    AvcSliceCmdCache cache;
+    auto             addCmd = [&]() { return AddRefIdxCmd(cmdBuffer, pics[0], slc, 0); };
+    EXPECT_EQ(MOS_STATUS_SUCCESS, cache.AddRefIdx(cmdBuffer, slc, 0, addCmd));
+    EXPECT_EQ(MOS_STATUS_UNKNOWN, cache.AddRefIdx(cmdBuffer, slc, 0, addCmd));
+    EXPECT_EQ(1u, m_builtCmds);
+    EXPECT_EQ(10 * sizeof(uint32_t), (uint32_t)cmdBuffer.iOffset);
+    EXPECT_EQ(cmds + 10, cmdBuffer.pCmdPtr);
+}
@@ -0,0 +1,239 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <map>
+#include <memory>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_hevc_header_packer.h"
+
+using namespace std;
+
+// Packs the same slice headers with and without the slice header part cache
+class HevcHeaderPackerTest : public testing::Test
+{
+protected:
+    enum SliceType
+    {
+        sliceB = 0,
+        sliceP = 1,
+        sliceI = 2,
+    };
+
+    void SetUp() override
+    {
+        m_cached.reset(new HevcHeaderPacker());
+        m_uncached.reset(new HevcHeaderPacker());
+        m_uncached->m_bSshCacheEnabled = false;
+
+        m_sps.reset(new HevcSPS());
+        m_pps.reset(new HevcPPS());
+        m_slice.reset(new HevcSlice());
+
+        m_sps->log2_min_luma_coding_block_size_minus3   = 0;
+        m_sps->log2_diff_max_min_luma_coding_block_size = 3;
+        m_sps->pic_width_in_luma_samples                = 1920;
+        m_sps->pic_height_in_luma_samples               = 1088;
+        m_sps->log2_max_pic_order_cnt_lsb_minus4        = 4;
+        m_sps->temporal_mvp_enabled_flag                = 1;
+        m_sps->sample_adaptive_offset_enabled_flag      = 1;
+        m_sps->long_term_ref_pics_present_flag          = 1;
+        m_sps->chroma_format_idc                        = 1;
+
+        m_pps->cabac_init_present_flag                = 1;
+        m_pps->slice_chroma_qp_offsets_present_flag   = 1;
+        m_pps->loop_filter_across_slices_enabled_flag = 1;
+
+        m_nalu.nal_unit_type         = TRAIL_R;
+        m_nalu.nuh_temporal_id_plus1 = 1;
+
+        m_slice->type                             = sliceB;
+        m_slice->pic_output_flag                  = 1;
+        m_slice->temporal_mvp_enabled_flag        = 1;
+        m_slice->sao_luma_flag                    = 1;
+        m_slice->num_ref_idx_active_override_flag = 1;
+        m_slice->num_ref_idx_l0_active_minus1     = 1;
+        m_slice->num_ref_idx_l1_active_minus1     = 0;
+        m_slice->collocated_from_l0_flag          = 1;
+        m_slice->collocated_ref_idx               = 1;
+        m_slice->five_minus_max_num_merge_cand    = 0;
+        m_slice->strps.num_negative_pics          = 2;
+        m_slice->strps.num_positive_pics          = 1;
+        for (int i = 0; i < 3; i++)
+        {
+            m_slice->strps.pic[i].delta_poc_s0_minus1      = i;
+            m_slice->strps.pic[i].used_by_curr_pic_s0_flag = 1;
+        }
+        m_slice->num_long_term_pics             = 1;
+        m_slice->lt[0].used_by_curr_pic_lt_flag = 1;
+        m_slice->lt[0].poc_lsb_lt               = 37;
+        m_slice->luma_log2_weight_denom         = 6;
+        m_slice->chroma_log2_weight_denom       = 6;
+        for (int l = 0; l < 2; l++)
+        {
+            for (int r = 0; r < 16; r++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    m_slice->pwt[l][r][c][0] = 64 + r + c;
+                    m_slice->pwt[l][r][c][1] = l - c;
+                }
+            }
+        }
+    }
+
+    // Pack one frame with both packers, slices differ in address and QP
+    void PackFrameAndCompare(uint32_t poc, uint32_t numSlices)
+    {
+        for (uint32_t i = 0; i < numSlices; i++)
+        {
+            m_slice->first_slice_segment_in_pic_flag = (i == 0);
+            m_slice->segment_address                 = i * 60;
+            m_slice->pic_order_cnt_lsb               = poc & ((1u << (m_sps->log2_max_pic_order_cnt_lsb_minus4 + 4)) - 1);
+            m_slice->slice_qp_delta                  = (mfxI8)(i % 5) - 2;
+
+            vector<mfxU8>       cachedBits, uncachedBits;
+            map<mfxU32, mfxU32> cachedInfo, uncachedInfo;
+            mfxU32              cachedLen   = Pack(*m_cached, cachedBits, cachedInfo);
+            mfxU32              uncachedLen = Pack(*m_uncached, uncachedBits, uncachedInfo);
+
+            ASSERT_EQ(cachedLen, uncachedLen) << "poc " << poc << " slice " << i;
+            ASSERT_EQ(cachedBits, uncachedBits) << "poc " << poc << " slice " << i;
+            ASSERT_EQ(cachedInfo, uncachedInfo) << "poc " << poc << " slice " << i;
+        }
+    }
+
+    mfxU32 Pack(HevcHeaderPacker &packer, vector<mfxU8> &bits, map<mfxU32, mfxU32> &info)
+    {
+        bits.assign(1024, 0);
+        BitstreamWriter bs(bits.data(), (mfxU32)bits.size());
+        bs.SetInfo(&info);
+        packer.PackSSH(bs, m_nalu, *m_sps, *m_pps, *m_slice, false);
+        bs.Flush();
+
+        mfxU32 len = bs.GetOffset();
+        bits.resize((len + 7) / 8);
+        return len;
+    }
+
+    unique_ptr<HevcHeaderPacker> m_cached;
+    unique_ptr<HevcHeaderPacker> m_uncached;
+    unique_ptr<HevcSPS>          m_sps;
+    unique_ptr<HevcPPS>          m_pps;
+    unique_ptr<HevcSlice>        m_slice;
+    HevcNALU                     m_nalu = {};
+};
+
+TEST_F(HevcHeaderPackerTest, SlicesAndFramesMatchUncached)
+{
+    for (uint32_t poc = 0; poc < 8; poc++)
+    {
+        PackFrameAndCompare(poc, 4);
+    }
+
+    // Frames of the GOP share a single cached part
+    EXPECT_EQ(m_cached->m_sshCacheNext, 1u);
+}
+
+TEST_F(HevcHeaderPackerTest, SliceTypesAndNalTypesMatchUncached)
+{
+    const SliceType types[] = {sliceI, sliceP, sliceB, sliceP, sliceI, sliceB};
+    uint32_t        poc     = 0;
+
+    for (SliceType type : types)
+    {
+        m_slice->type        = type;
+        m_nalu.nal_unit_type = (type == sliceI) ? IDR_W_RADL : TRAIL_R;
+        PackFrameAndCompare(poc++, 3);
+
+        m_nalu.nal_unit_type = TRAIL_N;
+        PackFrameAndCompare(poc++, 3);
+    }
+}
+
+TEST_F(HevcHeaderPackerTest, SpsChangesMatchUncached)
+{
+    unique_ptr<HevcSPS> first(new HevcSPS(*m_sps));
+    PackFrameAndCompare(0, 2);
+
+    // Long term POC LSBs are coded with the SPS POC length
+    m_sps->log2_max_pic_order_cnt_lsb_minus4 = 8;
+    PackFrameAndCompare(1, 2);
+
+    m_sps->sample_adaptive_offset_enabled_flag = 0;
+    PackFrameAndCompare(2, 2);
+
+    m_sps->temporal_mvp_enabled_flag = 0;
+    PackFrameAndCompare(3, 2);
+
+    m_sps->long_term_ref_pics_present_flag = 0;
+    m_slice->num_long_term_pics            = 0;
+    PackFrameAndCompare(4, 2);
+
+    m_sps->chroma_format_idc    = 0;
+    m_pps->weighted_bipred_flag = 1;
+    PackFrameAndCompare(5, 2);
+
+    // Back to the first SPS
+    *m_sps                      = *first;
+    m_pps->weighted_bipred_flag = 0;
+    m_slice->num_long_term_pics = 1;
+    PackFrameAndCompare(6, 2);
+}
+
+TEST_F(HevcHeaderPackerTest, PpsChangesMatchUncached)
+{
+    m_slice->ref_pic_list_modification_flag_lx[0] = 0;
+    PackFrameAndCompare(0, 2);
+
+    // Same slice params, but the modification flag is now coded
+    m_pps->lists_modification_present_flag = 1;
+    PackFrameAndCompare(1, 2);
+
+    m_slice->ref_pic_list_modification_flag_lx[0] = 1;
+    m_slice->list_entry_lx[0][0]                  = 2;
+    m_slice->list_entry_lx[0][1]                  = 1;
+    PackFrameAndCompare(2, 2);
+
+    m_pps->cabac_init_present_flag = 0;
+    PackFrameAndCompare(3, 2);
+
+    m_pps->weighted_bipred_flag = 1;
+    PackFrameAndCompare(4, 2);
+
+    m_slice->type             = sliceP;
+    m_pps->weighted_pred_flag = 1;
+    PackFrameAndCompare(5, 2);
+
+    m_pps->weighted_pred_flag = 0;
+    PackFrameAndCompare(6, 2);
+}
+
+TEST_F(HevcHeaderPackerTest, AlternatingReferenceStructuresMatchUncached)
+{
+    // More structures than cache entries, so parts are also replaced
+    for (uint32_t poc = 0; poc < 24; poc++)
+    {
+        m_slice->strps.num_negative_pics = 1 + poc % 6;
+        m_slice->collocated_ref_idx      = poc % 2;
+        PackFrameAndCompare(poc, 2);
+    }
+}
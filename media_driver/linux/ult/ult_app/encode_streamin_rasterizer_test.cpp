@@ -0,0 +1,182 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_streamin_rasterizer.h"
+
+using namespace std;
+using namespace encode;
+
+// Per block mapping formerly used by HEVC RoiStrategy::GetLCUsInRoiRegion
+static uint32_t RefHevcZigZag(uint32_t streamInWidth, uint32_t x, uint32_t y)
+{
+    uint32_t offset  = streamInWidth * y;
+    uint32_t yOffset = 0;
+    uint32_t xOffset = 2 * x;
+
+    if (y % 2)
+    {
+        offset  = streamInWidth * (y - 1);
+        yOffset = 2;
+    }
+    if (x % 2)
+    {
+        xOffset = (2 * x) - 1;
+    }
+    return offset + xOffset + yOffset;
+}
+
+// Av1StreamIn::GetCuOffset with a LCU map
+static uint32_t RefAv1CuOffset(const vector<uint32_t> &lcuMap, uint32_t widthInLcu, uint32_t x, uint32_t y)
+{
+    return lcuMap[y / 2 * widthInLcu + x / 2] * 4 + (y % 2) * 2 + (x % 2);
+}
+
+struct Rect
+{
+    uint32_t left, top, right, bottom;
+};
+
+static vector<Rect> MakeRects(uint32_t width, uint32_t height)
+{
+    vector<Rect> rects = {{0, 0, width, height}, {1, 1, 2, 2}, {3, 2, 3, 9}, {width - 1, height - 1, width, height}};
+    srand(width * 31 + height);
+    for (int i = 0; i < 32; i++)
+    {
+        uint32_t left = rand() % width, top = rand() % height;
+        rects.push_back({left, top, left + rand() % (width - left + 1), top + rand() % (height - top + 1)});
+    }
+    return rects;
+}
+
+TEST(StreamInRasterizerTest, HevcZigZagRegionsMatchPerBlockLoop)
+{
+    const uint32_t sizes[][2] = {{4, 4}, {6, 12}, {60, 34 + 8}, {240, 136 + 8}};
+
+    for (auto &size : sizes)
+    {
+        uint32_t           width = size[0], height = size[1];
+        StreamInRasterizer rasterizer;
+        rasterizer.Update(width, height, StreamInRasterizer::scanZigZag32x32In64x64);
+
+        for (auto &rect : MakeRects(width, height))
+        {
+            vector<uint32_t> ref, out;
+            for (auto y = rect.top; y < rect.bottom; y++)
+            {
+                for (auto x = rect.left; x < rect.right; x++)
+                {
+                    ref.push_back(RefHevcZigZag(width, x, y));
+                }
+            }
+            rasterizer.ForEachBlock(rect.left, rect.top, rect.right, rect.bottom, [&out](uint32_t lcu) { out.push_back(lcu); });
+
+            EXPECT_EQ(ref, out) << width << "x" << height << " rect " << rect.left << "," << rect.top << "," << rect.right << "," << rect.bottom;
+            EXPECT_EQ(ref.size(), rasterizer.GetBlockCount(rect.left, rect.top, rect.right, rect.bottom));
+        }
+    }
+}
+
+TEST(StreamInRasterizerTest, AvcRoiFillMatchesPerMbLoop)
+{
+    const uint32_t width = 120, height = 68;  // 1920x1088 in macroblocks
+    StreamInRasterizer rasterizer;
+    rasterizer.Update(width, height, StreamInRasterizer::scanRaster);
+
+    auto            rects = MakeRects(width, height);
+    vector<uint8_t> ref(width * height), out(width * height);
+
+    // Lower priority ROIs first, the last one written wins
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        for (auto y = rects[i].top; y < rects[i].bottom; y++)
+        {
+            for (auto x = rects[i].left; x < rects[i].right; x++)
+            {
+                ref[width * y + x] = (uint8_t)(i + 1);
+            }
+        }
+        rasterizer.ForEachBlock(rects[i].left, rects[i].top, rects[i].right, rects[i].bottom, [&out, i](uint32_t mb) { out[mb] = (uint8_t)(i + 1); });
+    }
+    EXPECT_EQ(ref, out);
+}
+
+TEST(StreamInRasterizerTest, ClipsToFrame)
+{
+    StreamInRasterizer rasterizer;
+    rasterizer.Update(8, 4, StreamInRasterizer::scanRaster);
+
+    uint32_t count = 0;
+    rasterizer.ForEachBlock(6, 2, 100, 100, [&count](uint32_t mb) { EXPECT_LT(mb, 32u); count++; });
+    EXPECT_EQ(4u, count);
+    EXPECT_EQ(4u, rasterizer.GetBlockCount(6, 2, 100, 100));
+    EXPECT_EQ(0u, rasterizer.GetBlockCount(5, 2, 3, 100));
+}
+
+TEST(StreamInRasterizerTest, Av1CustomMapMatchesCuOffset)
+{
+    const uint32_t widthInLcu = 30, heightInLcu = 17;
+
+    // Two tile columns, LCUs numbered tile by tile as Av1StreamIn::GetLCUAddr does
+    vector<uint32_t> lcuMap(widthInLcu * heightInLcu);
+    const uint32_t   tileColBd = 16;
+    for (uint32_t y = 0; y < heightInLcu; y++)
+    {
+        for (uint32_t x = 0; x < widthInLcu; x++)
+        {
+            lcuMap[y * widthInLcu + x] = (x < tileColBd) ? (y * tileColBd + x) : (heightInLcu * tileColBd + y * (widthInLcu - tileColBd) + x - tileColBd);
+        }
+    }
+
+    StreamInRasterizer rasterizer;
+    rasterizer.Update(widthInLcu * 2, heightInLcu * 2, [&](uint32_t x, uint32_t y) { return RefAv1CuOffset(lcuMap, widthInLcu, x, y); });
+
+    vector<bool> covered(widthInLcu * heightInLcu * 4, false);
+    for (uint32_t y = 0; y < heightInLcu * 2; y++)
+    {
+        const uint32_t *row = rasterizer.GetRow(y);
+        for (uint32_t x = 0; x < widthInLcu * 2; x++)
+        {
+            ASSERT_EQ(RefAv1CuOffset(lcuMap, widthInLcu, x, y), row[x]);
+            covered[row[x]] = true;
+        }
+    }
+    for (bool c : covered)
+    {
+        EXPECT_TRUE(c);
+    }
+}
+
+TEST(StreamInRasterizerTest, RebuildsOnlyOnChange)
+{
+    StreamInRasterizer rasterizer;
+    rasterizer.Update(4, 4, StreamInRasterizer::scanZigZag32x32In64x64);
+    const uint32_t *row = rasterizer.GetRow(1);
+    EXPECT_EQ(2u, row[0]);
+
+    rasterizer.Update(4, 4, StreamInRasterizer::scanZigZag32x32In64x64);
+    EXPECT_EQ(row, rasterizer.GetRow(1));
+
+    rasterizer.Update(4, 4, StreamInRasterizer::scanRaster);
+    EXPECT_EQ(4u, rasterizer.GetRow(1)[0]);
+}
@@ -0,0 +1,96 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "gtest/gtest.h"
+#include "mos_backoff_wait.h"
+
+using namespace std;
+
+// Stands in for a GPU frame tracker, the completed tag moves up on a timer
+class FakeFrameTracker
+{
+public:
+    FakeFrameTracker(uint32_t frames, uint32_t intervalUs)
+    {
+        m_thread = thread([this, frames, intervalUs]() {
+            for (uint32_t i = 0; i < frames; i++)
+            {
+                this_thread::sleep_for(chrono::microseconds(intervalUs));
+                m_completed.fetch_add(1, memory_order_release);
+            }
+        });
+    }
+
+    ~FakeFrameTracker() { m_thread.join(); }
+
+    uint32_t GetCompleted() const { return m_completed.load(memory_order_acquire); }
+
+private:
+    atomic<uint32_t> m_completed{0};
+    thread           m_thread;
+};
+
+TEST(MosBackoffWaitTest, ReturnsAtOnceWhenReady)
+{
+    uint32_t checks   = 0;
+    uint32_t waitedUs = UINT32_MAX;
+
+    EXPECT_TRUE(MosBackoffWait::Wait([&]() { checks++; return true; }, 0, MosBackoffWait::m_defaultMaxSleepUs, &waitedUs));
+    EXPECT_EQ(1u, checks);
+    EXPECT_LT(waitedUs, 1000u);
+}
+
+TEST(MosBackoffWaitTest, WakesUpSoonAfterTrackerAdvances)
+{
+    const uint32_t frames     = 3;
+    const uint32_t intervalUs = 2000;
+
+    FakeFrameTracker tracker(frames, intervalUs);
+    uint32_t         waitedUs = 0;
+
+    EXPECT_TRUE(MosBackoffWait::Wait([&]() { return tracker.GetCompleted() >= frames; }, 1000000, 500, &waitedUs));
+    EXPECT_GE(tracker.GetCompleted(), frames);
+    EXPECT_GE(waitedUs, frames * intervalUs);
+    // Sleeps are capped at 500us, leave slack for loaded machines
+    EXPECT_LT(waitedUs, frames * intervalUs + 100000);
+}
+
+TEST(MosBackoffWaitTest, TimesOutWhenTrackerStalls)
+{
+    FakeFrameTracker tracker(1, 50000);
+    uint32_t         waitedUs = 0;
+
+    EXPECT_FALSE(MosBackoffWait::Wait([&]() { return tracker.GetCompleted() >= 2; }, 5000, MosBackoffWait::m_defaultMaxSleepUs, &waitedUs));
+    EXPECT_GE(waitedUs, 5000u);
+}
+
+TEST(MosBackoffWaitTest, SleepsAfterSpinAndYield)
+{
+    uint32_t checks = 0;
+
+    // 20ms with at most 1ms sleeps: spin and yield phases plus a bounded number of sleeps
+    EXPECT_FALSE(MosBackoffWait::Wait([&]() { checks++; return false; }, 20000, 1000));
+    EXPECT_GT(checks, MosBackoffWait::m_spinCount + MosBackoffWait::m_yieldCount);
+    EXPECT_LT(checks, MosBackoffWait::m_spinCount + MosBackoffWait::m_yieldCount + 200);
+}
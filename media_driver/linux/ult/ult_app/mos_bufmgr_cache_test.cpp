@@ -0,0 +1,168 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_bufmgr.h"
+
+using namespace std;
+
+// The i915 bufmgr is compiled into devult and runs on the libdrm mock ioctls
+class MosBufmgrCacheTest : public testing::Test
+{
+protected:
+    static const int      m_drmFd      = 1;
+    static const int      m_threads    = 4;
+    static const int      m_iterations = 2000;
+    static const int      m_held       = 8;
+    static const uint64_t m_budget     = 2 * 1024 * 1024;
+
+    void TearDown() override
+    {
+        if (m_bufmgr)
+        {
+            mos_bufmgr_destroy(m_bufmgr);
+            m_bufmgr = nullptr;
+        }
+    }
+
+    void CreateBufmgr()
+    {
+        m_bufmgr = mos_bufmgr_gem_init(m_drmFd, 4096);
+        ASSERT_NE(nullptr, m_bufmgr);
+        mos_bufmgr_gem_enable_reuse(m_bufmgr);
+        mos_bufmgr_gem_set_cache_budget(m_bufmgr, m_budget);
+    }
+
+    // Every thread keeps a few bos alive and releases them out of order,
+    // so frees into the cache and budget evictions overlap across threads
+    void RunAllocFree()
+    {
+        atomic<int> failures(0);
+        vector<thread> workers;
+        for (int t = 0; t < m_threads; t++)
+        {
+            workers.push_back(thread([this, t, &failures] {
+                uint32_t      seed = 0x9e3779b9u * (t + 1);
+                mos_linux_bo *held[m_held] = {};
+                for (int i = 0; i < m_iterations; i++)
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    int           slot = (seed >> 8) % m_held;
+                    unsigned long size = 4096ul << ((seed >> 16) % 7);
+                    if (held[slot])
+                    {
+                        mos_bo_unreference(held[slot]);
+                    }
+                    held[slot] = mos_bo_alloc(m_bufmgr, "cache stress", size, 4096, MOS_MEMPOOL_SYSTEMMEMORY);
+                    if (held[slot] == nullptr || held[slot]->size < size)
+                    {
+                        failures++;
+                    }
+                }
+                for (int slot = 0; slot < m_held; slot++)
+                {
+                    if (held[slot])
+                    {
+                        mos_bo_unreference(held[slot]);
+                    }
+                }
+            }));
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        EXPECT_EQ(0, failures.load());
+    }
+
+    mos_bufmgr *m_bufmgr = nullptr;
+};
+
+TEST_F(MosBufmgrCacheTest, ConcurrentAllocFreeKeepsCacheConsistent)
+{
+    CreateBufmgr();
+    RunAllocFree();
+
+    mos_bufmgr_cache_stats stats = {};
+    ASSERT_EQ(0, mos_bufmgr_gem_get_cache_stats(m_bufmgr, &stats));
+    EXPECT_EQ((uint64_t)m_threads * m_iterations, stats.hits + stats.misses);
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_GT(stats.evictions, 0u);
+    // The last release of each thread may land after the final eviction pass
+    EXPECT_LE(stats.cached_bytes, m_budget + (uint64_t)m_threads * m_held * (4096ul << 6));
+}
+
+TEST_F(MosBufmgrCacheTest, ConcurrentFreesWriteWholeProfilerRecords)
+{
+    char path[] = "/tmp/mos_bufmgr_profiler_XXXXXX";
+    int  fd     = mkstemp(path);
+    ASSERT_NE(-1, fd);
+    close(fd);
+
+    setenv("MEDIA_MEMORY_PROFILER_LOG", path, 1);
+    CreateBufmgr();
+    unsetenv("MEDIA_MEMORY_PROFILER_LOG");
+
+    RunAllocFree();
+    mos_bufmgr_destroy(m_bufmgr);
+    m_bufmgr = nullptr;
+
+    ifstream log(path);
+    string   line;
+    int      creates = 0;
+    int      closes  = 0;
+    while (getline(log, line))
+    {
+        int           pid = 0, handle = 0, region = 0;
+        unsigned long size = 0;
+        char          name[32] = {};
+        if (sscanf(line.c_str(), "GEM_CREATE, %d, %d, %lu, %d, %31[^\n]", &pid, &handle, &size, &region, name) == 5)
+        {
+            EXPECT_STREQ("cache stress", name);
+            creates++;
+        }
+        else if (sscanf(line.c_str(), "GEM_CLOSE, %d, %d, %lu, %d", &pid, &handle, &size, &region) == 4)
+        {
+            closes++;
+        }
+        else
+        {
+            ADD_FAILURE() << "Malformed profiler record: " << line;
+            continue;
+        }
+        EXPECT_EQ(getpid(), pid);
+        EXPECT_EQ(0u, size % 4096);
+    }
+    log.close();
+    unlink(path);
+
+    EXPECT_GT(creates, 0);
+    EXPECT_EQ(creates, closes);
+}
@@ -19,8 +19,13 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <unistd.h>
 #include "mos_utilities.h"
+#include "mos_os.h"
 using namespace std;
 
 void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
@@ -31,3 +36,79 @@ void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
     }
 }
 
+
+// Used by the kernel dll sources compiled into devult
+#if MOS_MESSAGES_ENABLED
+void *MosUtilities::MosAllocAndZeroMemoryUtils(size_t size, const char *functionName, const char *filename, int32_t line)
+{
+    return calloc(1, size);
+}
+
+void MosUtilities::MosFreeMemoryUtils(void *ptr, const char *functionName, const char *filename, int32_t line)
+{
+    free(ptr);
+}
+#else
+void *MosUtilities::MosAllocAndZeroMemory(size_t size)
+{
+    return calloc(1, size);
+}
+
+void MosUtilities::MosFreeMemory(void *ptr)
+{
+    free(ptr);
+}
+#endif
+
+MOS_STATUS MosUtilities::MosSecureMemcpy(void *pDestination, size_t dstLength, const void *pSource, size_t srcLength)
+{
+    if (pDestination == nullptr || pSource == nullptr || srcLength > dstLength)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    memcpy(pDestination, pSource, srcLength);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosSecureFileOpen(FILE **ppFile, const char *filename, const char *mode)
+{
+    if (ppFile == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+    *ppFile = fopen(filename, mode);
+    return (*ppFile != nullptr) ? MOS_STATUS_SUCCESS : MOS_STATUS_FILE_OPEN_FAILED;
+}
+
+int32_t MosUtilities::MosSecureStringPrint(char *buffer, size_t bufSize, size_t length, const char * const format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int32_t ret = vsnprintf(buffer, MOS_MIN(bufSize, length), format, args);
+    va_end(args);
+    return ret;
+}
+
+int32_t MosUtilities::MosGetPid()
+{
+    return getpid();
+}
+
+// Used by the decode slice command cache, same accounting as MosInterface::AddCommand
+MOS_STATUS Mos_AddCommand(PMOS_COMMAND_BUFFER pCmdBuffer, const void *pCmd, uint32_t dwCmdSize)
+{
+    if (pCmdBuffer == nullptr || pCmd == nullptr || dwCmdSize == 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    uint32_t cmdSizeDwAligned = MOS_ALIGN_CEIL(dwCmdSize, sizeof(uint32_t));
+    if (pCmdBuffer->iRemaining < (int32_t)cmdSizeDwAligned)
+    {
+        return MOS_STATUS_UNKNOWN;
+    }
+    pCmdBuffer->iOffset += cmdSizeDwAligned;
+    pCmdBuffer->iRemaining -= cmdSizeDwAligned;
+    memcpy(pCmdBuffer->pCmdPtr, pCmd, dwCmdSize);
+    pCmdBuffer->pCmdPtr += cmdSizeDwAligned / sizeof(uint32_t);
+    return MOS_STATUS_SUCCESS;
+}
@@ -0,0 +1,135 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_swizzle.h"
+
+using namespace std;
+
+// Per byte reference, identical to MosUtilities::MosSwizzleOffset without CSX
+static int32_t RefSwizzleOffset(int32_t offsetX, int32_t offsetY, int32_t pitch, MOS_TILE_TYPE tileFormat)
+{
+    int32_t lBits = (tileFormat == MOS_TILE_Y) ? 5 : 3;
+    int32_t lPos  = (tileFormat == MOS_TILE_Y) ? 4 : 9;
+    int32_t row   = offsetY >> lBits;
+    int32_t line  = offsetY & ((1 << lBits) - 1);
+    int32_t col   = offsetX >> lPos;
+    int32_t x     = offsetX & ((1 << lPos) - 1);
+
+    return (((((row * (pitch >> lPos)) + col) << lBits) + line) << lPos) + x;
+}
+
+static void RefSwizzleData(const uint8_t *src, uint8_t *dst, MOS_TILE_TYPE srcTiling, MOS_TILE_TYPE dstTiling, int32_t height, int32_t pitch)
+{
+    int32_t linearOffset = 0;
+    for (int32_t y = 0; y < height; y++)
+    {
+        for (int32_t x = 0; x < pitch; x++, linearOffset++)
+        {
+            if (dstTiling == MOS_TILE_LINEAR)
+            {
+                dst[linearOffset] = src[RefSwizzleOffset(x, y, pitch, srcTiling)];
+            }
+            else
+            {
+                dst[RefSwizzleOffset(x, y, pitch, dstTiling)] = src[linearOffset];
+            }
+        }
+    }
+}
+
+static void CompareWithReference(MOS_TILE_TYPE tiling, bool toLinear, int32_t height, int32_t pitch, bool streamingStore)
+{
+    // Non tile aligned pitches touch bytes beyond height * pitch, keep margin
+    size_t          size = (size_t)(height + 32) * (pitch + 512);
+    vector<uint8_t> src(size);
+    vector<uint8_t> ref(size, 0xcd);
+    vector<uint8_t> out(size, 0xcd);
+
+    for (auto &v : src)
+    {
+        v = (uint8_t)rand();
+    }
+
+    MOS_TILE_TYPE srcTiling = toLinear ? tiling : MOS_TILE_LINEAR;
+    MOS_TILE_TYPE dstTiling = toLinear ? MOS_TILE_LINEAR : tiling;
+
+    RefSwizzleData(src.data(), ref.data(), srcTiling, dstTiling, height, pitch);
+    EXPECT_EQ(MOS_STATUS_SUCCESS, MosSwizzle::SwizzleData(src.data(), out.data(), srcTiling, dstTiling, height, pitch, streamingStore));
+    EXPECT_TRUE(ref == out) << "tile " << tiling << " toLinear " << toLinear << " height " << height << " pitch " << pitch;
+}
+
+TEST(MosSwizzleTest, BitExactWithPerByteSwizzle)
+{
+    const int32_t       pitches[] = {16, 48, 100, 512, 520, 1024, 3840, 7680};
+    const int32_t       heights[] = {1, 7, 32, 33, 100, 1088, 2160};
+    const MOS_TILE_TYPE tilings[] = {MOS_TILE_X, MOS_TILE_Y};
+
+    srand(0);
+    for (auto tiling : tilings)
+    {
+        for (auto pitch : pitches)
+        {
+            for (auto height : heights)
+            {
+                CompareWithReference(tiling, true, height, pitch, false);
+                CompareWithReference(tiling, false, height, pitch, true);
+            }
+        }
+    }
+}
+
+TEST(MosSwizzleTest, ConcurrentLargeSurfacesBitExact)
+{
+    // Above the parallel threshold, callers finding the workers busy run serially
+    const int32_t height = 1088;
+    const int32_t pitch  = 7680;
+    ASSERT_GE((uint32_t)(height * pitch), MosSwizzle::m_parallelThreshold);
+
+    vector<thread> callers;
+    for (int32_t i = 0; i < 4; i++)
+    {
+        callers.emplace_back([i] {
+            for (int32_t n = 0; n < 3; n++)
+            {
+                CompareWithReference((i & 1) ? MOS_TILE_X : MOS_TILE_Y, (n & 1) == 0, height, pitch, (n & 1) != 0);
+            }
+        });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+}
+
+TEST(MosSwizzleTest, UnsupportedTiling)
+{
+    uint8_t buf[64] = {};
+
+    EXPECT_FALSE(MosSwizzle::IsSupported(MOS_TILE_LINEAR, MOS_TILE_LINEAR));
+    EXPECT_FALSE(MosSwizzle::IsSupported(MOS_TILE_Y, MOS_TILE_X));
+    EXPECT_FALSE(MosSwizzle::IsSupported(MOS_TILE_YS, MOS_TILE_LINEAR));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, MosSwizzle::SwizzleData(buf, buf, MOS_TILE_Y, MOS_TILE_Y, 1, 16, false));
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, MosSwizzle::SwizzleData(nullptr, buf, MOS_TILE_Y, MOS_TILE_LINEAR, 1, 16, false));
+}
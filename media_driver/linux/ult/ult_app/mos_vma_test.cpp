@@ -0,0 +1,225 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_vma.h"
+
+using namespace std;
+
+// Holes ordered high to low, first fit exactly like the original list based heap
+class RefVmaHeap
+{
+public:
+    RefVmaHeap(uint64_t start, uint64_t size) { m_holes.push_back(make_pair(start, size)); }
+
+    uint64_t Alloc(uint64_t size, uint64_t alignment, bool allocHigh)
+    {
+        for (size_t n = 0; n < m_holes.size(); n++)
+        {
+            size_t   i      = allocHigh ? n : m_holes.size() - 1 - n;
+            uint64_t start  = m_holes[i].first;
+            uint64_t length = m_holes[i].second;
+            if (size > length)
+            {
+                continue;
+            }
+
+            uint64_t offset = 0;
+            if (allocHigh)
+            {
+                offset = ((length - size + start) / alignment) * alignment;
+                if (offset < start)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                uint64_t misalign = start % alignment;
+                uint64_t pad      = misalign ? alignment - misalign : 0;
+                if (pad > length - size)
+                {
+                    continue;
+                }
+                offset = start + pad;
+            }
+            Carve(i, offset, size);
+            return offset;
+        }
+        return 0;
+    }
+
+    bool AllocAddr(uint64_t offset, uint64_t size)
+    {
+        for (size_t i = 0; i < m_holes.size(); i++)
+        {
+            if (m_holes[i].first > offset)
+            {
+                continue;
+            }
+            if (m_holes[i].second < offset - m_holes[i].first + size)
+            {
+                return false;
+            }
+            Carve(i, offset, size);
+            return true;
+        }
+        return false;
+    }
+
+    void Free(uint64_t offset, uint64_t size)
+    {
+        size_t i = 0;
+        while (i < m_holes.size() && m_holes[i].first > offset)
+        {
+            i++;
+        }
+        bool highAdjacent = i > 0 && offset + size == m_holes[i - 1].first;
+        bool lowAdjacent  = i < m_holes.size() && m_holes[i].first + m_holes[i].second == offset;
+
+        if (lowAdjacent && highAdjacent)
+        {
+            m_holes[i].second += size + m_holes[i - 1].second;
+            m_holes.erase(m_holes.begin() + i - 1);
+        }
+        else if (lowAdjacent)
+        {
+            m_holes[i].second += size;
+        }
+        else if (highAdjacent)
+        {
+            m_holes[i - 1].first = offset;
+            m_holes[i - 1].second += size;
+        }
+        else
+        {
+            m_holes.insert(m_holes.begin() + i, make_pair(offset, size));
+        }
+    }
+
+    vector<pair<uint64_t, uint64_t>> m_holes;
+
+private:
+    void Carve(size_t i, uint64_t offset, uint64_t size)
+    {
+        uint64_t start = m_holes[i].first;
+        uint64_t waste = (m_holes[i].second - size) - (offset - start);
+
+        if (offset == start && waste == 0)
+        {
+            m_holes.erase(m_holes.begin() + i);
+        }
+        else if (waste == 0)
+        {
+            m_holes[i].second -= size;
+        }
+        else if (offset == start)
+        {
+            m_holes[i].first += size;
+            m_holes[i].second -= size;
+        }
+        else
+        {
+            m_holes[i].second = offset - start;
+            m_holes.insert(m_holes.begin() + i, make_pair(offset + size, waste));
+        }
+    }
+};
+
+static vector<pair<uint64_t, uint64_t>> HeapHoles(mos_vma_heap *heap)
+{
+    vector<pair<uint64_t, uint64_t>> holes;
+    list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
+    {
+        holes.push_back(make_pair(hole->offset, hole->size));
+    }
+    return holes;
+}
+
+TEST(MosVmaTest, RandomAllocFreeMatchesFirstFitList)
+{
+    const uint64_t start        = 1ull << 32;
+    const uint64_t size         = 1ull << 36;
+    const uint64_t alignments[] = {0x1000, 0x10000, 0x100000, 0x200000};
+
+    mos_vma_heap heap;
+    mos_vma_heap_init(&heap, start, size);
+    RefVmaHeap ref(start, size);
+
+    vector<pair<uint64_t, uint64_t>> live;
+    srand(1);
+    for (int iter = 0; iter < 20000; iter++)
+    {
+        int op = rand() % 16;
+        if (op == 0)
+        {
+            heap.alloc_high = !heap.alloc_high;
+        }
+        else if (op < 9 || live.empty())
+        {
+            // Mostly small buffers with an occasional large one to fragment the range
+            uint64_t bytes     = ((uint64_t)(rand() % 64) + 1) << ((rand() % 8 == 0) ? 20 : 12);
+            uint64_t alignment = alignments[rand() % 4];
+            uint64_t addr      = mos_vma_heap_alloc(&heap, bytes, alignment);
+            ASSERT_EQ(ref.Alloc(bytes, alignment, heap.alloc_high), addr) << "iteration " << iter;
+            if (addr)
+            {
+                live.push_back(make_pair(addr, bytes));
+            }
+        }
+        else if (op == 9)
+        {
+            // Re-claim a range just released at the same address
+            size_t   i     = rand() % live.size();
+            uint64_t addr  = live[i].first;
+            uint64_t bytes = live[i].second;
+            mos_vma_heap_free(&heap, addr, bytes);
+            ref.Free(addr, bytes);
+            ASSERT_EQ(ref.AllocAddr(addr, bytes), mos_vma_heap_alloc_addr(&heap, addr, bytes));
+        }
+        else
+        {
+            size_t i = rand() % live.size();
+            mos_vma_heap_free(&heap, live[i].first, live[i].second);
+            ref.Free(live[i].first, live[i].second);
+            live[i] = live.back();
+            live.pop_back();
+        }
+
+        if (iter % 1000 == 0)
+        {
+            ASSERT_TRUE(ref.m_holes == HeapHoles(&heap)) << "iteration " << iter;
+        }
+    }
+
+    for (auto &range : live)
+    {
+        mos_vma_heap_free(&heap, range.first, range.second);
+    }
+    vector<pair<uint64_t, uint64_t>> whole(1, make_pair(start, size));
+    EXPECT_TRUE(whole == HeapHoles(&heap));
+    EXPECT_FALSE(mos_vma_heap_alloc_addr(&heap, start - 0x1000, 0x1000));
+
+    mos_vma_heap_finish(&heap);
+}
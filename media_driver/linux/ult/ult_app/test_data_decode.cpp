@@ -19,6 +19,7 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include "gtest/gtest.h"
 #include "test_data_decode.h"
 
 using namespace std;
@@ -290,3 +291,90 @@ void DecTestDataAVC::UpdateCompBuffers(int frameId)
         break;
     }
 }
+
+DecTestDataAVCMultiSlice::DecTestDataAVCMultiSlice(FeatureID testFeatureID)
+{
+    m_picWidth    = 64;
+    m_picHeight   = 64;
+    m_surfacesNum = 32;
+    m_featureId   = testFeatureID;
+
+    m_confAttrib.resize(1);
+    m_confAttrib[0].type  = VAConfigAttribDecSliceMode;
+    m_confAttrib[0].value = VA_DEC_SLICE_MODE_NORMAL;
+
+    m_resources.resize(m_surfacesNum);
+    InitCompBuffers();
+
+    m_num_frames = m_frameArray.size();
+
+    uint32_t slcSize = m_pBufs->GetSlcSize();
+    uint32_t bsSize  = (uint32_t)m_pBufs->GetBsSize();
+    m_compBufs.resize(m_num_frames);
+    for (uint32_t i = 0; i < m_num_frames; i++) // Set for each frame
+    {
+        auto &frame = m_frameArray[i];
+        m_compBufs[i].resize(1 + 2 * frame.numSlices);
+        m_compBufs[i][0] = { VAPictureParameterBufferType, (uint32_t)frame.picParam.size(), &frame.picParam[0], 0 };
+        // Each slice comes in its own parameter and data buffer, so the driver grows its slice arrays buffer by buffer.
+        for (uint32_t j = 0; j < frame.numSlices; j++)
+        {
+            m_compBufs[i][1 + 2 * j] = { VASliceParameterBufferType, slcSize, &frame.slcParam[j * slcSize], 0 };
+            m_compBufs[i][2 + 2 * j] = { VASliceDataBufferType     , bsSize , &frame.bsData[j * bsSize]   , 0 };
+        }
+    }
+}
+
+void DecTestDataAVCMultiSlice::InitCompBuffers()
+{
+    // More slices than the context allocates for a 64x64 picture, then fewer and more again,
+    // so the second and third frames decode from the slice arrays grown by the first one.
+    const uint32_t numSlices[DEC_FRAME_NUM] = { 40, 10, 40 };
+
+    m_frameArray.resize(DEC_FRAME_NUM);
+    m_pBufs = make_shared<DecBufAVC>();
+
+    auto    *pps        = m_pBufs->GetPpsBuf();
+    uint32_t frameInMbs = (pps->picture_width_in_mbs_minus1 + 1) * (pps->picture_height_in_mbs_minus1 + 1);
+    uint32_t slcSize    = m_pBufs->GetSlcSize();
+
+    for (auto i = 0; i < DEC_FRAME_NUM; i++)
+    {
+        auto &frame     = m_frameArray[i];
+        frame.numSlices = numSlices[i];
+        frame.picParam.assign((char*)m_pBufs->GetPpsBuf(), (char*)m_pBufs->GetPpsBuf() + m_pBufs->GetPpsSize());
+        frame.slcParam.resize(frame.numSlices * slcSize);
+        for (uint32_t j = 0; j < frame.numSlices; j++)
+        {
+            auto *slc = (VASliceParameterBufferH264 *)&frame.slcParam[j * slcSize];
+            memcpy(slc, m_pBufs->GetSlcBuf(), slcSize);
+            slc->first_mb_in_slice = j * (frameInMbs / frame.numSlices);
+            frame.bsData.insert(frame.bsData.end(), m_pBufs->GetBsBuf(), m_pBufs->GetBsBuf() + m_pBufs->GetBsSize());
+        }
+    }
+}
+
+void DecTestDataAVCMultiSlice::ValidateCmdBuffers(int frameId, const vector<uint32_t> &cmds)
+{
+    // MFD_AVC_BSD_OBJECT header on Gen8 and Gen9, one command per decoded slice
+    const uint32_t bsdObjectHeader = 0x71280004;
+    const uint32_t bsdObjectSize   = 6;
+
+    uint32_t bsSize    = (uint32_t)m_pBufs->GetBsSize();
+    uint32_t numSlices = 0;
+    for (size_t i = 0; i + bsdObjectSize <= cmds.size(); i++)
+    {
+        if (cmds[i] != bsdObjectHeader)
+        {
+            continue;
+        }
+        // The slice data buffers are packed back to back in the bitstream buffer, and whatever
+        // header bytes the driver skips, the indirect data of slice n ends where slice n + 1 starts.
+        EXPECT_EQ((numSlices + 1) * bsSize, cmds[i + 1] + cmds[i + 2])
+            << "Frame " << frameId << ", slice " << numSlices << " points at wrong slice data" << endl;
+        numSlices++;
+        i += bsdObjectSize - 1;
+    }
+
+    EXPECT_EQ(m_frameArray[frameId].numSlices, numSlices) << "Frame " << frameId << " decoded wrong slice number" << endl;
+}
@@ -103,6 +103,8 @@ public:
 
     virtual void UpdateCompBuffers(int frameId) { }
 
+    virtual void ValidateCmdBuffers(int frameId, const std::vector<uint32_t> &cmds) { }
+
 public:
 
     int                                    m_num_frames;
@@ -208,6 +210,32 @@ protected:
     void InitCompBuffers() { }
 };
 
+class DecTestDataAVCMultiSlice : public DecTestData
+{
+public:
+
+    DecTestDataAVCMultiSlice(FeatureID testFeatureID);
+
+    void ValidateCmdBuffers(int frameId, const std::vector<uint32_t> &cmds) override;
+
+    struct DecFrameDataAVC
+    {
+        uint32_t             numSlices;
+        std::vector<uint8_t> picParam;
+        std::vector<uint8_t> slcParam;
+        std::vector<uint8_t> bsData;
+    };
+
+protected:
+
+    void InitCompBuffers();
+
+protected:
+
+    std::vector<DecFrameDataAVC> m_frameArray;
+    std::shared_ptr<DecBufAVC>   m_pBufs = nullptr;
+};
+
 class DecTestDataFactory
 {
 public:
@@ -222,6 +250,10 @@ public:
         {
             return new DecTestDataAVCLong(TEST_Intel_Decode_AVC);
         }
+        if (description == "AVC-MultiSlice")
+        {
+            return new DecTestDataAVCMultiSlice(TEST_Intel_Decode_AVC);
+        }
 
         return nullptr;
     }
@@ -0,0 +1,298 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include <random>
+#include <string>
+#include "gtest/gtest.h"
+#include "hal_kerneldll_next.h"
+
+using namespace std;
+
+extern const Kdll_RuleEntry g_KdllRuleTable_Next[];
+
+// Component kernel names are only used for debug messages
+const char *g_cInit_ComponentNames[IDR_VP_TOTAL_NUM_KERNELS] = {};
+
+// Kernels are never linked by these tests
+int cm_fc_combine_kernels(size_t num_kernels, cm_fc_kernel_t *kernels, char *out_buf, size_t *out_size, const char *options)
+{
+    return CM_FC_FAILURE;
+}
+
+// Component kernel binary holding only a link file with a single export, which
+// is the minimum KernelDll_AllocateStates accepts
+static Kdll_State *AllocateKdllState()
+{
+    const uint32_t linkSize = sizeof(Kdll_LinkFileHeader) + sizeof(Kdll_LinkData);
+    const uint32_t binSize  = (IDR_VP_TOTAL_NUM_KERNELS + 1) * sizeof(uint32_t) + linkSize;
+
+    uint8_t *bin = (uint8_t *)MOS_AllocAndZeroMemory(binSize);
+    if (bin == nullptr)
+    {
+        return nullptr;
+    }
+
+    uint32_t *offsets = (uint32_t *)bin;
+    for (uint32_t i = IDR_VP_LinkFile + 1; i <= IDR_VP_TOTAL_NUM_KERNELS; i++)
+    {
+        offsets[i] = linkSize;
+    }
+
+    Kdll_LinkFileHeader *header = (Kdll_LinkFileHeader *)(offsets + IDR_VP_TOTAL_NUM_KERNELS + 1);
+    header->dwVersion           = IDR_VP_LINKFILE_VERSION;
+    header->dwSize              = linkSize;
+    header->dwExports           = 1;
+
+    Kdll_LinkData *link = (Kdll_LinkData *)(header + 1);
+    link->bExport       = 1;
+
+    // Component kernel binary is owned and released by the state
+    Kdll_State *state = KernelDll_AllocateStates(bin, binSize, nullptr, 0, g_KdllRuleTable_Next, nullptr);
+    if (state == nullptr)
+    {
+        MOS_FreeMemory(bin);
+    }
+    return state;
+}
+
+class KdllPersistentCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_path = testing::TempDir() + "kdll_persistent_cache_test.bin";
+        remove(m_path.c_str());
+
+        memset(m_filter, 0, sizeof(m_filter));
+        m_filter[0].layer   = Layer_MainVideo;
+        m_filter[0].format  = Format_NV12;
+        m_filter[0].cspace  = CSpace_BT709;
+        m_filter[1].layer   = Layer_RenderTarget;
+        m_filter[1].format  = Format_A8R8G8B8;
+        m_filter[1].cspace  = CSpace_sRGB;
+
+        m_search.reset(new Kdll_SearchState());
+        memset(m_search.get(), 0, sizeof(Kdll_SearchState));
+        m_search->KernelSize  = 256;
+        m_search->iFilterSize = 2;
+        memcpy(m_search->Filter, m_filter, sizeof(m_filter));
+        for (int i = 0; i < m_search->KernelSize; i++)
+        {
+            m_search->Kernel[i] = (uint8_t)(i * 7 + 3);
+        }
+    }
+
+    void TearDown() override
+    {
+        remove(m_path.c_str());
+    }
+
+    static const uint32_t m_hash = 0x12345678;
+
+    string                       m_path;
+    Kdll_FilterEntry             m_filter[2];
+    unique_ptr<Kdll_SearchState> m_search;
+};
+
+TEST_F(KdllPersistentCacheTest, LookupHitsAfterInMemoryTableReset)
+{
+    Kdll_State *state = AllocateKdllState();
+    ASSERT_NE(state, nullptr);
+    ASSERT_TRUE(KernelDll_OpenPersistentCache(state, m_path.c_str()));
+    EXPECT_EQ(KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash), nullptr);
+
+    ASSERT_NE(KernelDll_AddKernel(state, m_search.get(), m_filter, 2, m_hash), nullptr);
+    EXPECT_NE(KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash), nullptr);
+    ASSERT_TRUE(KernelDll_SavePersistentCache(state));
+    KernelDll_ReleaseStates(state);
+
+    // New state starts with an empty hash table, the kernel must come from the file
+    state = AllocateKdllState();
+    ASSERT_NE(state, nullptr);
+    ASSERT_TRUE(KernelDll_OpenPersistentCache(state, m_path.c_str()));
+
+    Kdll_CacheEntry *entry = KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->iSize, m_search->KernelSize);
+    EXPECT_EQ(memcmp(entry->pBinary, m_search->Kernel, m_search->KernelSize), 0);
+
+    // Now cached in memory as well
+    EXPECT_EQ(KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash), entry);
+
+    // Same hash, different filter must not hit
+    Kdll_FilterEntry other[2];
+    memcpy(other, m_filter, sizeof(other));
+    other[0].format = Format_YUY2;
+    EXPECT_EQ(KernelDll_GetCombinedKernel(state, other, 2, m_hash), nullptr);
+
+    KernelDll_ReleaseStates(state);
+}
+
+// Set the search state field a rule tests, so that the rule holds
+static void ApplyRule(Kdll_SearchState *search, Kdll_RuleID id, uint32_t value)
+{
+    Kdll_FilterEntry *filter = search->pFilter;
+
+    switch (id)
+    {
+    case RID_IsParserState:       search->state               = (Kdll_ParserState)value;  break;
+    case RID_IsRenderMethod:      filter->RenderMethod        = (Kdll_RenderMethod)value; break;
+    case RID_IsTargetCspace:      search->cspace              = (VPHAL_CSPACE)value;      break;
+    case RID_IsLayerID:           filter->layer               = (Kdll_Layer)value;        break;
+    case RID_IsLayerFormat:       filter->format              = (MOS_FORMAT)value;        break;
+    case RID_IsShuffling:         search->ShuffleSamplerData  = (Kdll_Shuffling)value;    break;
+    case RID_IsRTRotate:          search->bRTRotate           = value != 0;               break;
+    case RID_IsLayerRotation:     filter->rotation            = (VPHAL_ROTATION)value;    break;
+    case RID_IsSrc0Format:        search->src0_format         = (MOS_FORMAT)value;        break;
+    case RID_IsSrc0Sampling:      search->src0_sampling       = (Kdll_Sampling)value;     break;
+    case RID_IsSrc0Rotation:      search->src0_rotation       = (VPHAL_ROTATION)value;    break;
+    case RID_IsSrc0ColorFill:     search->src0_colorfill      = value;                    break;
+    case RID_IsSrc0LumaKey:       search->src0_lumakey        = value;                    break;
+    case RID_IsSrc0Procamp:       filter->procamp             = value;                    break;
+    case RID_IsSrc0Coeff:         search->src0_coeff          = (Kdll_CoeffID)value;      break;
+    case RID_IsSetCoeffMode:      filter->SetCSCCoeffMode     = (Kdll_SetCSCCoeffMethod)value; break;
+    case RID_IsSrc0Processing:    search->src0_process        = (Kdll_Processing)value;   break;
+    case RID_IsSrc0Chromasiting:  search->Filter->chromasiting = value;                   break;
+    case RID_IsSrc1Format:        search->src1_format         = (MOS_FORMAT)value;        break;
+    case RID_IsSrc1Sampling:      search->src1_sampling       = (Kdll_Sampling)value;     break;
+    case RID_IsSrc1LumaKey:       search->src1_lumakey        = value;                    break;
+    case RID_IsSrc1SamplerLumaKey: search->src1_samplerlumakey = value;                   break;
+    case RID_IsSrc1Procamp:       filter->procamp             = value;                    break;
+    case RID_IsSrc1Coeff:         search->src1_coeff          = (Kdll_CoeffID)value;      break;
+    case RID_IsSrc1Processing:    search->src1_process        = (Kdll_Processing)value;   break;
+    case RID_IsSrc1Chromasiting:  filter->chromasiting        = value;                    break;
+    case RID_IsLayerNumber:       search->layer_number        = value;                    break;
+    case RID_IsQuadrant:          search->quadrant            = value;                    break;
+    case RID_IsCSCBeforeMix:      search->bCscBeforeMix       = value != 0;               break;
+    case RID_IsDualOutput:        filter->dualout             = value != 0;               break;
+    case RID_IsTargetFormat:      search->target_format       = (MOS_FORMAT)value;        break;
+    case RID_Is64BSaveEnabled:    search->b64BSaveEnabled     = value != 0;               break;
+    case RID_IsTargetTileType:    search->target_tiletype     = (MOS_TILE_TYPE)value;     break;
+    case RID_IsProcampEnabled:    search->bProcamp            = value != 0;               break;
+    case RID_IsConstOutAlpha:     filter->bFillOutputAlphaWithConstant = value != 0;      break;
+    case RID_IsDitherNeeded:      filter->bIsDitherNeeded     = value != 0;               break;
+    default:                                                                              break;
+    }
+}
+
+// The format index must return exactly the rule set the linear search over the
+// whole parser state returns. Every rule set of every state is taken as seed,
+// with the key format rules set to every format, and perturbed by the values of
+// other rule sets of the same state.
+TEST(KdllFindRuleTest, IndexedMatchesLinearSearch)
+{
+    Kdll_State *state = AllocateKdllState();
+    ASSERT_NE(state, nullptr);
+
+    int indexedStates = 0;
+    for (int p = 0; p < Parser_Count; p++)
+    {
+        indexedStates += (state->RuleIndex[p].pStart != nullptr);
+    }
+    EXPECT_GT(indexedStates, 0);
+
+    const Kdll_RuleID  keys[]     = {RID_IsSrc0Format, RID_IsSrc1Format, RID_IsLayerFormat};
+    const VPHAL_CSPACE cspaces[]  = {CSpace_None, CSpace_sRGB, CSpace_stRGB, CSpace_BT601, CSpace_BT709,
+                                     CSpace_xvYCC709, CSpace_BT2020, CSpace_BT2020_RGB, CSpace_Any};
+    const int          cspaceCount = sizeof(cspaces) / sizeof(cspaces[0]);
+    const int          iterations  = 4;
+
+    unique_ptr<Kdll_SearchState> search(new Kdll_SearchState());
+    Kdll_FilterEntry             filter;
+    mt19937                      random(1);
+    uint32_t                     matched  = 0;
+    uint32_t                     mismatch = 0;
+
+    for (int p = 0; p < Parser_Count; p++)
+    {
+        for (int r = 0; r < state->iDllRuleCount[p]; r++)
+        {
+            for (int iter = 0; iter < iterations; iter++)
+            {
+                for (Kdll_RuleID key : keys)
+                {
+                    for (int format = Format_Invalid; format < Format_Count; format++)
+                    {
+                        memset(search.get(), 0, sizeof(Kdll_SearchState));
+                        memset(&filter, 0, sizeof(filter));
+                        search->pFilter = &filter;
+
+                        // Satisfy the seed rule set, then perturb
+                        const Kdll_RuleEntrySet *seed  = &state->pDllRuleTable[p][r];
+                        const Kdll_RuleEntry    *entry = seed->pRuleEntry;
+                        for (int i = 0; i < seed->iMatchCount; i++, entry++)
+                        {
+                            if (entry->logic != Kdll_Or || (random() & 1))
+                            {
+                                ApplyRule(search.get(), entry->id, entry->value);
+                            }
+                        }
+                        if (iter > 0)
+                        {
+                            const Kdll_RuleEntrySet *other = &state->pDllRuleTable[p][random() % state->iDllRuleCount[p]];
+                            entry                          = other->pRuleEntry;
+                            for (int i = 0; i < other->iMatchCount; i++, entry++)
+                            {
+                                if (random() % 3 == 0)
+                                {
+                                    ApplyRule(search.get(), entry->id, entry->value);
+                                }
+                            }
+                            search->cspace = cspaces[random() % cspaceCount];
+                            filter.cspace  = cspaces[random() % cspaceCount];
+                        }
+                        search->state = (Kdll_ParserState)p;
+                        ApplyRule(search.get(), key, format);
+
+                        search->pMatchingRuleSet = nullptr;
+                        bool               indexedFound = KernelDll_FindRule(state, search.get());
+                        Kdll_RuleEntrySet *indexed      = search->pMatchingRuleSet;
+
+                        // Without index the whole state is searched linearly
+                        Kdll_RuleIndex index          = state->RuleIndex[p];
+                        state->RuleIndex[p].pStart    = nullptr;
+                        search->pMatchingRuleSet      = nullptr;
+                        bool               linearFound = KernelDll_FindRule(state, search.get());
+                        Kdll_RuleEntrySet *linear      = search->pMatchingRuleSet;
+                        state->RuleIndex[p]            = index;
+
+                        matched += linearFound;
+                        if (indexedFound != linearFound || indexed != linear)
+                        {
+                            ADD_FAILURE() << "state " << p << " seed " << r << " key " << key << " format " << format;
+                            if (++mismatch >= 10)
+                            {
+                                KernelDll_ReleaseStates(state);
+                                return;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(matched, 0u);
+    KernelDll_ReleaseStates(state);
+}
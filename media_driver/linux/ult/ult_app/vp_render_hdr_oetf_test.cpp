@@ -0,0 +1,55 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_common.h"
+#include "vp_render_hdr_oetf.h"
+
+using namespace std;
+
+TEST(VpRenderHdrOetfTest, St2084LutMatchesGenerated)
+{
+    vector<uint16_t> ref(VPHAL_HDR_OETF_1DLUT_SIZE);
+    HdrGenerate2SegmentsOETFLUT(0.01f, HdrOETF2084, ref.data());
+
+    const uint16_t *lut = HdrGetOETFSmpteSt2084LUT();
+    ASSERT_NE(nullptr, lut);
+    EXPECT_TRUE(equal(ref.begin(), ref.end(), lut));
+
+    // Generated once, later calls return the same table untouched
+    EXPECT_EQ(lut, HdrGetOETFSmpteSt2084LUT());
+    EXPECT_TRUE(equal(ref.begin(), ref.end(), HdrGetOETFSmpteSt2084LUT()));
+}
+
+TEST(VpRenderHdrOetfTest, St2084LutIsMonotonic)
+{
+    const uint16_t *lut = HdrGetOETFSmpteSt2084LUT();
+
+    // Positive FP16 values order like integers
+    for (uint32_t i = 1; i < VPHAL_HDR_OETF_1DLUT_SIZE; i++)
+    {
+        EXPECT_LE(lut[i - 1], lut[i]) << "entry " << i;
+    }
+    EXPECT_EQ(VpHal_FloatToHalfFloat(HdrOETF2084(0.0f)), lut[0]);
+    EXPECT_EQ(VpHal_FloatToHalfFloat(HdrOETF2084(0.01f)), lut[VPHAL_HDR_OETF_1DLUT_SIZE - 1]);
+}
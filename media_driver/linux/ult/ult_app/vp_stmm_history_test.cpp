@@ -0,0 +1,99 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_stmm_history.h"
+
+using namespace std;
+
+// Per element loop formerly used by VpResourceManager::VeboxInitSTMMHistory
+static void RefInitStmmHistory(uint8_t *pByte, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue)
+{
+    uint32_t dwSize = width >> 2;
+
+    for (int32_t y = 0; y < (int32_t)height; y++)
+    {
+        for (int32_t x = 0; x < (int32_t)dwSize; x++)
+        {
+            memset(pByte, initValue, 2);
+            pByte += 4;
+        }
+
+        pByte += pitch - width;
+    }
+}
+
+typedef void (*FillStmmHistory)(uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue);
+
+static void ExpectBitExactWithPerElementLoop(FillStmmHistory fill)
+{
+    const uint32_t widths[]  = {4, 6, 64, 481, 960, 1920, 4096};
+    const uint32_t heights[] = {1, 3, 68, 544};
+    const uint32_t pads[]    = {0, 3, 64, 128};
+
+    srand(0);
+    for (auto width : widths)
+    {
+        for (auto height : heights)
+        {
+            for (auto pad : pads)
+            {
+                uint32_t        pitch = width + pad;
+                vector<uint8_t> ref((size_t)pitch * height);
+                for (auto &v : ref)
+                {
+                    v = (uint8_t)rand();
+                }
+                vector<uint8_t> out(ref);
+
+                RefInitStmmHistory(ref.data(), width, height, pitch, 0xff);
+                fill(out.data(), width, height, pitch, 0xff);
+                EXPECT_TRUE(ref == out) << "width " << width << " height " << height << " pitch " << pitch;
+            }
+        }
+    }
+}
+
+TEST(VpStmmHistoryTest, BitExactWithPerElementLoop)
+{
+    ExpectBitExactWithPerElementLoop(vp::VpFillStmmHistory);
+}
+
+TEST(VpStmmHistoryTest, ScalarBitExactWithPerElementLoop)
+{
+    ExpectBitExactWithPerElementLoop([](uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue) {
+        vp::VpFillStmmHistoryScalar(data, width, height, pitch, initValue);
+    });
+}
+
+#if VP_STMM_HISTORY_AVX512
+TEST(VpStmmHistoryTest, Avx512BitExactWithPerElementLoop)
+{
+    if (!__builtin_cpu_supports("avx512bw"))
+    {
+        GTEST_SKIP();
+    }
+    ExpectBitExactWithPerElementLoop(vp::VpFillStmmHistoryAvx512);
+}
+#endif
@@ -46,6 +46,11 @@ public:
 
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus) override;
 
+    virtual MediaStatusReport *GetStatusReportInstance() override
+    {
+        return m_encoder ? m_encoder->GetStatusReportInstance() : nullptr;
+    }
+
     virtual MOS_STATUS ResolveMetaData(PMOS_RESOURCE pInput, PMOS_RESOURCE pOutput) override;
 
     virtual void Destroy() override;
@@ -43,6 +43,11 @@ public:
 
     virtual MOS_STATUS GetStatusReport(void *status, uint16_t numStatus);
 
+    virtual MediaStatusReport *GetStatusReportInstance() override
+    {
+        return m_encoder ? m_encoder->GetStatusReportInstance() : nullptr;
+    }
+
     virtual void Destroy();
 
 protected:
@@ -33,6 +33,7 @@
 class CodechalDebugInterface;
 class CodechalHwInterfaceNext;
 class CodechalSetting;
+class MediaStatusReport;
 
 //------------------------------------------------------------------------------
 // Simplified macros for debug message, Assert, Null check and MOS eStatus check
@@ -348,6 +349,13 @@ public:
     //!
     CodechalDebugInterface *GetDebugInterface() { return m_debugInterface; }
 
+    //!
+    //! \brief    Gets status report of the codec pipeline.
+    //! \return   MediaStatusReport *
+    //!           return status report, nullptr if the codec does not use MediaStatusReport
+    //!
+    virtual MediaStatusReport *GetStatusReportInstance() { return nullptr; }
+
     //!
     //! \brief    Check if Apogeios enabled.
     //! \return   bool
@@ -806,6 +806,35 @@ namespace decode
         return MOS_STATUS_SUCCESS;
     }
 
+    const uint16_t *Av1BasicFeature::GetDefaultFrameContextImage(uint8_t index)
+    {
+        struct DefaultFrameContextImages
+        {
+            DefaultFrameContextImages()
+            {
+                for (uint8_t i = 0; i < av1DefaultCdfTableNum; i++)
+                {
+                    if (InitDefaultFrameContextBuffer(data[i], i) != MOS_STATUS_SUCCESS)
+                    {
+                        valid = false;
+                    }
+                }
+            }
+
+            uint16_t data[av1DefaultCdfTableNum][m_cdfMaxNumBytes / sizeof(uint16_t)] = {};
+            bool     valid = true;
+        };
+
+        // Built on first use, initialization of function local statics is thread safe
+        static const DefaultFrameContextImages images;
+
+        if (index >= av1DefaultCdfTableNum || !images.valid)
+        {
+            return nullptr;
+        }
+        return images.data[index];
+    }
+
     MOS_STATUS Av1BasicFeature :: UpdateDefaultCdfTable()
     {
         DECODE_FUNC_CALL();
@@ -823,7 +852,9 @@ namespace decode
                 DECODE_CHK_NULL(data);
 
                 // reset all CDF tables to default values
-                DECODE_CHK_STATUS(InitDefaultFrameContextBuffer(data, index));
+                auto image = GetDefaultFrameContextImage(index);
+                DECODE_CHK_NULL(image);
+                DECODE_CHK_STATUS(MOS_SecureMemcpy(data, m_cdfMaxNumBytes, image, m_cdfMaxNumBytes));
                 m_defaultCdfBuffers[index] = m_allocator->AllocateBuffer(
                     MOS_ALIGN_CEIL(m_cdfMaxNumBytes, CODECHAL_PAGE_SIZE), "m_defaultCdfBuffers",
                     resourceInternalRead, notLockableVideoMem);
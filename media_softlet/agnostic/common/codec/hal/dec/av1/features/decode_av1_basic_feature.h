@@ -86,7 +86,7 @@ namespace decode
         //! \return   MOS_STATUS
         //!           MOS_STATUS_SUCCESS if success, else fail reason
         //!
-        MOS_STATUS InitDefaultFrameContextBuffer(
+        static MOS_STATUS InitDefaultFrameContextBuffer(
             uint16_t              *ctxBuffer,
             uint8_t               index);
 
@@ -100,10 +100,21 @@ namespace decode
         //! \return   MOS_STATUS
         //!           MOS_STATUS_SUCCESS if success, else fail reason
         //!
-        MOS_STATUS SyntaxElementCdfTableInit(
+        static MOS_STATUS SyntaxElementCdfTableInit(
             uint16_t                    *ctxBuffer,
             SyntaxElementCdfTableLayout SyntaxElement);
 
+        //!
+        //! \brief    Get the default frame context image for a coeff CDF Q context
+        //! \details  The four default frame contexts are built once per process and
+        //!           shared read-only by all AV1 decoder instances
+        //! \param    [in] index
+        //!           Coeff CDF Q context index
+        //! \return   const uint16_t *
+        //!           Pointer to m_cdfMaxNumBytes of context data, nullptr if failed
+        //!
+        static const uint16_t *GetDefaultFrameContextImage(uint8_t index);
+
         //!
         //! \brief    Update default cdfTable buffers
         //! \details  Update default cdfTable buffers for AV1 decoder
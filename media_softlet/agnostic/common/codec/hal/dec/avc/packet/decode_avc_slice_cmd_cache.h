@@ -0,0 +1,144 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_avc_slice_cmd_cache.h
+//! \brief    Defines the cache of avc slice level commands shared by consecutive slices
+//!
+
+#ifndef __DECODE_AVC_SLICE_CMD_CACHE_H__
+#define __DECODE_AVC_SLICE_CMD_CACHE_H__
+
+#include <string.h>
+#include <vector>
+#include "mos_os.h"
+#include "codec_def_decode_avc.h"
+
+namespace decode
+{
+//!
+//! \class    AvcSliceCmdCache
+//! \brief    Last slice level command built for one ref list and the slice inputs it was built from.
+//!           MFX_AVC_REF_IDX_STATE and MFX_AVC_WEIGHTOFFSET_STATE only depend on picture level state
+//!           and on the ref list or weights of their list, so a slice repeating them gets the bytes
+//!           of the previous slice instead of building the command again.
+//!
+class AvcSliceCmdCache
+{
+public:
+    //!
+    //! \brief  Add MFX_AVC_REF_IDX_STATE for one list of a slice
+    //! \param  [in] cmdBuffer
+    //!         Command buffer
+    //! \param  [in] slc
+    //!         Slice params
+    //! \param  [in] list
+    //!         Ref list index
+    //! \param  [in] addCmd
+    //!         Builds the command into \a cmdBuffer when it cannot be replayed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    template <typename AddCmd>
+    MOS_STATUS AddRefIdx(MOS_COMMAND_BUFFER &cmdBuffer, const CODEC_AVC_SLICE_PARAMS &slc, uint32_t list, AddCmd addCmd)
+    {
+        // The command only depends on the active part of the ref list
+        uint32_t numRef = (list == 0) ? slc.num_ref_idx_l0_active_minus1 + 1 : slc.num_ref_idx_l1_active_minus1 + 1;
+        if (numRef > sizeof(slc.RefPicList[0]) / sizeof(slc.RefPicList[0][0]))
+        {
+            m_valid = false;
+            return addCmd();
+        }
+
+        uint8_t  key[sizeof(uint32_t) + sizeof(slc.RefPicList[0])];
+        uint32_t keySize = sizeof(uint32_t) + numRef * sizeof(slc.RefPicList[list][0]);
+        MOS_SecureMemcpy(key, sizeof(key), &numRef, sizeof(uint32_t));
+        MOS_SecureMemcpy(key + sizeof(uint32_t), sizeof(key) - sizeof(uint32_t), slc.RefPicList[list], keySize - sizeof(uint32_t));
+
+        return Add(cmdBuffer, key, keySize, addCmd);
+    }
+
+    //!
+    //! \brief  Add MFX_AVC_WEIGHTOFFSET_STATE for one list of a slice
+    //! \param  [in] cmdBuffer
+    //!         Command buffer
+    //! \param  [in] slc
+    //!         Slice params
+    //! \param  [in] list
+    //!         Ref list index
+    //! \param  [in] addCmd
+    //!         Builds the command into \a cmdBuffer when it cannot be replayed
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    template <typename AddCmd>
+    MOS_STATUS AddWeightOffset(MOS_COMMAND_BUFFER &cmdBuffer, const CODEC_AVC_SLICE_PARAMS &slc, uint32_t list, AddCmd addCmd)
+    {
+        // The command only depends on the weights of the list
+        return Add(cmdBuffer, slc.Weights[list], sizeof(slc.Weights[list]), addCmd);
+    }
+
+    //!
+    //! \brief  Drop the cached command, picture level state may change
+    //!
+    void Reset() { m_valid = false; }
+
+    //!
+    //! \brief  Enable or disable replay, every command is built while disabled
+    //!
+    void Enable(bool enable)
+    {
+        m_enabled = enable;
+        m_valid   = false;
+    }
+
+protected:
+    template <typename AddCmd>
+    MOS_STATUS Add(MOS_COMMAND_BUFFER &cmdBuffer, const void *key, uint32_t keySize, AddCmd addCmd)
+    {
+        if (m_enabled && m_valid && m_key.size() == keySize && memcmp(m_key.data(), key, keySize) == 0)
+        {
+            return Mos_AddCommand(&cmdBuffer, m_cmd.data(), (uint32_t)m_cmd.size());
+        }
+
+        m_valid                 = false;
+        const uint8_t *cmdStart = (const uint8_t *)cmdBuffer.pCmdPtr;
+        MOS_STATUS     status   = addCmd();
+        const uint8_t *cmdEnd   = (const uint8_t *)cmdBuffer.pCmdPtr;
+        if (status != MOS_STATUS_SUCCESS || !m_enabled || cmdStart == nullptr || cmdEnd <= cmdStart)
+        {
+            return status;
+        }
+
+        m_key.assign((const uint8_t *)key, (const uint8_t *)key + keySize);
+        m_cmd.assign(cmdStart, cmdEnd);
+        m_valid = true;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool                 m_enabled = true;
+    bool                 m_valid   = false;
+    std::vector<uint8_t> m_key;
+    std::vector<uint8_t> m_cmd;
+};
+
+}  // namespace decode
+#endif
@@ -47,6 +47,15 @@ MOS_STATUS AvcDecodeSlcPkt::Init()
 
     DECODE_CHK_STATUS(CalculateSliceStateCommandSize());
 
+#if MHW_HWCMDPARSER_ENABLED
+    // Keep building every command when the command parser needs to see them
+    for (uint32_t list = 0; list < 2; list++)
+    {
+        m_refIdxCache[list].Enable(false);
+        m_weightOffsetCache[list].Enable(false);
+    }
+#endif
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -61,6 +70,13 @@ MOS_STATUS AvcDecodeSlcPkt::Prepare()
     m_avcSliceParams  = m_avcBasicFeature->m_avcSliceParams;
     m_firstValidSlice = true;
 
+    // Commands depend on picture level state as well, never reuse them across pictures
+    for (uint32_t list = 0; list < 2; list++)
+    {
+        m_refIdxCache[list].Reset();
+        m_weightOffsetCache[list].Reset();
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -295,6 +311,18 @@ MHW_SETPAR_DECL_SRC(MFX_AVC_WEIGHTOFFSET_STATE, AvcDecodeSlcPkt)
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS AvcDecodeSlcPkt::AddCmd_AVC_SLICE_WEIGHT_OFFSET_LIST(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t list)
+{
+    DECODE_FUNC_CALL();
+
+    PCODEC_AVC_SLICE_PARAMS slc = m_avcSliceParams + m_curSliceNum;
+    return m_weightOffsetCache[list].AddWeightOffset(cmdBuffer, *slc, list, [&]() {
+        m_listID = list;
+        SETPAR_AND_ADDCMD(MFX_AVC_WEIGHTOFFSET_STATE, m_mfxItf, &cmdBuffer);
+        return MOS_STATUS_SUCCESS;
+    });
+}
+
 MOS_STATUS AvcDecodeSlcPkt::AddCmd_AVC_SLICE_WEIGHT_OFFSET(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx)
 {
     DECODE_FUNC_CALL();
@@ -302,16 +330,13 @@ MOS_STATUS AvcDecodeSlcPkt::AddCmd_AVC_SLICE_WEIGHT_OFFSET(MOS_COMMAND_BUFFER &c
     if (m_avcBasicFeature->IsAvcPSlice(slc->slice_type) &&
         m_avcPicParams->pic_fields.weighted_pred_flag == 1)
     {
-        m_listID = 0;
-        SETPAR_AND_ADDCMD(MFX_AVC_WEIGHTOFFSET_STATE, m_mfxItf, &cmdBuffer);
+        DECODE_CHK_STATUS(AddCmd_AVC_SLICE_WEIGHT_OFFSET_LIST(cmdBuffer, 0));
     }
     if (m_avcBasicFeature->IsAvcBSlice(slc->slice_type) &&
         m_avcPicParams->pic_fields.weighted_bipred_idc == 1)
     {
-        m_listID = 0;
-        SETPAR_AND_ADDCMD(MFX_AVC_WEIGHTOFFSET_STATE, m_mfxItf, &cmdBuffer);
-        m_listID = 1;
-        SETPAR_AND_ADDCMD(MFX_AVC_WEIGHTOFFSET_STATE, m_mfxItf, &cmdBuffer);
+        DECODE_CHK_STATUS(AddCmd_AVC_SLICE_WEIGHT_OFFSET_LIST(cmdBuffer, 0));
+        DECODE_CHK_STATUS(AddCmd_AVC_SLICE_WEIGHT_OFFSET_LIST(cmdBuffer, 1));
     }
     return MOS_STATUS_SUCCESS;
 }
@@ -389,16 +414,26 @@ MHW_SETPAR_DECL_SRC(MFX_AVC_REF_IDX_STATE, AvcDecodeSlcPkt)
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS AvcDecodeSlcPkt::AddCmd_AVC_SLICE_REF_IDX_LIST(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t list)
+{
+    DECODE_FUNC_CALL();
+
+    PCODEC_AVC_SLICE_PARAMS slc = m_avcSliceParams + m_curSliceNum;
+    return m_refIdxCache[list].AddRefIdx(cmdBuffer, *slc, list, [&]() {
+        m_listID = list;
+        SETPAR_AND_ADDCMD(MFX_AVC_REF_IDX_STATE, m_mfxItf, &cmdBuffer);
+        return MOS_STATUS_SUCCESS;
+    });
+}
+
 MOS_STATUS AvcDecodeSlcPkt::AddCmd_AVC_SLICE_REF_IDX(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx)
 {
     DECODE_FUNC_CALL();
     PCODEC_AVC_SLICE_PARAMS slc = m_avcSliceParams + slcIdx;
-    m_listID = 0;
-    SETPAR_AND_ADDCMD(MFX_AVC_REF_IDX_STATE, m_mfxItf, &cmdBuffer);
+    DECODE_CHK_STATUS(AddCmd_AVC_SLICE_REF_IDX_LIST(cmdBuffer, 0));
     if (m_avcBasicFeature->IsAvcBSlice(slc->slice_type))
     {
-        m_listID = 1;
-        SETPAR_AND_ADDCMD(MFX_AVC_REF_IDX_STATE, m_mfxItf, &cmdBuffer);
+        DECODE_CHK_STATUS(AddCmd_AVC_SLICE_REF_IDX_LIST(cmdBuffer, 1));
     }
     return MOS_STATUS_SUCCESS;
 }
@@ -32,6 +32,7 @@
 #include "decode_utils.h"
 #include "decode_avc_basic_feature.h"
 #include "mhw_vdbox_mfx_itf.h"
+#include "decode_avc_slice_cmd_cache.h"
 
 namespace decode
 {
@@ -113,7 +114,9 @@ protected:
     MOS_STATUS SET_AVC_SLICE_STATE(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
     MOS_STATUS AddCmd_AVC_PHANTOM_SLICE(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
     MOS_STATUS AddCmd_AVC_SLICE_WEIGHT_OFFSET(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
+    MOS_STATUS AddCmd_AVC_SLICE_WEIGHT_OFFSET_LIST(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t list);
     MOS_STATUS AddCmd_AVC_SLICE_REF_IDX(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
+    MOS_STATUS AddCmd_AVC_SLICE_REF_IDX_LIST(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t list);
     MOS_STATUS AddCmd_AVC_BSD_OBJECT(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
     MOS_STATUS AddCmd_AVC_SLICE_Addr(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
     MOS_STATUS SetAndAddAvcSliceState(MOS_COMMAND_BUFFER &cmdBuffer, uint32_t slcIdx);
@@ -151,6 +154,11 @@ protected:
     bool                    m_decodeInUse                               = false;
     PCODEC_AVC_SLICE_PARAMS m_pAvcSliceParams                           = nullptr;
 
+    // Slices of a picture mostly share ref lists and weights, so their REF_IDX and
+    // WEIGHTOFFSET commands are added from these caches, reset for each picture
+    AvcSliceCmdCache        m_refIdxCache[2];
+    AvcSliceCmdCache        m_weightOffsetCache[2];
+
 MEDIA_CLASS_DEFINE_END(decode__AvcDecodeSlcPkt)
 };
 
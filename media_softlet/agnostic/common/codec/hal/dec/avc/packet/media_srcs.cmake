@@ -31,6 +31,7 @@ set(SOFTLET_DECODE_AVC_HEADERS_
     ${SOFTLET_DECODE_AVC_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_packet.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_slice_packet.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_avc_slice_cmd_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_picture_packet.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_avc_downsampling_packet.h
 )
@@ -340,18 +340,23 @@ namespace encode
         uint16_t FrameWidthInStreamInBlocks  = MOS_ALIGN_CEIL(CurFrameWidth, blockSize) / blockSize;
         uint16_t FrameHeightInStreamInBlocks = MOS_ALIGN_CEIL(CurFrameHeight, blockSize) / blockSize;
 
-        for (int yIdx = 0; yIdx < FrameHeightInStreamInBlocks; yIdx++)
+        ENCODE_CHK_NULL_RETURN(m_pSegmentMap);
+        ENCODE_CHK_NULL_RETURN(m_streamIn);
+        const StreamInRasterizer &rasterizer = m_streamIn->GetRasterizer();
+        ENCODE_CHK_COND_RETURN(FrameWidthInStreamInBlocks > rasterizer.GetWidth() || FrameHeightInStreamInBlocks > rasterizer.GetHeight(),
+            "Stream in map doesn't cover the frame");
+
+        const uint32_t segMapPitch = MOS_ALIGN_CEIL(CurFrameWidth, m_segmentMapBlockSize) / m_segmentMapBlockSize;
+
+        for (uint32_t yIdx = 0; yIdx < FrameHeightInStreamInBlocks; yIdx++)
         {
+            const uint32_t *streamInRow = rasterizer.GetRow(yIdx);
+            const uint8_t  *segMapRow   = m_pSegmentMap + ScaleCoord(yIdx, blockSize, m_segmentMapBlockSize) * segMapPitch;
+
             for (uint32_t xIdx = 0; xIdx < FrameWidthInStreamInBlocks; xIdx++)
             {
-                const uint32_t IdxBlockInStreamIn = m_streamIn->GetCuOffset(xIdx, yIdx);
-                const uint32_t segMapPitch = MOS_ALIGN_CEIL(CurFrameWidth, m_segmentMapBlockSize) / m_segmentMapBlockSize;
-                const uint32_t segMapY = ScaleCoord(yIdx, blockSize, m_segmentMapBlockSize);
-                const uint32_t segMapX = ScaleCoord(xIdx, blockSize, m_segmentMapBlockSize);
-
-                ENCODE_ASSERT(m_pSegmentMap);
-
-                const uint8_t segId = m_pSegmentMap[segMapY * segMapPitch + segMapX];
+                const uint32_t IdxBlockInStreamIn = streamInRow[xIdx];
+                const uint8_t  segId              = segMapRow[ScaleCoord(xIdx, blockSize, m_segmentMapBlockSize)];
 
                 streamInData[IdxBlockInStreamIn].DW7.SegIDEnable = 1;
                 // Minimum size for a SegID is a 32x32 block.
@@ -124,6 +124,10 @@ namespace encode
                 m_LcuMap = static_cast<uint32_t *>(MOS_AllocAndZeroMemory(m_widthInLCU * m_heightInLCU * sizeof(uint32_t)));
             }
             ENCODE_CHK_STATUS_RETURN(SetupLCUMap());
+            m_rasterizer.Update(
+                m_widthInLCU * m_num32x32BlocksInLCUOnedimension,
+                m_heightInLCU * m_num32x32BlocksInLCUOnedimension,
+                [this](uint32_t x, uint32_t y) { return GetCuOffset(x, y); });
             m_initialized = true;
         }
 
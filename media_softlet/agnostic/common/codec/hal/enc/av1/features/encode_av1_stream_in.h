@@ -30,6 +30,7 @@
 #include "codec_def_encode_av1.h"
 #include "mhw_vdbox_vdenc_itf.h"
 #include "mhw_vdbox_avp_itf.h"
+#include "encode_streamin_rasterizer.h"
 
 namespace encode
 {
@@ -236,6 +237,12 @@ public:
     //!
     uint32_t GetCuOffset(uint32_t xIdx, uint32_t yIdx) const;
 
+    //!
+    //! \brief  Get the CU32x32 to stream in buffer offset map of the current resolution
+    //! \return const StreamInRasterizer &
+    //!
+    const StreamInRasterizer &GetRasterizer() const { return m_rasterizer; }
+
     //!
     //! \brief  Get stream in buffer base locked addrress
     //! \return VdencStreamInState*
@@ -314,6 +321,8 @@ protected:
 
     uint32_t *m_LcuMap = nullptr;
 
+    StreamInRasterizer m_rasterizer;     //!< GetCuOffset of every CU32x32, rebuilt with the LCU map
+
     CommonStreamInParams m_commonPar = {};
 
     uint8_t *m_streamInTemp = nullptr;
@@ -72,7 +72,6 @@ namespace encode
         ENCODE_CHK_STATUS_RETURN(m_vdencStreamInFeature->Clear());
 
         int32_t dqpIdx;
-        uint32_t curX, curY;
 
         if (m_picParam->bNativeROI)
         {
@@ -84,13 +83,10 @@ namespace encode
             for (int32_t i = m_picParam->NumROI - 1; i >= 0; i--)
             {
                 ENCODE_CHK_STATUS_MESSAGE_RETURN(GetDeltaQPIndex(m_maxNumNativeRoi, m_picParam->ROI[i].PriorityLevelOrDQp, dqpIdx), "dQP index not found");
-                for (curY = m_picParam->ROI[i].Top; curY < m_picParam->ROI[i].Bottom; curY++)
-                {
-                    for (curX = m_picParam->ROI[i].Left; curX < m_picParam->ROI[i].Right; curX++)
-                    {
-                        (pData + (m_basicFeature->m_picWidthInMb * curY + curX))->DW0.RegionOfInterestSelection = dqpIdx + 1;  // Shift ROI by 1
-                    }
-                }
+                const auto &roi = m_picParam->ROI[i];
+                m_rasterizer.ForEachBlock(roi.Left, roi.Top, roi.Right, roi.Bottom, [pData, dqpIdx](uint32_t mb) {
+                    pData[mb].DW0.RegionOfInterestSelection = dqpIdx + 1;  // Shift ROI by 1
+                });
             }
             m_vdencStreamInFeature->Unlock();
         }
@@ -108,13 +104,10 @@ namespace encode
             for (int32_t i = m_picParam->NumROI - 1; i >= 0; i--)
             {
                 ENCODE_CHK_STATUS_MESSAGE_RETURN(GetDeltaQPIndex(m_maxNumBrcRoi, m_picParam->ROI[i].PriorityLevelOrDQp, dqpIdx), "dQP index not found");
-                for (curY = m_picParam->ROI[i].Top; curY < m_picParam->ROI[i].Bottom; curY++)
-                {
-                    for (curX = m_picParam->ROI[i].Left; curX < m_picParam->ROI[i].Right; curX++)
-                    {
-                        (pRoiMapBuffer + (m_basicFeature->m_picWidthInMb * curY + curX))->roiIndex = dqpIdx + 1; // Shift ROI by 1
-                    }
-                }
+                const auto &roi = m_picParam->ROI[i];
+                m_rasterizer.ForEachBlock(roi.Left, roi.Top, roi.Right, roi.Bottom, [pRoiMapBuffer, dqpIdx](uint32_t mb) {
+                    pRoiMapBuffer[mb].roiIndex = dqpIdx + 1;  // Shift ROI by 1
+                });
             }
             m_allocator->UnLock(pResRoiMapBuffer);
         }
@@ -84,14 +84,10 @@ MOS_STATUS AvcVdencCqpRoiFeature::SetupROI()
                 return MOS_STATUS_INVALID_PARAMETER;
             }
 
-            uint32_t curX, curY;
-            for (curY = m_picParam->ROI[i].Top; curY < m_picParam->ROI[i].Bottom; curY++)
-            {
-                for (curX = m_picParam->ROI[i].Left; curX < m_picParam->ROI[i].Right; curX++)
-                {
-                    (pData + (m_basicFeature->m_picWidthInMb * curY + curX))->DW0.RegionOfInterestSelection = dqpidx + 1;  //Shift ROI by 1
-                }
-            }
+            const auto &roi = m_picParam->ROI[i];
+            m_rasterizer.ForEachBlock(roi.Left, roi.Top, roi.Right, roi.Bottom, [pData, dqpidx](uint32_t mb) {
+                pData[mb].DW0.RegionOfInterestSelection = dqpidx + 1;  //Shift ROI by 1
+            });
         }
     }
     else
@@ -105,15 +101,11 @@ MOS_STATUS AvcVdencCqpRoiFeature::SetupROI()
         }
         for (int32_t i = m_picParam->NumROI - 1; i >= 0; i--)
         {
-            uint32_t curX, curY;
-            int8_t   newQp = (int8_t)CodecHal_Clip3(10, 51, qpPrimeY + m_picParam->ROI[i].PriorityLevelOrDQp);
-            for (curY = m_picParam->ROI[i].Top; curY < m_picParam->ROI[i].Bottom; curY++)
-            {
-                for (curX = m_picParam->ROI[i].Left; curX < m_picParam->ROI[i].Right; curX++)
-                {
-                    (pData + (m_basicFeature->m_picWidthInMb * curY + curX))->DW1.QpPrimeY = newQp;
-                }
-            }
+            const auto &roi   = m_picParam->ROI[i];
+            int8_t      newQp = (int8_t)CodecHal_Clip3(10, 51, qpPrimeY + roi.PriorityLevelOrDQp);
+            m_rasterizer.ForEachBlock(roi.Left, roi.Top, roi.Right, roi.Bottom, [pData, newQp](uint32_t mb) {
+                pData[mb].DW1.QpPrimeY = newQp;
+            });
         }
     }
 
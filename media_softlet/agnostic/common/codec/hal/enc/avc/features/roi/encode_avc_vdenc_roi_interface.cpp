@@ -95,6 +95,7 @@ MOS_STATUS AvcVdencRoiInterface::Update(void *params)
         ENCODE_CHK_STATUS_RETURN(IsModesSupported(m_supportedModes.ROI_Native | m_supportedModes.ROI_NonNative, "ROI"));
 
         m_picParam->bNativeROI = ProcessRoiDeltaQp();
+        m_rasterizer.Update(m_basicFeature->m_picWidthInMb, m_basicFeature->m_picHeightInMb, StreamInRasterizer::scanRaster);
         ENCODE_CHK_STATUS_RETURN(SetupROI());
     }
     else if (m_picParam->NumDirtyROI)
@@ -29,6 +29,7 @@
 
 #include "encode_avc_brc.h"
 #include "encode_avc_vdenc_stream_in_feature.h"
+#include "encode_streamin_rasterizer.h"
 
 namespace encode
 {
@@ -124,6 +125,8 @@ protected:
     SupportedModes   m_supportedModes;
     bool             m_isNativeRoi = false;
 
+    StreamInRasterizer m_rasterizer;  //!< Raster map of the per MB stream-in and ROI map buffers
+
 MEDIA_CLASS_DEFINE_END(encode__AvcVdencRoiInterface)
 };
 
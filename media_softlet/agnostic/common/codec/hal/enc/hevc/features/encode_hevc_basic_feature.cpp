@@ -1098,6 +1098,7 @@ MHW_SETPAR_DECL_SRC(HEVC_VP9_RDOQ_STATE, HevcBasicFeature)
     uint8_t bitDepthChromaMinus8 = m_hevcSeqParams->bit_depth_chroma_minus8;
     uint8_t codingType           = m_hevcPicParams->CodingType;
     auto    settings             = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
+    ENCODE_CHK_NULL_RETURN(settings);
 
     if (bitDepthLumaMinus8 < 8)
     {
@@ -1107,121 +1108,71 @@ MHW_SETPAR_DECL_SRC(HEVC_VP9_RDOQ_STATE, HevcBasicFeature)
         MOS_ZeroMemory(params.lambdaTab, sizeof(params.lambdaTab));
         if (bitDepthLumaMinus8 == 0)
         {
-            std::copy(settings->rdoqLamdas8bits[sliceTypeIdx][0][0].begin(),
-                settings->rdoqLamdas8bits[sliceTypeIdx][0][0].end(),
+            ENCODE_CHK_NULL_RETURN(settings->rdoqLamdas8bits);
+            std::copy((*settings->rdoqLamdas8bits)[sliceTypeIdx][0][0].begin(),
+                (*settings->rdoqLamdas8bits)[sliceTypeIdx][0][0].end(),
                 std::begin(params.lambdaTab[0][0]));
 
-            std::copy(settings->rdoqLamdas8bits[sliceTypeIdx][0][1].begin(),
-                settings->rdoqLamdas8bits[sliceTypeIdx][0][1].end(),
+            std::copy((*settings->rdoqLamdas8bits)[sliceTypeIdx][0][1].begin(),
+                (*settings->rdoqLamdas8bits)[sliceTypeIdx][0][1].end(),
                 std::begin(params.lambdaTab[0][1]));
 
-            std::copy(settings->rdoqLamdas8bits[sliceTypeIdx][1][0].begin(),
-                settings->rdoqLamdas8bits[sliceTypeIdx][1][0].end(),
+            std::copy((*settings->rdoqLamdas8bits)[sliceTypeIdx][1][0].begin(),
+                (*settings->rdoqLamdas8bits)[sliceTypeIdx][1][0].end(),
                 std::begin(params.lambdaTab[1][0]));
 
-            std::copy(settings->rdoqLamdas8bits[sliceTypeIdx][1][1].begin(),
-                settings->rdoqLamdas8bits[sliceTypeIdx][1][1].end(),
+            std::copy((*settings->rdoqLamdas8bits)[sliceTypeIdx][1][1].begin(),
+                (*settings->rdoqLamdas8bits)[sliceTypeIdx][1][1].end(),
                 std::begin(params.lambdaTab[1][1]));
         }
         else if (bitDepthLumaMinus8 == 2)
         {
-            std::copy(settings->rdoqLamdas10bits[sliceTypeIdx][0][0].begin(),
-                settings->rdoqLamdas10bits[sliceTypeIdx][0][0].end(),
+            ENCODE_CHK_NULL_RETURN(settings->rdoqLamdas10bits);
+            std::copy((*settings->rdoqLamdas10bits)[sliceTypeIdx][0][0].begin(),
+                (*settings->rdoqLamdas10bits)[sliceTypeIdx][0][0].end(),
                 std::begin(params.lambdaTab[0][0]));
 
-            std::copy(settings->rdoqLamdas10bits[sliceTypeIdx][0][1].begin(),
-                settings->rdoqLamdas10bits[sliceTypeIdx][0][1].end(),
+            std::copy((*settings->rdoqLamdas10bits)[sliceTypeIdx][0][1].begin(),
+                (*settings->rdoqLamdas10bits)[sliceTypeIdx][0][1].end(),
                 std::begin(params.lambdaTab[0][1]));
 
-            std::copy(settings->rdoqLamdas10bits[sliceTypeIdx][1][0].begin(),
-                settings->rdoqLamdas10bits[sliceTypeIdx][1][0].end(),
+            std::copy((*settings->rdoqLamdas10bits)[sliceTypeIdx][1][0].begin(),
+                (*settings->rdoqLamdas10bits)[sliceTypeIdx][1][0].end(),
                 std::begin(params.lambdaTab[1][0]));
 
-            std::copy(settings->rdoqLamdas10bits[sliceTypeIdx][1][1].begin(),
-                settings->rdoqLamdas10bits[sliceTypeIdx][1][1].end(),
+            std::copy((*settings->rdoqLamdas10bits)[sliceTypeIdx][1][1].begin(),
+                (*settings->rdoqLamdas10bits)[sliceTypeIdx][1][1].end(),
                 std::begin(params.lambdaTab[1][1]));
         }
         else if (bitDepthLumaMinus8 == 4)
         {
-            std::copy(settings->rdoqLamdas12bits[sliceTypeIdx][0][0].begin(),
-                settings->rdoqLamdas12bits[sliceTypeIdx][0][0].end(),
+            ENCODE_CHK_NULL_RETURN(settings->rdoqLamdas12bits);
+            std::copy((*settings->rdoqLamdas12bits)[sliceTypeIdx][0][0].begin(),
+                (*settings->rdoqLamdas12bits)[sliceTypeIdx][0][0].end(),
                 std::begin(params.lambdaTab[0][0]));
 
-            std::copy(settings->rdoqLamdas12bits[sliceTypeIdx][0][1].begin(),
-                settings->rdoqLamdas12bits[sliceTypeIdx][0][1].end(),
+            std::copy((*settings->rdoqLamdas12bits)[sliceTypeIdx][0][1].begin(),
+                (*settings->rdoqLamdas12bits)[sliceTypeIdx][0][1].end(),
                 std::begin(params.lambdaTab[0][1]));
 
-            std::copy(settings->rdoqLamdas12bits[sliceTypeIdx][1][0].begin(),
-                settings->rdoqLamdas12bits[sliceTypeIdx][1][0].end(),
+            std::copy((*settings->rdoqLamdas12bits)[sliceTypeIdx][1][0].begin(),
+                (*settings->rdoqLamdas12bits)[sliceTypeIdx][1][0].end(),
                 std::begin(params.lambdaTab[1][0]));
 
-            std::copy(settings->rdoqLamdas12bits[sliceTypeIdx][1][1].begin(),
-                settings->rdoqLamdas12bits[sliceTypeIdx][1][1].end(),
+            std::copy((*settings->rdoqLamdas12bits)[sliceTypeIdx][1][1].begin(),
+                (*settings->rdoqLamdas12bits)[sliceTypeIdx][1][1].end(),
                 std::begin(params.lambdaTab[1][1]));
         }
     }
     else
     {
-        int32_t shiftQP = 12;
-#if INTRACONF
-        double lambdaScale = 1.8;  //Intra
-#else
-        double lambdaScale = 1.0 - 0.35;  //LD or RA
-#endif
-        double   qpTemp       = 0;
-        double   lambdaDouble = 0;
-        uint32_t lambda       = 0;
-        double   qpFactor     = 0.55;
-
-        MOS_ZeroMemory(params.lambdaTab, sizeof(params.lambdaTab));
+        auto &lumaLambdas   = HevcVdencRdoqConstSettings::GetGeneratedLambdas(bitDepthLumaMinus8);
+        auto &chromaLambdas = HevcVdencRdoqConstSettings::GetGeneratedLambdas(bitDepthChromaMinus8);
 
-        int32_t bitdepthLumaQpScaleLuma   = 6 * bitDepthLumaMinus8;
-        int32_t bitdepthLumaQpScaleChroma = 6 * bitDepthChromaMinus8;
-
-        //Intra lambda
-        qpFactor = 0.25 * lambdaScale;
-        for (uint8_t qp = 0; qp < 52 + bitdepthLumaQpScaleLuma; qp++)
-        {
-            qpTemp              = (double)qp - bitdepthLumaQpScaleLuma - shiftQP;
-            lambdaDouble        = qpFactor * pow(2.0, qpTemp / 3.0);
-            lambdaDouble        = lambdaDouble * 16 + 0.5;
-            lambdaDouble        = (lambdaDouble > 65535) ? 65535 : lambdaDouble;
-            lambda              = (uint32_t)floor(lambdaDouble);
-            params.lambdaTab[0][0][qp] = (uint16_t)lambda;
-        }
-        for (uint8_t qp = 0; qp < 52 + bitdepthLumaQpScaleChroma; qp++)
-        {
-            qpTemp              = (double)qp - bitdepthLumaQpScaleChroma - shiftQP;
-            lambdaDouble        = qpFactor * pow(2.0, qpTemp / 3.0);
-            lambdaDouble        = lambdaDouble * 16 + 0.5;
-            lambdaDouble        = (lambdaDouble > 65535) ? 65535 : lambdaDouble;
-            lambda              = (uint32_t)floor(lambdaDouble);
-            params.lambdaTab[0][1][qp] = (uint16_t)lambda;
-        }
-
-        ////Inter lambda
-        qpFactor = 0.55;
-        for (uint8_t qp = 0; qp < 52 + bitdepthLumaQpScaleLuma; qp++)
-        {
-            qpTemp       = (double)qp - bitdepthLumaQpScaleLuma - shiftQP;
-            lambdaDouble = qpFactor * pow(2.0, qpTemp / 3.0);
-            lambdaDouble *= MOS_MAX(1.00, MOS_MIN(1.6, 1.0 + 0.6 / 12.0 * (qpTemp - 10.0)));
-            lambdaDouble        = lambdaDouble * 16 + 0.5;
-            lambda              = (uint32_t)floor(lambdaDouble);
-            lambdaDouble        = (lambdaDouble > 65535) ? 65535 : lambdaDouble;
-            lambda              = CodecHal_Clip3(0, 0xffff, lambda);
-            params.lambdaTab[1][0][qp] = (uint16_t)lambda;
-        }
-        for (uint8_t qp = 0; qp < 52 + bitdepthLumaQpScaleChroma; qp++)
+        for (uint32_t i = 0; i < 2; i++)  // intra, inter
         {
-            qpTemp       = (double)qp - bitdepthLumaQpScaleChroma - shiftQP;
-            lambdaDouble = qpFactor * pow(2.0, qpTemp / 3.0);
-            lambdaDouble *= MOS_MAX(0.95, MOS_MIN(1.20, 0.25 / 12.0 * (qpTemp - 10.0) + 0.95));
-            lambdaDouble        = lambdaDouble * 16 + 0.5;
-            lambda              = (uint32_t)floor(lambdaDouble);
-            lambdaDouble        = (lambdaDouble > 65535) ? 65535 : lambdaDouble;
-            lambda              = CodecHal_Clip3(0, 0xffff, lambda);
-            params.lambdaTab[1][1][qp] = (uint16_t)lambda;
+            std::copy(lumaLambdas[i][0].begin(), lumaLambdas[i][0].end(), std::begin(params.lambdaTab[i][0]));
+            std::copy(chromaLambdas[i][1].begin(), chromaLambdas[i][1].end(), std::begin(params.lambdaTab[i][1]));
         }
     }
 
@@ -251,7 +251,7 @@ namespace encode
         auto       setting = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
         ENCODE_CHK_NULL_RETURN(setting);
 
-        auto brcSettings = setting->brcSettings;
+        const auto &brcSettings = setting->brcSettings;
 
         MOS_SecureMemcpy(hucVdencBrcUpdateDmem->startGAdjFrame_U16, 4 * sizeof(uint16_t), brcSettings.startGAdjFrame.data, 4 * sizeof(uint16_t));
         MOS_SecureMemcpy(hucVdencBrcUpdateDmem->gRateRatioThreshold_U8, 7 * sizeof(uint8_t), brcSettings.rateRatioThreshold.data, 7 * sizeof(uint8_t));
@@ -408,7 +408,7 @@ namespace encode
         auto       setting = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
         ENCODE_CHK_NULL_RETURN(setting);
 
-        auto brcSettings = setting->brcSettings;
+        const auto &brcSettings = setting->brcSettings;
 
         if (lambdaType)
         {
@@ -455,7 +455,7 @@ namespace encode
         auto       setting = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
         ENCODE_CHK_NULL_RETURN(setting);
 
-        auto brcSettings = setting->brcSettings;
+        const auto &brcSettings = setting->brcSettings;
 
         MOS_SecureMemcpy(hucConstData->VdencHevcHucBrcConstantData_4, brcSettings.hucConstantData.size, brcSettings.hucConstantData.data, brcSettings.hucConstantData.size);
 
@@ -497,7 +497,7 @@ namespace encode
         auto setting = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
         ENCODE_CHK_NULL_RETURN(setting);
 
-        auto brcSettings = setting->brcSettings;
+        const auto &brcSettings = setting->brcSettings;
 
         hucVdencBrcInitDmem->TargetBitrate_U32 = m_basicFeature->m_hevcSeqParams->TargetBitRate * m_brc_kbps;
         hucVdencBrcInitDmem->MaxRate_U32       = m_basicFeature->m_hevcSeqParams->MaxBitRate * m_brc_kbps;
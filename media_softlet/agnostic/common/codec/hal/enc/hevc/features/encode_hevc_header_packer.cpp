@@ -226,19 +226,12 @@ void HevcHeaderPacker::PackSSHPartIndependent(
 
     bool bNonIDR = nalu.nal_unit_type != IDR_W_RADL && nalu.nal_unit_type != IDR_N_LP;
 
-    if (bNonIDR)
-        PackSSHPartNonIDR(bs, sps, slice);
-
-    if (sps.sample_adaptive_offset_enabled_flag)
-    {
-        bs.AddInfo(PACK_SAOOffset, bs.GetOffset());
-
-        nSE += PutBit(bs, slice.sao_luma_flag);
-        nSE += PutBit(bs, slice.sao_chroma_flag);
-    }
+    nSE += bNonIDR && PutBits(bs, sps.log2_max_pic_order_cnt_lsb_minus4 + 4, slice.pic_order_cnt_lsb);
 
-    if (slice.type != I)
-        PackSSHPartPB(bs, sps, pps, slice);
+    if (m_bSshCacheEnabled)
+        PackSSHPartCached(bs, sps, pps, slice, bNonIDR);
+    else
+        PackSSHPartInvariant(bs, sps, pps, slice, bNonIDR);
 
     bs.AddInfo(PACK_QPDOffset, bs.GetOffset());
 
@@ -260,6 +253,109 @@ void HevcHeaderPacker::PackSSHPartIndependent(
     ENCODE_ASSERT(nSE >= 2);
 }
 
+void HevcHeaderPacker::PackSSHPartCached(
+    BitstreamWriter &bs,
+    SPS const &      sps,
+    PPS const &      pps,
+    Slice const &    slice,
+    bool             bNonIDR)
+{
+    // Cached parts are only valid for the SPS/PPS they were packed with. Slice
+    // header params loaded per slice also update both, so check on every slice.
+    if (memcmp(&m_sshCacheSps, &sps, sizeof(sps)) || memcmp(&m_sshCachePps, &pps, sizeof(pps)))
+    {
+        MOS_SecureMemcpy(&m_sshCacheSps, sizeof(m_sshCacheSps), &sps, sizeof(sps));
+        MOS_SecureMemcpy(&m_sshCachePps, sizeof(m_sshCachePps), &pps, sizeof(pps));
+        for (auto &entry : m_sshCache)
+        {
+            entry.valid = false;
+        }
+    }
+
+    // Clear the fields packed outside of this part so slices and frames
+    // differing only in address, POC or QP share the cached bits
+    Slice key;
+    MOS_SecureMemcpy(&key, sizeof(key), &slice, sizeof(slice));
+    key.no_output_of_prior_pics_flag           = 0;
+    key.pic_parameter_set_id                   = 0;
+    key.dependent_slice_segment_flag           = 0;
+    key.segment_address                        = 0;
+    key.reserved_flags                         = 0;
+    key.colour_plane_id                        = 0;
+    key.pic_output_flag                        = 0;
+    key.first_slice_segment_in_pic_flag        = 0;
+    key.pic_order_cnt_lsb                      = 0;
+    key.slice_qp_delta                         = 0;
+    key.slice_cb_qp_offset                     = 0;
+    key.slice_cr_qp_offset                     = 0;
+    key.deblocking_filter_override_flag        = 0;
+    key.deblocking_filter_disabled_flag        = 0;
+    key.loop_filter_across_slices_enabled_flag = 0;
+    key.beta_offset_div2                       = 0;
+    key.tc_offset_div2                         = 0;
+    key.num_entry_point_offsets                = 0;
+
+    SSHPart *part = nullptr;
+    for (auto &entry : m_sshCache)
+    {
+        if (entry.valid && entry.nonIDR == bNonIDR && !memcmp(&entry.key, &key, sizeof(key)))
+        {
+            part = &entry;
+            break;
+        }
+    }
+
+    if (part == nullptr)
+    {
+        part = &m_sshCache[m_sshCacheNext];
+        m_sshCacheNext = (m_sshCacheNext + 1) % m_sshCache.size();
+
+        BitstreamWriter partBs(part->bits.data(), (mfxU32)part->bits.size());
+        part->info.clear();
+        partBs.SetInfo(&part->info);
+
+        PackSSHPartInvariant(partBs, sps, pps, slice, bNonIDR);
+
+        partBs.Flush();
+        part->bitLen = partBs.GetOffset();
+        part->nonIDR = bNonIDR;
+        part->valid  = true;
+        MOS_SecureMemcpy(&part->key, sizeof(part->key), &key, sizeof(key));
+    }
+
+    // Offsets recorded in the part are relative to its first bit
+    mfxU32 base = bs.GetOffset();
+    for (auto &info : part->info)
+    {
+        bs.AddInfo(info.first, info.second + (info.first == PACK_PWTLength ? 0 : base));
+    }
+    bs.PutBitsBuffer(part->bitLen, part->bits.data());
+}
+
+void HevcHeaderPacker::PackSSHPartInvariant(
+    BitstreamWriter &bs,
+    SPS const &      sps,
+    PPS const &      pps,
+    Slice const &    slice,
+    bool             bNonIDR)
+{
+    const mfxU8 I = 2;
+
+    if (bNonIDR)
+        PackSSHPartNonIDR(bs, sps, slice);
+
+    if (sps.sample_adaptive_offset_enabled_flag)
+    {
+        bs.AddInfo(PACK_SAOOffset, bs.GetOffset());
+
+        PutBit(bs, slice.sao_luma_flag);
+        PutBit(bs, slice.sao_chroma_flag);
+    }
+
+    if (slice.type != I)
+        PackSSHPartPB(bs, sps, pps, slice);
+}
+
 void HevcHeaderPacker::PackSSHPartNonIDR(
     BitstreamWriter &bs,
     SPS const &      sps,
@@ -279,7 +375,6 @@ void HevcHeaderPacker::PackSSHPartNonIDR(
         nSE += lt.delta_poc_msb_present_flag && PutUE(bs, lt.delta_poc_msb_cycle_lt);
     };
 
-    nSE += PutBits(bs, sps.log2_max_pic_order_cnt_lsb_minus4 + 4, slice.pic_order_cnt_lsb);
     nSE += PutBit(bs, slice.short_term_ref_pic_set_sps_flag);
 
     if (!slice.short_term_ref_pic_set_sps_flag)
@@ -302,7 +397,7 @@ void HevcHeaderPacker::PackSSHPartNonIDR(
 
     nSE += sps.temporal_mvp_enabled_flag && PutBit(bs, slice.temporal_mvp_enabled_flag);
 
-    ENCODE_ASSERT(nSE >= 2);
+    ENCODE_ASSERT(nSE >= 1);
 }
 
 void HevcHeaderPacker::PackSTRPS(BitstreamWriter &bs, const STRPS *sets, mfxU32 num, mfxU32 idx)
@@ -550,6 +645,7 @@ MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
         rbsp.Reset(pBegin, mfxU32(pEnd - pBegin));
         m_naluParams.long_start_code = 0/*pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 == pBSBuffer->pBase*/;
         PackSSH(rbsp, m_naluParams, m_spsParams, m_ppsParams, m_sliceParams, m_bDssEnabled);
+        rbsp.Flush();
         BitLen = rbsp.GetOffset();
         pBegin += CeilDiv(BitLen, 8u);
         pSlcData[slcCount].SliceOffset            = (uint32_t)(pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 - pBSBuffer->pBase);
@@ -32,6 +32,8 @@
 #include "codec_def_encode_hevc.h"
 #include <exception>
 #include <array>
+#include <map>
+#include <cstring>
 #include <numeric>
 #include <algorithm>
 
@@ -491,6 +493,22 @@ public:
     std::array<mfxU8, 1024> m_rbsp          = {};
     bool                    m_bDssEnabled   = false;
 
+    //! \brief Packed slice header bits between pic_order_cnt_lsb and slice_qp_delta
+    struct SSHPart
+    {
+        HevcSlice                key    = {};     //!< Slice params with the fields packed outside this part cleared
+        bool                     nonIDR = false;
+        bool                     valid  = false;
+        mfxU32                   bitLen = 0;
+        std::array<mfxU8, 1024>  bits   = {};
+        std::map<mfxU32, mfxU32> info;            //!< Pack info recorded relative to the part start
+    };
+    std::array<SSHPart, 4> m_sshCache         = {};    //!< Recently packed parts, replaced round robin
+    mfxU32                 m_sshCacheNext     = 0;
+    HevcSPS                m_sshCacheSps      = {};    //!< SPS the cached parts were packed with
+    HevcPPS                m_sshCachePps      = {};    //!< PPS the cached parts were packed with
+    bool                   m_bSshCacheEnabled = true;  //!< Pack the part for every slice if false
+
 public:
     HevcHeaderPacker();
     MOS_STATUS SliceHeaderPacker(EncoderParams *encodeParams);
@@ -537,6 +555,29 @@ public:
         PPS const &      pps,
         Slice const &    slice);
 
+    //!
+    //! \brief  Packs the slice header from after pic_order_cnt_lsb up to slice_qp_delta
+    //! \details These bits only depend on the SPS/PPS, the reference structure and the
+    //!          prediction weights, so they are packed once and spliced into later
+    //!          slices with the same parameters.
+    //!
+    void PackSSHPartCached(
+        BitstreamWriter &bs,
+        SPS const &      sps,
+        PPS const &      pps,
+        Slice const &    slice,
+        bool             bNonIDR);
+
+    //!
+    //! \brief  Packs the slice header part PackSSHPartCached caches, without caching
+    //!
+    void PackSSHPartInvariant(
+        BitstreamWriter &bs,
+        SPS const &      sps,
+        PPS const &      pps,
+        Slice const &    slice,
+        bool             bNonIDR);
+
     void PackSSHPartNonIDR(
         BitstreamWriter &bs,
         SPS const &      sps,
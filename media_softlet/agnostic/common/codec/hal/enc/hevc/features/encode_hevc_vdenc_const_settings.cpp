@@ -515,97 +515,8 @@ MOS_STATUS EncodeHevcVdencConstSettings::SetTUSettings()
     return eStatus;
 }
 
-MOS_STATUS EncodeHevcVdencConstSettings::SetCommonSettings()
-{
-    ENCODE_FUNC_CALL();
-    ENCODE_CHK_NULL_RETURN(m_featureSetting);
-
-    auto setting = static_cast<HevcVdencFeatureSettings *>(m_featureSetting);
-    ENCODE_CHK_NULL_RETURN(setting);
-
-    setting->transformSkipCoeffsTable = {{
-        {{
-            {{
-                {{
-                    {42, 37}, {32, 40}
-                }},
-                {{
-                    {40, 40}, {32, 45}
-                }}
-            }},
-            {{
-                {{
-                    {29, 48}, {26, 53}
-                }},
-                {{
-                    {26, 56}, {24, 62}
-                }}
-            }}
-        }},
-        {{
-            {{
-                {{
-                    {42, 40}, {32, 45}
-                }},
-                {{
-                    {40, 46}, {32, 48}
-                }}
-            }},
-            {{
-                {{
-                    {26, 53}, {24, 58}
-                }},
-                {{
-                    {32, 53}, {26, 64}
-                }}
-            }}
-        }},
-        {{
-            {{
-                {{
-                    {38, 42}, {32, 51}
-                }},
-                {{
-                    {43, 43}, {35, 46}
-                }}
-            }},
-            {{
-                {{
-                    {26, 56}, {24, 64}
-                }},
-                {{
-                    {35, 50}, {32, 57}
-                }}
-            }}
-        }},
-        {{
-            {{
-                {{
-                    {35, 46}, {32, 52}
-                }},
-                {{
-                    {51, 42}, {38, 53}
-                }}
-            }},
-            {{
-                {{
-                    {29, 56}, {29, 70}
-                }},
-                {{
-                    {38, 47}, {37, 64}
-                }}
-            }}
-        }},
-    }};
-
-    setting->transformSkipLambdaTable = {
-    149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
-    149, 149, 149, 149, 149, 149, 149, 149, 149, 162, 174, 186, 199, 211, 224, 236,
-    249, 261, 273, 286, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298,
-    298, 298, 298, 298
-    };
-
-    setting->rdoqLamdas8bits = {{
+// RDOQ lambdas, [slice type][intra/inter][luma/chroma][qp]
+const HevcRdoqLambdaTable<52> HevcVdencRdoqConstSettings::m_rdoqLamdas8bits = {{
     {{
         {{
             {   //Intra Luma
@@ -692,7 +603,7 @@ MOS_STATUS EncodeHevcVdencConstSettings::SetCommonSettings()
     }}
 }};
 
-    setting->rdoqLamdas10bits = {{
+const HevcRdoqLambdaTable<64> HevcVdencRdoqConstSettings::m_rdoqLamdas10bits = {{
     {{
         {{
             {   //Intra Luma
@@ -787,7 +698,7 @@ MOS_STATUS EncodeHevcVdencConstSettings::SetCommonSettings()
     }}
 }};
 
-    setting->rdoqLamdas12bits = {{
+const HevcRdoqLambdaTable<76> HevcVdencRdoqConstSettings::m_rdoqLamdas12bits = {{
     {{
         {{
             {   //Intra Luma
@@ -898,6 +809,146 @@ MOS_STATUS EncodeHevcVdencConstSettings::SetCommonSettings()
     }}
 }};
 
+const HevcRdoqLambdaDepthTable &HevcVdencRdoqConstSettings::GetGeneratedLambdas(uint8_t bitDepthMinus8)
+{
+    static const std::array<HevcRdoqLambdaDepthTable, m_maxBitDepthMinus8 + 1> lambdas = [] {
+        std::array<HevcRdoqLambdaDepthTable, m_maxBitDepthMinus8 + 1> tables = {};
+
+        const int32_t shiftQP = 12;
+#if INTRACONF
+        const double lambdaScale = 1.8;  //Intra
+#else
+        const double lambdaScale = 1.0 - 0.35;  //LD or RA
+#endif
+        for (uint32_t depth = 0; depth <= m_maxBitDepthMinus8; depth++)
+        {
+            HevcRdoqLambdaDepthTable &table   = tables[depth];
+            int32_t                   qpScale = 6 * depth;
+            uint32_t                  qpNum   = MOS_MIN(52 + 6 * depth, (uint32_t)table[0][0].size());
+
+            for (uint32_t qp = 0; qp < qpNum; qp++)
+            {
+                double qpTemp = (double)qp - qpScale - shiftQP;
+
+                //Intra lambda, same for luma and chroma
+                double lambdaDouble = 0.25 * lambdaScale * pow(2.0, qpTemp / 3.0);
+                lambdaDouble        = lambdaDouble * 16 + 0.5;
+                lambdaDouble        = (lambdaDouble > 65535) ? 65535 : lambdaDouble;
+                table[0][0][qp]     = (uint16_t)floor(lambdaDouble);
+                table[0][1][qp]     = table[0][0][qp];
+
+                //Inter lambda
+                lambdaDouble = 0.55 * pow(2.0, qpTemp / 3.0);
+                lambdaDouble *= MOS_MAX(1.00, MOS_MIN(1.6, 1.0 + 0.6 / 12.0 * (qpTemp - 10.0)));
+                lambdaDouble    = lambdaDouble * 16 + 0.5;
+                table[1][0][qp] = (uint16_t)CodecHal_Clip3(0, 0xffff, (uint32_t)floor(lambdaDouble));
+
+                lambdaDouble = 0.55 * pow(2.0, qpTemp / 3.0);
+                lambdaDouble *= MOS_MAX(0.95, MOS_MIN(1.20, 0.25 / 12.0 * (qpTemp - 10.0) + 0.95));
+                lambdaDouble    = lambdaDouble * 16 + 0.5;
+                table[1][1][qp] = (uint16_t)CodecHal_Clip3(0, 0xffff, (uint32_t)floor(lambdaDouble));
+            }
+        }
+        return tables;
+    }();
+
+    return lambdas[MOS_MIN(bitDepthMinus8, m_maxBitDepthMinus8)];
+}
+
+MOS_STATUS EncodeHevcVdencConstSettings::SetCommonSettings()
+{
+    ENCODE_FUNC_CALL();
+    ENCODE_CHK_NULL_RETURN(m_featureSetting);
+
+    auto setting = static_cast<HevcVdencFeatureSettings *>(m_featureSetting);
+    ENCODE_CHK_NULL_RETURN(setting);
+
+    setting->transformSkipCoeffsTable = {{
+        {{
+            {{
+                {{
+                    {42, 37}, {32, 40}
+                }},
+                {{
+                    {40, 40}, {32, 45}
+                }}
+            }},
+            {{
+                {{
+                    {29, 48}, {26, 53}
+                }},
+                {{
+                    {26, 56}, {24, 62}
+                }}
+            }}
+        }},
+        {{
+            {{
+                {{
+                    {42, 40}, {32, 45}
+                }},
+                {{
+                    {40, 46}, {32, 48}
+                }}
+            }},
+            {{
+                {{
+                    {26, 53}, {24, 58}
+                }},
+                {{
+                    {32, 53}, {26, 64}
+                }}
+            }}
+        }},
+        {{
+            {{
+                {{
+                    {38, 42}, {32, 51}
+                }},
+                {{
+                    {43, 43}, {35, 46}
+                }}
+            }},
+            {{
+                {{
+                    {26, 56}, {24, 64}
+                }},
+                {{
+                    {35, 50}, {32, 57}
+                }}
+            }}
+        }},
+        {{
+            {{
+                {{
+                    {35, 46}, {32, 52}
+                }},
+                {{
+                    {51, 42}, {38, 53}
+                }}
+            }},
+            {{
+                {{
+                    {29, 56}, {29, 70}
+                }},
+                {{
+                    {38, 47}, {37, 64}
+                }}
+            }}
+        }},
+    }};
+
+    setting->transformSkipLambdaTable = {
+    149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149, 149,
+    149, 149, 149, 149, 149, 149, 149, 149, 149, 162, 174, 186, 199, 211, 224, 236,
+    249, 261, 273, 286, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298, 298,
+    298, 298, 298, 298
+    };
+
+    setting->rdoqLamdas8bits  = &HevcVdencRdoqConstSettings::m_rdoqLamdas8bits;
+    setting->rdoqLamdas10bits = &HevcVdencRdoqConstSettings::m_rdoqLamdas10bits;
+    setting->rdoqLamdas12bits = &HevcVdencRdoqConstSettings::m_rdoqLamdas12bits;
+
     return MOS_STATUS_SUCCESS;
 }
 
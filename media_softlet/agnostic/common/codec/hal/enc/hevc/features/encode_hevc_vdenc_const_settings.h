@@ -123,6 +123,49 @@ struct HevcVdencArbSettings  // adaptive region boot settings
         m_rowOffsetsForBoost = {{0, 3, 5, 2, 7, 4, 1, 6}};
 };
 
+//!
+//! \brief  RDOQ lambda table, [slice type][intra/inter][luma/chroma][qp]
+//!
+template <size_t qpNum>
+using HevcRdoqLambdaTable =
+    std::array<
+        std::array<
+            std::array<
+                std::array<uint16_t,
+                    qpNum>,
+                2>,
+            2>,
+        2>;
+
+//!
+//! \brief  RDOQ lambdas of one bit depth, [intra/inter][luma/chroma][qp]
+//!
+using HevcRdoqLambdaDepthTable =
+    std::array<
+        std::array<
+            std::array<uint16_t,
+                76>,
+            2>,
+        2>;
+
+struct HevcVdencRdoqConstSettings
+{
+    static const HevcRdoqLambdaTable<52> m_rdoqLamdas8bits;
+    static const HevcRdoqLambdaTable<64> m_rdoqLamdas10bits;
+    static const HevcRdoqLambdaTable<76> m_rdoqLamdas12bits;
+
+    static constexpr uint8_t m_maxBitDepthMinus8 = 8;
+
+    //!
+    //! \brief    Get the lambdas for bit depths without a tuned table
+    //! \details  Tables of all bit depths are generated once per process. Luma
+    //!           entries use the luma and chroma entries the chroma formula.
+    //! \param    [in] bitDepthMinus8
+    //!           Bit depth minus 8, clamped to m_maxBitDepthMinus8
+    //!
+    static const HevcRdoqLambdaDepthTable &GetGeneratedLambdas(uint8_t bitDepthMinus8);
+};
+
 struct HevcVdencFeatureSettings : VdencFeatureSettings
 {
     std::array<bool, NUM_TARGET_USAGE_MODES + 1> rdoqEnable{};
@@ -142,35 +185,10 @@ struct HevcVdencFeatureSettings : VdencFeatureSettings
 
     std::array<uint16_t, 52> transformSkipLambdaTable{};
 
-    std::array<
-        std::array<
-            std::array<
-                std::array<uint16_t,
-                    52>,
-                2>,
-            2>,
-        2>
-        rdoqLamdas8bits{};
-
-    std::array<
-        std::array<
-            std::array<
-                std::array<uint16_t,
-                    64>,
-                2>,
-            2>,
-        2>
-        rdoqLamdas10bits{};
-
-    std::array<
-        std::array<
-            std::array<
-                std::array<uint16_t,
-                    76>,
-                2>,
-            2>,
-        2>
-        rdoqLamdas12bits{};
+    // Shared read-only tables from HevcVdencRdoqConstSettings
+    const HevcRdoqLambdaTable<52> *rdoqLamdas8bits  = nullptr;
+    const HevcRdoqLambdaTable<64> *rdoqLamdas10bits = nullptr;
+    const HevcRdoqLambdaTable<76> *rdoqLamdas12bits = nullptr;
 
     HevcVdencBrcSettings brcSettings = {};
     HevcVdencArbSettings arbSettings = {};
@@ -410,10 +410,7 @@ void DirtyROI::StreaminSetBorderNon64AlignStaticRegion(
     std::vector<uint32_t> lcuVector;
     GetLCUsInRoiRegion(streamInWidth, top, bottom, left, right, lcuVector);
 
-    for (uint32_t lcu : lcuVector)
-    {
-        overlap.MarkLcus(lcuVector, RoiOverlap::mkDirtyRoiBkNone64Align);
-    }
+    overlap.MarkLcus(lcuVector, RoiOverlap::mkDirtyRoiBkNone64Align);
 }
 
 void DirtyROI::SetStreaminBackgroundData(
@@ -347,17 +347,17 @@ void RoiStrategy::GetLCUsInRoiRegion(
         return;
     }
 
-    for (auto y = top; y < bottom; y++)
+    // Callers clip against different stream-in heights, keep the map tall enough for all of them
+    if (streamInWidth != m_rasterizer.GetWidth() || bottom > m_rasterizer.GetHeight())
     {
-        for (auto x = left; x < right; x++)
-        {
-            //Calculate X Y for the zig zag scan
-            uint32_t offset = 0, xyOffset = 0;
-            StreaminZigZagToLinearMap(streamInWidth, x, y, &offset, &xyOffset);
-
-            lcuVector.push_back(offset + xyOffset);
-        }
+        uint32_t height = (streamInWidth == m_rasterizer.GetWidth()) ? m_rasterizer.GetHeight() : 0;
+        m_rasterizer.Update(streamInWidth, MOS_MAX(height, bottom), StreamInRasterizer::scanZigZag32x32In64x64);
     }
+
+    lcuVector.reserve(lcuVector.size() + m_rasterizer.GetBlockCount(left, top, right, bottom));
+    m_rasterizer.ForEachBlock(left, top, right, bottom, [&lcuVector](uint32_t lcu) {
+        lcuVector.push_back(lcu);
+    });
 }
 
 /*******************************************************
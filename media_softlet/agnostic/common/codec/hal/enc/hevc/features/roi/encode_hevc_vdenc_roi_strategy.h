@@ -32,6 +32,7 @@
 #include "encode_hevc_brc.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
 #include "encode_hevc_vdenc_const_settings.h"
+#include "encode_streamin_rasterizer.h"
 #include "mhw_vdbox_huc_itf.h"
 
 namespace encode
@@ -506,6 +507,8 @@ protected:
     bool     m_isTileModeEnabled  = false;
     uint32_t m_minCodingBlockSize = 0;
 
+    StreamInRasterizer m_rasterizer;        //!< Zig zag map of the stream-in buffer
+
     EncodeAllocator *m_allocator    = nullptr;
     RecycleResource *m_recycle      = nullptr;
     HevcBasicFeature *m_basicFeature = nullptr;
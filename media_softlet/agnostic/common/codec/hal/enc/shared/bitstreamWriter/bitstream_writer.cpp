@@ -24,7 +24,7 @@
 #include <assert.h>
 
 BitstreamWriter::BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
-    : m_bsStart(bs), m_bsEnd(bs + size), m_bs(bs), m_bitStart(bitOffset & 7), m_bitOffset(bitOffset & 7), m_codILow(0)  // cabac variables
+    : m_bsStart(bs), m_bsEnd(bs + size), m_bs(bs), m_bitStart(bitOffset & 7), m_codILow(0)  // cabac variables
       ,
       m_codIRange(510),
       m_bitsOutstanding(0),
@@ -32,15 +32,35 @@ BitstreamWriter::BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
       m_firstBitFlag(true)
 {
     assert(bitOffset < 8);
-    *m_bs &= 0xFF << (8 - m_bitOffset);
+    LoadStartBits(m_bitStart);
 }
 
 BitstreamWriter::~BitstreamWriter()
 {
 }
 
+void BitstreamWriter::LoadStartBits(mfxU8 bitOffset)
+{
+    // Keep the bits already present ahead of the start offset
+    m_acc     = bitOffset ? (*m_bs >> (8 - bitOffset)) : 0;
+    m_accBits = bitOffset;
+}
+
+void BitstreamWriter::Flush()
+{
+    mfxU32 bytes = (m_accBits + 7) >> 3;
+    mfxU64 bits  = m_acc << (bytes * 8 - m_accBits);
+
+    for (mfxU32 i = 0; i < bytes; i++)
+    {
+        m_bs[i] = (mfxU8)(bits >> ((bytes - 1 - i) * 8));
+    }
+}
+
 void BitstreamWriter::Reset(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
 {
+    Flush();
+
     if (bs)
     {
         m_bsStart           = bs;
@@ -54,104 +74,74 @@ void BitstreamWriter::Reset(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
         }
         */
         m_bs        = bs;
-        m_bitOffset = (bitOffset & 7);
         m_bitStart  = (bitOffset & 7);
     }
     else
     {
         m_bs        = m_bsStart;
-        m_bitOffset = m_bitStart;
     }
+    LoadStartBits(m_bitStart);
 }
 
 void BitstreamWriter::PutBitsBuffer(mfxU32 n, void *bb, mfxU32 o)
-{}
-
-void BitstreamWriter::PutBits(mfxU32 n, mfxU32 b)
 {
-    assert(n <= sizeof(b) * 8);
-    while (n > 24)
-    {
-        n -= 16;
-        PutBits(16, (b >> n));
-    }
-
-    b <<= (32 - n);
+    const mfxU8 *b    = (const mfxU8 *)bb + (o >> 3);
+    mfxU32       skip = o & 7;
 
-    if (!m_bitOffset)
+    if (skip && n)
     {
-        m_bs[0] = (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+        mfxU32 bits = (8 - skip < n) ? 8 - skip : n;
+        PutBits(bits, b[0] >> (8 - skip - bits));
+        b++;
+        n -= bits;
     }
-    else
-    {
-        b >>= m_bitOffset;
-        n += m_bitOffset;
 
-        m_bs[0] |= (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+    for (; n >= 32; n -= 32, b += 4)
+    {
+        PutBits(32, ((mfxU32)b[0] << 24) | ((mfxU32)b[1] << 16) | ((mfxU32)b[2] << 8) | b[3]);
     }
 
-    if (n > 16)
+    for (; n >= 8; n -= 8, b++)
     {
-        m_bs[2] = (mfxU8)(b >> 8);
-        m_bs[3] = (mfxU8)b;
+        PutBits(8, b[0]);
     }
 
-    m_bs += (n >> 3);
-    m_bitOffset = (n & 7);
-}
-
-void BitstreamWriter::PutBit(mfxU32 b)
-{
-    switch (m_bitOffset)
+    if (n)
     {
-    case 0:
-        m_bs[0]     = (mfxU8)(b << 7);
-        m_bitOffset = 1;
-        break;
-    case 7:
-        m_bs[0] |= (mfxU8)(b & 1);
-        m_bs++;
-        m_bitOffset = 0;
-        break;
-    default:
-        if (b & 1)
-            m_bs[0] |= (mfxU8)(1 << (7 - m_bitOffset));
-        m_bitOffset++;
-        break;
+        PutBits(n, b[0] >> (8 - n));
     }
 }
 
 void BitstreamWriter::PutGolomb(mfxU32 b)
 {
-    if (!b)
+    // n bit code number preceded by n - 1 zero bits
+    mfxU64 codeNum = (mfxU64)b + 1;
+    mfxU32 n       = 64 - __builtin_clzll(codeNum);
+
+    if (n <= 16)
     {
-        PutBit(1);
+        PutBits(2 * n - 1, (mfxU32)codeNum);
     }
     else
     {
-        mfxU32 n = 1;
-
-        b++;
-
-        while (b >> n)
-            n++;
-
         PutBits(n - 1, 0);
-        PutBits(n, b);
+        if (n > 32)
+        {
+            PutBits(n - 32, (mfxU32)(codeNum >> 32));
+            n = 32;
+        }
+        PutBits(n, (mfxU32)codeNum);
     }
 }
 
 void BitstreamWriter::PutTrailingBits(bool bCheckAligened)
 {
-    if ((!bCheckAligened) || m_bitOffset)
+    if ((!bCheckAligened) || (m_accBits & 7))
         PutBit(1);
 
-    if (m_bitOffset)
+    if (m_accBits & 7)
     {
-        *(++m_bs)   = 0;
-        m_bitOffset = 0;
+        PutBits(8 - (m_accBits & 7), 0);
     }
 }
 
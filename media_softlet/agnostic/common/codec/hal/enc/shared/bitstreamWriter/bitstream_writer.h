@@ -28,6 +28,7 @@
 #define __BITSTREAM_WRITER_H__
 
 #include "media_class_trace.h"
+#include <assert.h>
 #include <map>
 
 typedef unsigned char  mfxU8;
@@ -40,7 +41,7 @@ typedef unsigned long mfxUL32;
 typedef long          mfxL32;
 typedef float  mfxF32;
 typedef double mfxF64;
-//typedef __UINT64            mfxU64;
+typedef unsigned long long mfxU64;
 //typedef __INT64             mfxI64;
 typedef void * mfxHDL;
 typedef mfxHDL mfxMemId;
@@ -134,16 +135,34 @@ public:
 MEDIA_CLASS_DEFINE_END(IBsWriter)
 };
 
-class BitstreamWriter
+//!
+//! \brief   Bit writer keeping pending bits in a 64 bit accumulator
+//! \details Whole 32 bit words are stored big endian as soon as they are complete,
+//!          the trailing partial word only reaches memory on Flush() or Reset().
+//!          The class is final so calls through BitstreamWriter references are
+//!          resolved statically and the hot Put* functions can be inlined.
+//!
+class BitstreamWriter final
     : public IBsWriter
 {
 public:
     BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset = 0);
     ~BitstreamWriter();
 
-    virtual void PutBits(mfxU32 n, mfxU32 b) override;
+    virtual void PutBits(mfxU32 n, mfxU32 b) override
+    {
+        assert(n <= sizeof(b) * 8);
+        // m_accBits < 32 between calls, so up to 32 more bits always fit
+        m_acc = (m_acc << n) | (b & (mfxU32)((1ull << n) - 1));
+        m_accBits += n;
+        if (m_accBits >= 32)
+        {
+            m_accBits -= 32;
+            StoreWord((mfxU32)(m_acc >> m_accBits));
+        }
+    }
     void         PutBitsBuffer(mfxU32 n, void *b, mfxU32 offset = 0);
-    virtual void PutBit(mfxU32 b) override;
+    virtual void PutBit(mfxU32 b) override { PutBits(1, b & 1); }
     void         PutGolomb(mfxU32 b);
     void         PutTrailingBits(bool bCheckAligned = false);
 
@@ -152,11 +171,18 @@ public:
 
     mfxU32 GetOffset()
     {
-        return mfxU32(m_bs - m_bsStart) * 8 + m_bitOffset - m_bitStart;
+        return mfxU32(m_bs - m_bsStart) * 8 + m_accBits - m_bitStart;
     }
     mfxU8 *GetStart() { return m_bsStart; }
     mfxU8 *GetEnd() { return m_bsEnd; }
 
+    //!
+    //! \brief   Store the pending bits, the last partial byte is zero padded
+    //! \details Must be called before the written data is read from memory.
+    //!          Writing may continue afterwards.
+    //!
+    void Flush();
+
     void Reset(mfxU8 *bs = 0, mfxU32 size = 0, mfxU8 bitOffset = 0);
     void cabacInit();
     void EncodeBin(mfxU8 &ctx, mfxU8 binVal);
@@ -176,11 +202,22 @@ public:
 
 private:
     void   RenormE();
+    void   LoadStartBits(mfxU8 bitOffset);
+    void   StoreWord(mfxU32 word)
+    {
+        m_bs[0] = (mfxU8)(word >> 24);
+        m_bs[1] = (mfxU8)(word >> 16);
+        m_bs[2] = (mfxU8)(word >> 8);
+        m_bs[3] = (mfxU8)word;
+        m_bs += 4;
+    }
+
     mfxU8 *m_bsStart;
     mfxU8 *m_bsEnd;
-    mfxU8 *m_bs;
+    mfxU8 *m_bs;         //!< Position of the first bit held in m_acc
     mfxU8  m_bitStart;
-    mfxU8  m_bitOffset;
+    mfxU64 m_acc     = 0; //!< Pending bits, right aligned
+    mfxU32 m_accBits = 0; //!< Number of valid bits in m_acc, always < 32 between calls
 
     mfxU32                    m_codILow;
     mfxU32                    m_codIRange;
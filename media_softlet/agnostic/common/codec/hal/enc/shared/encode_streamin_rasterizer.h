@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_streamin_rasterizer.h
+//! \brief    Maps frame positions of stream-in blocks to stream-in buffer indices
+//! \details  The map is built once per resolution and scan order, ROI and
+//!           segmentation setup then walk rectangles row by row with one table
+//!           lookup per block instead of recomputing the scan order.
+//!
+#ifndef __ENCODE_STREAMIN_RASTERIZER_H__
+#define __ENCODE_STREAMIN_RASTERIZER_H__
+
+#include <stdint.h>
+#include <vector>
+#include "media_class_trace.h"
+
+namespace encode
+{
+class StreamInRasterizer
+{
+public:
+    enum Scan
+    {
+        scanRaster = 0,          //!< Blocks in raster order, e.g. AVC 16x16 macroblocks
+        scanZigZag32x32In64x64,  //!< 32x32 blocks in zig zag order within each 64x64 LCU, HEVC VDEnc
+        scanCustom,              //!< Built from a caller provided mapping
+    };
+
+    //!
+    //! \brief    Build the map for a built-in scan order
+    //! \details  Nothing is done if size and scan order are unchanged.
+    //! \param    [in] width
+    //!           Frame width in stream-in blocks, must be even for scanZigZag32x32In64x64
+    //! \param    [in] height
+    //!           Frame height in stream-in blocks
+    //! \param    [in] scan
+    //!           Scan order of the stream-in buffer
+    //!
+    void Update(uint32_t width, uint32_t height, Scan scan)
+    {
+        if (width == m_width && height == m_height && scan == m_scan && scan != scanCustom)
+        {
+            return;
+        }
+
+        if (scan == scanZigZag32x32In64x64)
+        {
+            Update(width, height, [width](uint32_t x, uint32_t y) {
+                // 2x2 blocks of an LCU are consecutive, LCU rows are 2 block rows
+                return width * (y & ~1u) + 2 * (x & ~1u) + 2 * (y & 1u) + (x & 1u);
+            });
+        }
+        else
+        {
+            Update(width, height, [width](uint32_t x, uint32_t y) { return y * width + x; });
+        }
+        m_scan = scan;
+    }
+
+    //!
+    //! \brief    Build the map from a caller provided mapping
+    //! \param    [in] width
+    //!           Frame width in stream-in blocks
+    //! \param    [in] height
+    //!           Frame height in stream-in blocks
+    //! \param    [in] blockIndex
+    //!           Callable taking (x, y) and returning the stream-in index of that block
+    //!
+    template <typename Func>
+    void Update(uint32_t width, uint32_t height, Func &&blockIndex)
+    {
+        m_map.resize((size_t)width * height);
+        m_width  = width;
+        m_height = height;
+        m_scan   = scanCustom;
+
+        uint32_t *entry = m_map.data();
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                *entry++ = blockIndex(x, y);
+            }
+        }
+    }
+
+    //!
+    //! \brief    Stream-in indices of one block row
+    //!
+    const uint32_t *GetRow(uint32_t y) const
+    {
+        return m_map.data() + (size_t)y * m_width;
+    }
+
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+
+    //!
+    //! \brief    Visit every block of a rectangle
+    //! \details  The rectangle is clipped to the frame, rows are visited top down
+    //!           and blocks left to right.
+    //! \param    [in] left, top
+    //!           Top left block, inclusive
+    //! \param    [in] right, bottom
+    //!           Bottom right block, exclusive
+    //! \param    [in] fn
+    //!           Callable taking the stream-in index of the block
+    //!
+    template <typename Func>
+    void ForEachBlock(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom, Func &&fn) const
+    {
+        right  = (right < m_width) ? right : m_width;
+        bottom = (bottom < m_height) ? bottom : m_height;
+
+        for (uint32_t y = top; y < bottom; y++)
+        {
+            const uint32_t *row = GetRow(y);
+            for (uint32_t x = left; x < right; x++)
+            {
+                fn(row[x]);
+            }
+        }
+    }
+
+    //!
+    //! \brief    Number of blocks ForEachBlock visits for a rectangle
+    //!
+    uint32_t GetBlockCount(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) const
+    {
+        right  = (right < m_width) ? right : m_width;
+        bottom = (bottom < m_height) ? bottom : m_height;
+        return (left < right && top < bottom) ? (right - left) * (bottom - top) : 0;
+    }
+
+private:
+    std::vector<uint32_t> m_map;
+    uint32_t              m_width  = 0;
+    uint32_t              m_height = 0;
+    Scan                  m_scan   = scanCustom;
+
+MEDIA_CLASS_DEFINE_END(encode__StreamInRasterizer)
+};
+}  // namespace encode
+
+#endif  // __ENCODE_STREAMIN_RASTERIZER_H__
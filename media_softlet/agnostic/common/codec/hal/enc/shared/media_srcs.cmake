@@ -32,6 +32,7 @@ if(${Common_Encode_Supported} STREQUAL "yes")
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
     ${CMAKE_CURRENT_LIST_DIR}/encode_utils.h
+    ${CMAKE_CURRENT_LIST_DIR}/encode_streamin_rasterizer.h
 )
 
 set(SOFTLET_ENCODE_COMMON_HEADERS_
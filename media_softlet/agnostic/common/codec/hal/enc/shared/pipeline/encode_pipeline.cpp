@@ -34,6 +34,7 @@
 #include "encode_status_report_defs.h"
 #include "encode_status_report.h"
 #include "mos_solo_generic.h"
+#include "mos_backoff_wait.h"
 
 namespace encode {
 EncodePipeline::EncodePipeline(
@@ -275,25 +276,26 @@ MOS_STATUS EncodePipeline::WaitForBatchBufferComplete()
 {
     ENCODE_CHK_NULL_RETURN(m_statusReport);
 
-    const uint32_t completedFrames = m_statusReport->GetCompletedCount();
+    uint32_t completedFrames = m_statusReport->GetCompletedCount();
 
     if (!m_hwInterface->IsSimActive() &&
         m_recycledBufStatusNum[m_currRecycledBufIdx] > completedFrames)
     {
-        uint32_t waitMs;
+        PERF_UTILITY_AUTO(__FUNCTION__, PERF_ENCODE, PERF_LEVEL_HAL);
 
-        // Wait for Batch Buffer complete event OR timeout
-        for (waitMs = MHW_TIMEOUT_MS_DEFAULT; waitMs > 0; waitMs -= MHW_EVENT_TIMEOUT_MS)
-        {
-            if (m_recycledBufStatusNum[m_currRecycledBufIdx] <= completedFrames)
-            {
-                break;
-            }
+        uint32_t waitedUs = 0;
 
-            MosUtilities::MosSleep(MHW_EVENT_TIMEOUT_MS);
-        }
+        // Wait for the frame which last used the recycled buffer OR timeout
+        MosBackoffWait::Wait(
+            [&]() {
+                completedFrames = m_statusReport->GetCompletedCount();
+                return m_recycledBufStatusNum[m_currRecycledBufIdx] <= completedFrames;
+            },
+            MHW_TIMEOUT_MS_DEFAULT * 1000,
+            MosBackoffWait::m_defaultMaxSleepUs,
+            &waitedUs);
 
-        ENCODE_VERBOSEMESSAGE("Waited for %d ms", (MHW_TIMEOUT_MS_DEFAULT - waitMs));
+        ENCODE_VERBOSEMESSAGE("Waited for %d us", waitedUs);
 
         if (m_recycledBufStatusNum[m_currRecycledBufIdx] > completedFrames)
         {
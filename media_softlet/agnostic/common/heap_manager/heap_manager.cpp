@@ -25,6 +25,7 @@
 //!
 
 #include "heap_manager.h"
+#include "mos_backoff_wait.h"
 
 HeapManager::~HeapManager()
 {
@@ -216,17 +217,24 @@ MOS_STATUS HeapManager::Wait()
 {
     HEAP_FUNCTION_ENTER_VERBOSE;
 
-    bool blocksUpdated = false;
+    PERF_UTILITY_AUTO(__FUNCTION__, PERF_MOS, PERF_LEVEL_HAL);
 
-    for (auto waitMs = m_waitTimeout; waitMs > 0; waitMs -= m_waitIncrement)
-    {
-        MosUtilities::MosSleep(m_waitIncrement);
-        HEAP_CHK_STATUS(m_blockManager.RefreshBlockStates(blocksUpdated));
-        if (blocksUpdated)
-        {
-            break;
-        }
-    }
+    bool       blocksUpdated = false;
+    MOS_STATUS eStatus       = MOS_STATUS_SUCCESS;
+    uint32_t   waitedUs      = 0;
+
+    // Wake up as soon as the frame tracker frees a block
+    MosBackoffWait::Wait(
+        [&]() {
+            eStatus = m_blockManager.RefreshBlockStates(blocksUpdated);
+            return eStatus != MOS_STATUS_SUCCESS || blocksUpdated;
+        },
+        m_waitTimeout * 1000,
+        m_waitMaxIntervalUs,
+        &waitedUs);
+    HEAP_CHK_STATUS(eStatus);
+
+    HEAP_VERBOSEMESSAGE("Waited for %d us", waitedUs);
 
     return (blocksUpdated) ? MOS_STATUS_SUCCESS : MOS_STATUS_CLIENT_AR_NO_SPACE;
 }
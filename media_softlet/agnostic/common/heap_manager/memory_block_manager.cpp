@@ -174,10 +174,17 @@ MOS_STATUS MemoryBlockManager::RefreshBlockStates(bool &blocksUpdated)
         currTrackerId = *m_trackerData;
     }
 
+    // Without a producer the submitted list is ordered by tracker ID, so the
+    // walk may stop at the first block which is still in use
     auto block = m_sortedBlockList[MemoryBlockInternal::State::submitted];
     MemoryBlockInternal *nextSubmitted = nullptr;
     while (block != nullptr)
     {
+        if (!m_useProducer && block->GetTrackerId() > currTrackerId)
+        {
+            break;
+        }
+
         nextSubmitted = block->m_stateNext;
         FrameTrackerToken *trackerToken = block->GetTrackerToken();
         if ( (!m_useProducer && block->GetTrackerId() <= currTrackerId)
@@ -648,69 +655,61 @@ MOS_STATUS MemoryBlockManager::AddBlockToSortedList(
     {
         case MemoryBlockInternal::State::free:
         {
-            bool inserted = false;
+            // The free list is ordered by descending size, each size class is a
+            // contiguous run starting at m_freeBins[bin], so only blocks of the
+            // same class are visited to find the insertion point.
+            uint32_t bin = GetFreeBin(block->GetSize());
             MemoryBlockInternal *prev = nullptr;
-            while (curr != nullptr)
-            {
-                if (curr->GetSize() <= block->GetSize())
-                {
-                    if (prev)
-                    {
-                        prev->m_stateNext = block;
-                    }
-                    else
-                    {
-                        m_sortedBlockList[state] = block;
-                    }
-                    curr->m_statePrev = block;
-                    block->m_statePrev = prev;
-                    block->m_stateNext = curr;
-                    inserted = true;
-                    break;
-                }
-                prev = curr;
-                curr = curr->m_stateNext;
-            }
-            if (!inserted)
+            if (m_freeBins[bin] != nullptr)
             {
-                if (prev == nullptr)
+                curr = m_freeBins[bin];
+                prev = curr->m_statePrev;
+                while (curr != nullptr && curr->GetSize() > block->GetSize())
                 {
-                    block->m_stateNext = m_sortedBlockList[state];
-                    m_sortedBlockList[state] = block;
+                    prev = curr;
+                    curr = curr->m_stateNext;
                 }
-                else
+                if (curr == m_freeBins[bin])
                 {
-                    block->m_statePrev = prev;
-                    prev->m_stateNext = block;
+                    m_freeBins[bin] = block;
                 }
             }
-            block->m_stateListType = state;
-            m_sortedBlockListNumEntries[state]++;
+            else
+            {
+                int32_t lowerBin = FindFreeBinBelow(bin);
+                curr = (lowerBin >= 0) ? m_freeBins[lowerBin] : nullptr;
+                prev = curr ? curr->m_statePrev : m_sortedBlockListTail[state];
+                m_freeBins[bin] = block;
+                m_freeBinMask[bin / 64] |= 1ull << (bin % 64);
+            }
+
+            InsertBlockToSortedList(block, state, prev, curr);
             m_sortedBlockListSizes[state] += block->GetSize();
             break;
         }
-        case MemoryBlockInternal::State::allocated:
         case MemoryBlockInternal::State::submitted:
-        case MemoryBlockInternal::State::deleted:
-            block->m_stateNext = curr;
-            if (curr)
+        {
+            // Keep the list in tracker ID order; submissions normally arrive in
+            // order so this appends at the tail. Producer based blocks have no
+            // tracker ID and are kept in submission order.
+            MemoryBlockInternal *prev = m_sortedBlockListTail[state];
+            while (prev != nullptr && prev->GetTrackerId() > block->GetTrackerId())
             {
-                curr->m_statePrev = block;
+                prev = prev->m_statePrev;
             }
-            m_sortedBlockList[state] = block;
-            block->m_stateListType = state;
-            m_sortedBlockListNumEntries[state]++;
+            curr = prev ? prev->m_stateNext : m_sortedBlockList[state];
+
+            InsertBlockToSortedList(block, state, prev, curr);
+            m_sortedBlockListSizes[state] += block->GetSize();
+            break;
+        }
+        case MemoryBlockInternal::State::allocated:
+        case MemoryBlockInternal::State::deleted:
+            InsertBlockToSortedList(block, state, nullptr, curr);
             m_sortedBlockListSizes[state] += block->GetSize();
             break;
         case MemoryBlockInternal::State::pool: 
-            block->m_stateNext = curr;
-            if (curr)
-            {
-                curr->m_statePrev = block;
-            }
-            block->m_stateListType = state;
-            m_sortedBlockList[state] = block;
-            m_sortedBlockListNumEntries[state]++;
+            InsertBlockToSortedList(block, state, nullptr, curr);
             break;
         default:
             HEAP_ASSERTMESSAGE("This state type is unsupported");
@@ -735,6 +734,24 @@ MOS_STATUS MemoryBlockManager::RemoveBlockFromSortedList(
         case MemoryBlockInternal::State::submitted:
         case MemoryBlockInternal::State::deleted:
         {
+            if (state == MemoryBlockInternal::State::free)
+            {
+                uint32_t bin = GetFreeBin(block->GetSize());
+                if (m_freeBins[bin] == block)
+                {
+                    auto next = block->m_stateNext;
+                    if (next != nullptr && GetFreeBin(next->GetSize()) == bin)
+                    {
+                        m_freeBins[bin] = next;
+                    }
+                    else
+                    {
+                        m_freeBins[bin] = nullptr;
+                        m_freeBinMask[bin / 64] &= ~(1ull << (bin % 64));
+                    }
+                }
+            }
+
             if (block->m_statePrev)
             {
                 block->m_statePrev->m_stateNext = block->m_stateNext;
@@ -748,6 +765,10 @@ MOS_STATUS MemoryBlockManager::RemoveBlockFromSortedList(
             {
                 block->m_stateNext->m_statePrev = block->m_statePrev;
             }
+            else
+            {
+                m_sortedBlockListTail[state] = block->m_statePrev;
+            }
             block->m_statePrev = block->m_stateNext = nullptr;
             block->m_stateListType = MemoryBlockInternal::State::stateCount;
             m_sortedBlockListNumEntries[state]--;
@@ -763,6 +784,65 @@ MOS_STATUS MemoryBlockManager::RemoveBlockFromSortedList(
     return MOS_STATUS_SUCCESS;
 }
 
+void MemoryBlockManager::InsertBlockToSortedList(
+    MemoryBlockInternal *block,
+    MemoryBlockInternal::State state,
+    MemoryBlockInternal *prev,
+    MemoryBlockInternal *next)
+{
+    block->m_statePrev = prev;
+    block->m_stateNext = next;
+    if (prev)
+    {
+        prev->m_stateNext = block;
+    }
+    else
+    {
+        m_sortedBlockList[state] = block;
+    }
+    if (next)
+    {
+        next->m_statePrev = block;
+    }
+    else
+    {
+        m_sortedBlockListTail[state] = block;
+    }
+    block->m_stateListType = state;
+    m_sortedBlockListNumEntries[state]++;
+}
+
+uint32_t MemoryBlockManager::GetFreeBin(uint32_t size)
+{
+    if (size < (1 << m_freeBinSubdivisionBits))
+    {
+        return size;
+    }
+
+    // Log2 class split linearly into 2^m_freeBinSubdivisionBits bins
+    uint32_t log2Size = 31 - __builtin_clz(size);
+    uint32_t subBin   = (size >> (log2Size - m_freeBinSubdivisionBits)) & ((1 << m_freeBinSubdivisionBits) - 1);
+    return ((log2Size - m_freeBinSubdivisionBits + 1) << m_freeBinSubdivisionBits) + subBin;
+}
+
+int32_t MemoryBlockManager::FindFreeBinBelow(uint32_t bin)
+{
+    for (int32_t word = bin / 64; word >= 0; word--)
+    {
+        uint64_t mask = m_freeBinMask[word];
+        if (word == (int32_t)(bin / 64))
+        {
+            mask &= (1ull << (bin % 64)) - 1;
+        }
+        if (mask)
+        {
+            return word * 64 + 63 - __builtin_clzll(mask);
+        }
+    }
+
+    return -1;
+}
+
 MemoryBlockInternal *MemoryBlockManager::GetBlockFromPool()
 {
     HEAP_FUNCTION_ENTER_VERBOSE;
@@ -780,6 +860,10 @@ MemoryBlockInternal *MemoryBlockManager::GetBlockFromPool()
         {
             block->m_stateNext->m_statePrev = nullptr;
         }
+        else
+        {
+            m_sortedBlockListTail[MemoryBlockInternal::State::pool] = nullptr;
+        }
         // refresh beginning of list
         m_sortedBlockList[MemoryBlockInternal::State::pool] = block->m_stateNext;
         block->m_statePrev = block->m_stateNext = nullptr;
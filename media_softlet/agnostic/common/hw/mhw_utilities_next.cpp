@@ -25,6 +25,7 @@
 //!
 
 #include <math.h>
+#include <mutex>
 #include "mhw_utilities_next.h"
 #include "mhw_state_heap.h"
 #include "mos_interface.h"
@@ -37,6 +38,119 @@
 
 #define MHW_NS_PER_TICK_RENDER_ENGINE 80  // 80 nano seconds per tick in render engine
 
+#define MHW_POLYPHASE_CACHE_ENTRIES     32  // Tables kept by the polyphase table cache
+#define MHW_POLYPHASE_CACHE_TABLE_SIZE  (NUM_POLYPHASE_Y_ENTRIES * NUM_POLYPHASE_TABLES)
+
+//!
+//! \brief    Polyphase table type, part of the polyphase table cache key
+//!
+typedef enum _MHW_POLYPHASE_TABLE_TYPE
+{
+    MHW_POLYPHASE_TABLE_Y = 1,
+    MHW_POLYPHASE_TABLE_UV,
+    MHW_POLYPHASE_TABLE_UV_OFFSET
+} MHW_POLYPHASE_TABLE_TYPE;
+
+//!
+//! \brief    Polyphase table cache key, holds all inputs the table depends on
+//!
+typedef struct _MHW_POLYPHASE_CACHE_KEY
+{
+    uint32_t    type;
+    float       fScaleFactor;
+    float       fLanczosT;
+    float       fHPStrength;
+    uint32_t    dwPlane;
+    int32_t     srcFmt;
+    uint32_t    bUse8x8Filter;
+    uint32_t    dwHwPhase;
+    int32_t     iUvPhaseOffset;
+} MHW_POLYPHASE_CACHE_KEY;
+
+typedef struct _MHW_POLYPHASE_CACHE_ENTRY
+{
+    MHW_POLYPHASE_CACHE_KEY key;
+    uint64_t                lastUse;    // 0 if the entry is empty
+    uint32_t                dwSize;     // Number of coefficients
+    int32_t                 iCoefs[MHW_POLYPHASE_CACHE_TABLE_SIZE];
+} MHW_POLYPHASE_CACHE_ENTRY;
+
+// Scaling factors mostly repeat from frame to frame, so the tables are computed once per
+// process and shared by all VP and SFC instances.
+static MHW_POLYPHASE_CACHE_ENTRY g_polyphaseCache[MHW_POLYPHASE_CACHE_ENTRIES];
+static uint64_t                  g_polyphaseCacheUseCount = 0;
+static std::mutex                g_polyphaseCacheMutex;
+
+//!
+//! \brief    Look up a polyphase table in the cache
+//! \param    const MHW_POLYPHASE_CACHE_KEY &key
+//!           [in] Inputs of the table, zero initialized before being filled
+//! \param    int32_t *piCoefs
+//!           [out] Table to fill on a hit
+//! \param    uint32_t dwSize
+//!           [in] Number of coefficients in the table
+//! \return   bool
+//!           true if the table was found
+//!
+static bool Mhw_PolyphaseCacheLookup(
+    const MHW_POLYPHASE_CACHE_KEY &key,
+    int32_t                       *piCoefs,
+    uint32_t                      dwSize)
+{
+    std::lock_guard<std::mutex> lock(g_polyphaseCacheMutex);
+
+    for (uint32_t i = 0; i < MHW_POLYPHASE_CACHE_ENTRIES; i++)
+    {
+        MHW_POLYPHASE_CACHE_ENTRY &entry = g_polyphaseCache[i];
+        if (entry.lastUse != 0 &&
+            entry.dwSize == dwSize &&
+            memcmp(&entry.key, &key, sizeof(key)) == 0)
+        {
+            entry.lastUse = ++g_polyphaseCacheUseCount;
+            MOS_SecureMemcpy(piCoefs, dwSize * sizeof(int32_t), entry.iCoefs, dwSize * sizeof(int32_t));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//!
+//! \brief    Add a polyphase table to the cache, evicting the least recently used one
+//! \param    const MHW_POLYPHASE_CACHE_KEY &key
+//!           [in] Inputs of the table
+//! \param    const int32_t *piCoefs
+//!           [in] Table to add
+//! \param    uint32_t dwSize
+//!           [in] Number of coefficients in the table
+//!
+static void Mhw_PolyphaseCacheInsert(
+    const MHW_POLYPHASE_CACHE_KEY &key,
+    const int32_t                 *piCoefs,
+    uint32_t                      dwSize)
+{
+    if (dwSize > MHW_POLYPHASE_CACHE_TABLE_SIZE)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_polyphaseCacheMutex);
+
+    MHW_POLYPHASE_CACHE_ENTRY *victim = &g_polyphaseCache[0];
+    for (uint32_t i = 1; i < MHW_POLYPHASE_CACHE_ENTRIES && victim->lastUse != 0; i++)
+    {
+        if (g_polyphaseCache[i].lastUse < victim->lastUse)
+        {
+            victim = &g_polyphaseCache[i];
+        }
+    }
+
+    victim->key     = key;
+    victim->lastUse = ++g_polyphaseCacheUseCount;
+    victim->dwSize  = dwSize;
+    MOS_SecureMemcpy(victim->iCoefs, sizeof(victim->iCoefs), piCoefs, dwSize * sizeof(int32_t));
+}
+
 //!
 //! \brief    Set mocs index
 //! \details  Set mocs index
@@ -665,6 +779,7 @@ MOS_STATUS Mhw_CalcPolyphaseTablesY(
     float                   fBase, fPos, fSumCoefs;
     int32_t                 iCenterPixel;
     int32_t                 iSumQuantCoefs;
+    MHW_POLYPHASE_CACHE_KEY key;
 
     MHW_FUNCTION_ENTER;
 
@@ -680,6 +795,21 @@ MOS_STATUS Mhw_CalcPolyphaseTablesY(
         dwNumEntries = NUM_POLYPHASE_UV_ENTRIES;
     }
 
+    // fLanczosT is derived from the format and plane below, so it is not part of the key
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type          = MHW_POLYPHASE_TABLE_Y;
+    key.fScaleFactor  = fScaleFactor;
+    key.fHPStrength   = fHPStrength;
+    key.dwPlane       = dwPlane;
+    key.srcFmt        = srcFmt;
+    key.bUse8x8Filter = bUse8x8Filter;
+    key.dwHwPhase     = dwHwPhase;
+
+    if (Mhw_PolyphaseCacheLookup(key, iCoefs, dwHwPhase * dwNumEntries))
+    {
+        return eStatus;
+    }
+
     MOS_ZeroMemory(fPhaseCoefs    , sizeof(fPhaseCoefs));
     MOS_ZeroMemory(fPhaseCoefsCopy, sizeof(fPhaseCoefsCopy));
 
@@ -777,6 +907,8 @@ MOS_STATUS Mhw_CalcPolyphaseTablesY(
         }
     }
 
+    Mhw_PolyphaseCacheInsert(key, iCoefs, dwHwPhase * dwNumEntries);
+
     return eStatus;
 }
 
@@ -803,12 +935,25 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUV(
     int32_t     minCoef[MHW_SCALER_UV_WIN_SIZE];
     int32_t     maxCoef[MHW_SCALER_UV_WIN_SIZE];
     int32_t     i, j;
+    int32_t     *piTable;
+    MHW_POLYPHASE_CACHE_KEY key;
     MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
 
     MHW_FUNCTION_ENTER;
 
     MHW_CHK_NULL_RETURN(piCoefs);
 
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type         = MHW_POLYPHASE_TABLE_UV;
+    key.fScaleFactor = fInverseScaleFactor;
+    key.fLanczosT    = fLanczosT;
+
+    if (Mhw_PolyphaseCacheLookup(key, piCoefs, MHW_SCALER_UV_WIN_SIZE * MHW_TABLE_PHASE_COUNT))
+    {
+        return eStatus;
+    }
+
+    piTable         = piCoefs;
     phaseCount      = MHW_TABLE_PHASE_COUNT;
     centerPixel     = (MHW_SCALER_UV_WIN_SIZE / 2) - 1;
     startOffset     = (double)(-centerPixel);
@@ -865,6 +1010,8 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUV(
         }
     }
 
+    Mhw_PolyphaseCacheInsert(key, piTable, MHW_SCALER_UV_WIN_SIZE * phaseCount);
+
     return eStatus;
 }
 
@@ -896,12 +1043,26 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUVOffset(
     int32_t     maxCoef[MHW_SCALER_UV_WIN_SIZE];
     int32_t     i, j;
     int32_t     adjusted_phase;
+    int32_t     *piTable;
+    MHW_POLYPHASE_CACHE_KEY key;
     MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
 
     MHW_FUNCTION_ENTER;
 
     MHW_CHK_NULL_RETURN(piCoefs);
 
+    MOS_ZeroMemory(&key, sizeof(key));
+    key.type           = MHW_POLYPHASE_TABLE_UV_OFFSET;
+    key.fScaleFactor   = fInverseScaleFactor;
+    key.fLanczosT      = fLanczosT;
+    key.iUvPhaseOffset = iUvPhaseOffset;
+
+    if (Mhw_PolyphaseCacheLookup(key, piCoefs, MHW_SCALER_UV_WIN_SIZE * MHW_TABLE_PHASE_COUNT))
+    {
+        return eStatus;
+    }
+
+    piTable    = piCoefs;
     phaseCount = MHW_TABLE_PHASE_COUNT;
     centerPixel = (MHW_SCALER_UV_WIN_SIZE / 2) - 1;
     startOffset = (double)(-centerPixel +
@@ -960,6 +1121,8 @@ MOS_STATUS Mhw_CalcPolyphaseTablesUVOffset(
         }
     }
 
+    Mhw_PolyphaseCacheInsert(key, piTable, MHW_SCALER_UV_WIN_SIZE * phaseCount);
+
     return eStatus;
 }
 
@@ -26,6 +26,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_util_debug.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_utilities_next.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_swizzle.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontextmgr_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_cmdbufmgr_next.cpp
@@ -51,6 +52,8 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_interface.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_user_setting.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_utilities.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_swizzle.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_backoff_wait.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_solo_generic.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy_base.h
@@ -0,0 +1,120 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_backoff_wait.h
+//! \brief    Wait on a GPU progress condition with adaptive backoff
+//! \details  The condition is checked back to back first, then with a yield in
+//!           between, then with sleeps that double up to a cap. Short GPU waits
+//!           end within microseconds of completion while long ones cost little CPU.
+//!
+#ifndef __MOS_BACKOFF_WAIT_H__
+#define __MOS_BACKOFF_WAIT_H__
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "media_class_trace.h"
+
+class MosBackoffWait
+{
+public:
+    MosBackoffWait()  = delete;
+    ~MosBackoffWait() = delete;
+
+    //!
+    //! \brief    Wait until a condition is met or the timeout expires
+    //! \param    [in] done
+    //!           Callable returning true once the awaited tracker or resource is ready,
+    //!           it is checked before the first backoff step and after every step
+    //! \param    [in] timeoutUs
+    //!           Max time to wait in microseconds
+    //! \param    [in] maxSleepUs
+    //!           Upper bound of a single sleep in microseconds
+    //! \param    [out] waitedUs
+    //!           Time spent waiting in microseconds, optional
+    //! \return   bool
+    //!           true if the condition is met, false on timeout
+    //!
+    template <typename Condition>
+    static bool Wait(
+        Condition &&done,
+        uint32_t    timeoutUs,
+        uint32_t    maxSleepUs = m_defaultMaxSleepUs,
+        uint32_t   *waitedUs   = nullptr)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto     start    = Clock::now();
+        uint32_t elapsed  = 0;
+        uint32_t sleepUs  = m_minSleepUs;
+        uint32_t sleepCap = (maxSleepUs > m_minSleepUs) ? maxSleepUs : m_minSleepUs;
+        bool     met      = false;
+
+        for (uint32_t step = 0;; step++)
+        {
+            met = done();
+            elapsed = ElapsedUs(start);
+            if (met || elapsed >= timeoutUs)
+            {
+                break;
+            }
+
+            if (step < m_spinCount)
+            {
+                continue;
+            }
+            else if (step < m_spinCount + m_yieldCount)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(std::min(sleepUs, timeoutUs - elapsed)));
+                sleepUs = std::min(sleepUs * 2, sleepCap);
+            }
+        }
+
+        if (waitedUs)
+        {
+            *waitedUs = elapsed;
+        }
+
+        return met;
+    }
+
+    static const uint32_t m_spinCount         = 16;    //!< Checks without giving up the CPU
+    static const uint32_t m_yieldCount        = 16;    //!< Checks with a yield in between
+    static const uint32_t m_minSleepUs        = 10;    //!< First sleep interval
+    static const uint32_t m_defaultMaxSleepUs = 1000;  //!< Default cap of the sleep interval
+
+private:
+    static uint32_t ElapsedUs(std::chrono::steady_clock::time_point start)
+    {
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        return (us > (int64_t)UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+    }
+
+MEDIA_CLASS_DEFINE_END(MosBackoffWait)
+};
+
+#endif  // __MOS_BACKOFF_WAIT_H__
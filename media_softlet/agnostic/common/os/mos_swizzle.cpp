@@ -0,0 +1,477 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_swizzle.cpp
+//! \brief    Block based tile <-> linear swizzle engine
+//! \details  See MosUtilities::MosSwizzleOffset for the description of the
+//!           Row:Line:Col:X reinterpretation used here. Within one tile line
+//!           the X component is contiguous in both layouts, so every Col of
+//!           every surface row is moved as one block of (1 << lineBytes) bytes.
+//!
+
+#include <string.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mos_swizzle.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MOS_SWIZZLE_X86 1
+#else
+#define MOS_SWIZZLE_X86 0
+#endif
+
+namespace
+{
+    const int32_t tileYLineBits  = 5;  // Log2(TileY.Height = 32)
+    const int32_t tileYLineBytes = 4;  // Log2(TileY.PseudoWidth = 16)
+    const int32_t tileXLineBits  = 3;  // Log2(TileX.Height = 8)
+    const int32_t tileXLineBytes = 9;  // Log2(TileX.Width = 512)
+
+    //!
+    //! \brief    Offset of line 'line' of column 'col' in tile row 'row'
+    //!
+    inline size_t TileOffset(int32_t row, int32_t line, int32_t col, int32_t colsPerRow, int32_t lineBits, int32_t lineBytes)
+    {
+        return ((((size_t)row * colsPerRow + col) << lineBits) + line) << lineBytes;
+    }
+
+    inline void CopyBlock(const uint8_t *src, uint8_t *dst, size_t size, bool streamingStore)
+    {
+#if MOS_SWIZZLE_X86
+        if (streamingStore && ((uintptr_t)dst & 0xf) == 0 && (size & 0xf) == 0)
+        {
+            for (size_t i = 0; i < size; i += 16)
+            {
+                __m128i data = _mm_loadu_si128((const __m128i *)(src + i));
+                _mm_stream_si128((__m128i *)(dst + i), data);
+            }
+            return;
+        }
+#endif
+        memcpy(dst, src, size);
+    }
+
+    inline void StoreFence(bool streamingStore)
+    {
+#if MOS_SWIZZLE_X86
+        if (streamingStore)
+        {
+            _mm_sfence();
+        }
+#endif
+    }
+
+    //!
+    //! \brief    Worker threads started on first use and kept for later swizzles
+    //! \details  One swizzle at a time uses the workers, concurrent callers run
+    //!           all of their parts on the calling thread instead of waiting.
+    //!
+    class SwizzleWorkers
+    {
+    public:
+        static SwizzleWorkers &GetInstance()
+        {
+            static SwizzleWorkers workers(MosSwizzle::m_maxWorkerThreads - 1);
+            return workers;
+        }
+
+        ~SwizzleWorkers()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cond.notify_all();
+            for (auto &thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        //!
+        //! \brief    Run task(0) .. task(count - 1), part 0 on the calling thread
+        //!
+        void Run(uint32_t count, const std::function<void(uint32_t)> &task)
+        {
+            std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+            if (!runLock.owns_lock() || m_threads.empty())
+            {
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    task(i);
+                }
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task    = &task;
+                m_next    = 1;
+                m_count   = count;
+                m_pending = count - 1;
+            }
+            m_cond.notify_all();
+
+            task(0);
+
+            // Take parts no worker picked up yet, then wait for the running ones
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_next < m_count)
+            {
+                uint32_t index = m_next++;
+                lock.unlock();
+                task(index);
+                lock.lock();
+                m_pending--;
+            }
+            m_done.wait(lock, [this] { return m_pending == 0; });
+            m_task  = nullptr;
+            m_count = 0;
+        }
+
+    private:
+        explicit SwizzleWorkers(uint32_t numThreads)
+        {
+            // The calling thread runs one part itself
+            uint32_t cores = std::thread::hardware_concurrency();
+            if (cores != 0 && cores - 1 < numThreads)
+            {
+                numThreads = cores - 1;
+            }
+            for (uint32_t i = 0; i < numThreads; i++)
+            {
+                try
+                {
+                    m_threads.emplace_back(&SwizzleWorkers::WorkerThread, this);
+                }
+                catch (...)
+                {
+                    // Out of threads, the caller runs the parts left over
+                    break;
+                }
+            }
+        }
+
+        void WorkerThread()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true)
+            {
+                m_cond.wait(lock, [this] { return m_stop || m_next < m_count; });
+                if (m_stop)
+                {
+                    return;
+                }
+
+                uint32_t index = m_next++;
+                lock.unlock();
+                (*m_task)(index);
+                lock.lock();
+
+                if (--m_pending == 0)
+                {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+        std::vector<std::thread>             m_threads;
+        std::mutex                           m_runMutex;  //!< Held by the swizzle using the workers
+        std::mutex                           m_mutex;     //!< Guards the fields below
+        std::condition_variable              m_cond;
+        std::condition_variable              m_done;
+        const std::function<void(uint32_t)> *m_task    = nullptr;
+        uint32_t                             m_next    = 0;
+        uint32_t                             m_count   = 0;
+        uint32_t                             m_pending = 0;
+        bool                                 m_stop    = false;
+    };
+}
+
+bool MosSwizzle::IsSupported(MOS_TILE_TYPE srcTiling, MOS_TILE_TYPE dstTiling)
+{
+    auto isXY = [](MOS_TILE_TYPE tiling) {
+        return tiling == MOS_TILE_X || tiling == MOS_TILE_Y;
+    };
+
+    return (isXY(srcTiling) && dstTiling == MOS_TILE_LINEAR) ||
+           (srcTiling == MOS_TILE_LINEAR && isXY(dstTiling));
+}
+
+void MosSwizzle::CopyRowsGeneric(
+    const uint8_t       *src,
+    uint8_t             *dst,
+    const TileGeometry  &geometry,
+    bool                toLinear,
+    int32_t             rowStart,
+    int32_t             rowEnd,
+    int32_t             pitch,
+    bool                streamingStore)
+{
+    const int32_t lineBits   = geometry.lineBits;
+    const int32_t lineBytes  = geometry.lineBytes;
+    const int32_t lineSize   = 1 << lineBytes;
+    const int32_t colsPerRow = pitch >> lineBytes;
+    const int32_t tailSize   = pitch & (lineSize - 1);
+
+    for (int32_t y = rowStart; y < rowEnd; y++)
+    {
+        const int32_t row    = y >> lineBits;
+        const int32_t line   = y & ((1 << lineBits) - 1);
+        size_t        linear = (size_t)y * pitch;
+
+        for (int32_t col = 0; col < colsPerRow; col++, linear += lineSize)
+        {
+            size_t tiled = TileOffset(row, line, col, colsPerRow, lineBits, lineBytes);
+            if (toLinear)
+            {
+                CopyBlock(src + tiled, dst + linear, lineSize, streamingStore);
+            }
+            else
+            {
+                CopyBlock(src + linear, dst + tiled, lineSize, streamingStore);
+            }
+        }
+
+        // Partial column at the right edge when pitch is not tile aligned
+        if (tailSize)
+        {
+            size_t tiled = TileOffset(row, line, colsPerRow, colsPerRow, lineBits, lineBytes);
+            if (toLinear)
+            {
+                memcpy(dst + linear, src + tiled, tailSize);
+            }
+            else
+            {
+                memcpy(dst + tiled, src + linear, tailSize);
+            }
+        }
+    }
+
+    StoreFence(streamingStore);
+}
+
+#if MOS_SWIZZLE_X86 && (defined(__GNUC__) || defined(__clang__))
+__attribute__((target("avx2")))
+void MosSwizzle::CopyRowsAvx2(
+    const uint8_t       *src,
+    uint8_t             *dst,
+    const TileGeometry  &geometry,
+    bool                toLinear,
+    int32_t             rowStart,
+    int32_t             rowEnd,
+    int32_t             pitch,
+    bool                streamingStore)
+{
+    // Only the 16B wide Y-major columns gain from gathering; X-major lines are
+    // 512B blocks that the generic path already copies with memcpy.
+    if (geometry.lineBytes != tileYLineBytes)
+    {
+        CopyRowsGeneric(src, dst, geometry, toLinear, rowStart, rowEnd, pitch, streamingStore);
+        return;
+    }
+
+    const int32_t lineBits   = geometry.lineBits;
+    const int32_t colsPerRow = pitch >> tileYLineBytes;
+    const int32_t tailSize   = pitch & ((1 << tileYLineBytes) - 1);
+    const size_t  colStride  = (size_t)1 << (lineBits + tileYLineBytes);   // bytes per tile
+
+    for (int32_t y = rowStart; y < rowEnd; y++)
+    {
+        const int32_t row    = y >> lineBits;
+        const int32_t line   = y & ((1 << lineBits) - 1);
+        size_t        linear = (size_t)y * pitch;
+        size_t        tiled  = TileOffset(row, line, 0, colsPerRow, lineBits, tileYLineBytes);
+        int32_t       col    = 0;
+
+        // Four OWord columns make one 64B linear span per iteration
+        for (; col + 4 <= colsPerRow; col += 4, linear += 64, tiled += colStride * 4)
+        {
+            if (toLinear)
+            {
+                __m256i lo = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(src + tiled))),
+                    _mm_loadu_si128((const __m128i *)(src + tiled + colStride)), 1);
+                __m256i hi = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(src + tiled + colStride * 2))),
+                    _mm_loadu_si128((const __m128i *)(src + tiled + colStride * 3)), 1);
+                if (streamingStore && ((uintptr_t)(dst + linear) & 0x1f) == 0)
+                {
+                    _mm256_stream_si256((__m256i *)(dst + linear), lo);
+                    _mm256_stream_si256((__m256i *)(dst + linear + 32), hi);
+                }
+                else
+                {
+                    _mm256_storeu_si256((__m256i *)(dst + linear), lo);
+                    _mm256_storeu_si256((__m256i *)(dst + linear + 32), hi);
+                }
+            }
+            else
+            {
+                __m256i lo = _mm256_loadu_si256((const __m256i *)(src + linear));
+                __m256i hi = _mm256_loadu_si256((const __m256i *)(src + linear + 32));
+                __m128i oword[4] = {
+                    _mm256_castsi256_si128(lo),
+                    _mm256_extracti128_si256(lo, 1),
+                    _mm256_castsi256_si128(hi),
+                    _mm256_extracti128_si256(hi, 1)};
+                if (streamingStore && ((uintptr_t)(dst + tiled) & 0xf) == 0)
+                {
+                    for (int32_t i = 0; i < 4; i++)
+                    {
+                        _mm_stream_si128((__m128i *)(dst + tiled + colStride * i), oword[i]);
+                    }
+                }
+                else
+                {
+                    for (int32_t i = 0; i < 4; i++)
+                    {
+                        _mm_storeu_si128((__m128i *)(dst + tiled + colStride * i), oword[i]);
+                    }
+                }
+            }
+        }
+
+        for (; col < colsPerRow; col++, linear += 16, tiled += colStride)
+        {
+            if (toLinear)
+            {
+                CopyBlock(src + tiled, dst + linear, 16, streamingStore);
+            }
+            else
+            {
+                CopyBlock(src + linear, dst + tiled, 16, streamingStore);
+            }
+        }
+
+        if (tailSize)
+        {
+            if (toLinear)
+            {
+                memcpy(dst + linear, src + tiled, tailSize);
+            }
+            else
+            {
+                memcpy(dst + tiled, src + linear, tailSize);
+            }
+        }
+    }
+
+    StoreFence(streamingStore);
+}
+#else
+void MosSwizzle::CopyRowsAvx2(
+    const uint8_t       *src,
+    uint8_t             *dst,
+    const TileGeometry  &geometry,
+    bool                toLinear,
+    int32_t             rowStart,
+    int32_t             rowEnd,
+    int32_t             pitch,
+    bool                streamingStore)
+{
+    CopyRowsGeneric(src, dst, geometry, toLinear, rowStart, rowEnd, pitch, streamingStore);
+}
+#endif
+
+MosSwizzle::CopyRowsFunc MosSwizzle::SelectCopyRows()
+{
+#if MOS_SWIZZLE_X86 && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CopyRowsAvx2;
+    }
+#endif
+    return CopyRowsGeneric;
+}
+
+MOS_STATUS MosSwizzle::SwizzleData(
+    const uint8_t   *src,
+    uint8_t         *dst,
+    MOS_TILE_TYPE   srcTiling,
+    MOS_TILE_TYPE   dstTiling,
+    int32_t         height,
+    int32_t         pitch,
+    bool            streamingStore)
+{
+    if (src == nullptr || dst == nullptr || height < 0 || pitch < 0)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+    if (!IsSupported(srcTiling, dstTiling))
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    static const CopyRowsFunc copyRows = SelectCopyRows();
+
+    const bool          toLinear = (dstTiling == MOS_TILE_LINEAR);
+    const MOS_TILE_TYPE tiling   = toLinear ? srcTiling : dstTiling;
+    TileGeometry        geometry = {};
+    if (tiling == MOS_TILE_Y)
+    {
+        geometry.lineBits  = tileYLineBits;
+        geometry.lineBytes = tileYLineBytes;
+    }
+    else
+    {
+        geometry.lineBits  = tileXLineBits;
+        geometry.lineBytes = tileXLineBytes;
+    }
+
+    // With a non tile aligned pitch the partial column of one tile row aliases
+    // the first column of the next one, so only the serial row order is exact.
+    const int32_t tileRows   = (height + (1 << geometry.lineBits) - 1) >> geometry.lineBits;
+    uint32_t      numThreads = 1;
+    if ((pitch & ((1 << geometry.lineBytes) - 1)) == 0 &&
+        (uint64_t)height * pitch >= m_parallelThreshold)
+    {
+        numThreads = std::thread::hardware_concurrency();
+        numThreads = numThreads > m_maxWorkerThreads ? m_maxWorkerThreads : numThreads;
+        numThreads = numThreads > (uint32_t)tileRows ? (uint32_t)tileRows : numThreads;
+        numThreads = numThreads ? numThreads : 1;
+    }
+
+    if (numThreads == 1)
+    {
+        copyRows(src, dst, geometry, toLinear, 0, height, pitch, streamingStore);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Split by whole tile rows so every worker owns a disjoint range of tiles
+    int32_t tileRowsPerThread = (tileRows + numThreads - 1) / numThreads;
+    SwizzleWorkers::GetInstance().Run(numThreads, [&](uint32_t i) {
+        int32_t rowStart = (int32_t)(tileRowsPerThread * i) << geometry.lineBits;
+        int32_t rowEnd   = (int32_t)(tileRowsPerThread * (i + 1)) << geometry.lineBits;
+        rowEnd           = rowEnd > height ? height : rowEnd;
+        if (rowStart < rowEnd)
+        {
+            copyRows(src, dst, geometry, toLinear, rowStart, rowEnd, pitch, streamingStore);
+        }
+    });
+
+    return MOS_STATUS_SUCCESS;
+}
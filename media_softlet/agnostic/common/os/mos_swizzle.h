@@ -0,0 +1,137 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_swizzle.h
+//! \brief    Block based tile <-> linear swizzle engine
+//! \details  Copies whole tile lines (16B Y-major OWord columns or 512B X-major
+//!           lines) instead of translating every byte through MosSwizzleOffset.
+//!           The produced layout is bit-exact with the per byte implementation.
+//!
+#ifndef __MOS_SWIZZLE_H__
+#define __MOS_SWIZZLE_H__
+
+#include <stdint.h>
+#include "mos_defs.h"
+#include "mos_resource_defs.h"
+#include "media_class_trace.h"
+
+class MosSwizzle
+{
+public:
+    MosSwizzle()  = delete;
+    ~MosSwizzle() = delete;
+
+    //!
+    //! \brief    Check whether the engine handles a tiled <-> linear copy
+    //! \param    [in] srcTiling
+    //!           Source tile type
+    //! \param    [in] dstTiling
+    //!           Destination tile type
+    //! \return   bool
+    //!           true if exactly one side is linear and the other is X or Y tiled
+    //!
+    static bool IsSupported(MOS_TILE_TYPE srcTiling, MOS_TILE_TYPE dstTiling);
+
+    //!
+    //! \brief    Swizzle a surface between linear and tiled layouts
+    //! \details  Layout matches MosUtilities::MosSwizzleOffset without channel
+    //!           select XOR. Large surfaces are split by tile rows across worker
+    //!           threads when the pitch is tile aligned. The workers are started
+    //!           by the first such swizzle and reused by later ones.
+    //! \param    [in] src
+    //!           Pointer to source data
+    //! \param    [out] dst
+    //!           Pointer to destination data
+    //! \param    [in] srcTiling
+    //!           Source tile type
+    //! \param    [in] dstTiling
+    //!           Destination tile type
+    //! \param    [in] height
+    //!           Height in rows
+    //! \param    [in] pitch
+    //!           Row pitch in bytes
+    //! \param    [in] streamingStore
+    //!           Use non-temporal stores, for write-combined destinations
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS SwizzleData(
+        const uint8_t   *src,
+        uint8_t         *dst,
+        MOS_TILE_TYPE   srcTiling,
+        MOS_TILE_TYPE   dstTiling,
+        int32_t         height,
+        int32_t         pitch,
+        bool            streamingStore);
+
+    static const uint32_t m_parallelThreshold = 0x400000;   //!< Minimum surface size in bytes to split across threads
+    static const uint32_t m_maxWorkerThreads  = 4;          //!< Upper bound of worker threads per swizzle
+
+private:
+    //!
+    //! \brief    Tile geometry expressed in the X-major reinterpretation
+    //!
+    struct TileGeometry
+    {
+        int32_t lineBits;   //!< Log2 of lines per tile
+        int32_t lineBytes;  //!< Log2 of bytes per tile line
+    };
+
+    //!
+    //! \brief    Copy kernel selected at runtime by CPU capability
+    //!
+    using CopyRowsFunc = void (*)(
+        const uint8_t       *src,
+        uint8_t             *dst,
+        const TileGeometry  &geometry,
+        bool                toLinear,
+        int32_t             rowStart,
+        int32_t             rowEnd,
+        int32_t             pitch,
+        bool                streamingStore);
+
+    static void CopyRowsGeneric(
+        const uint8_t       *src,
+        uint8_t             *dst,
+        const TileGeometry  &geometry,
+        bool                toLinear,
+        int32_t             rowStart,
+        int32_t             rowEnd,
+        int32_t             pitch,
+        bool                streamingStore);
+
+    static void CopyRowsAvx2(
+        const uint8_t       *src,
+        uint8_t             *dst,
+        const TileGeometry  &geometry,
+        bool                toLinear,
+        int32_t             rowStart,
+        int32_t             rowEnd,
+        int32_t             pitch,
+        bool                streamingStore);
+
+    static CopyRowsFunc SelectCopyRows();
+
+MEDIA_CLASS_DEFINE_END(MosSwizzle)
+};
+
+#endif  // __MOS_SWIZZLE_H__
@@ -33,6 +33,7 @@
 #include <time.h>     //for simulate random memory allcation failure
 #include "mos_os.h"
 #include "mos_utilities_specific.h"
+#include "mos_swizzle.h"
 
 int32_t              MosUtilities::m_mosMemAllocCounterNoUserFeature    = 0;
 int32_t              MosUtilities::m_mosMemAllocCounterNoUserFeatureGfx = 0;
@@ -983,6 +984,19 @@ void MosUtilities::MosSwizzleData(
     int32_t x;
     int32_t y;
 
+#ifndef _MOS_UTILITY_EXT
+    // Move whole tile lines at once; the tiled side is GPU memory when writing
+    // back a system shadow, so stream those stores past the cache.
+    if (MosSwizzle::IsSupported(SrcTiling, DstTiling))
+    {
+        if (MosSwizzle::SwizzleData(pSrc, pDst, SrcTiling, DstTiling, iHeight, iPitch,
+                IS_LINEAR_TO_TILED(SrcTiling, DstTiling)) == MOS_STATUS_SUCCESS)
+        {
+            return;
+        }
+    }
+#endif
+
     // Translate from one format to another
     for (y = 0, LinearOffset = 0, TileOffset = 0; y < iHeight; y++)
     {
@@ -33,6 +33,9 @@
 #include <stdint.h>
 #include <map>
 #include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <utility>
 #include "media_user_setting.h"
 #include "media_utils.h"
@@ -102,6 +105,54 @@ struct FeatureIDs
 
 class MediaFeature;
 
+//!
+//! \brief  Dispatch table of features per command parameter setting interface
+//! \details The features implementing a given ParSetting interface only change
+//!          when the feature set changes, so the dynamic_cast over all features
+//!          is done once per interface type and replayed in feature order for
+//!          every following command, slice, tile and pass.
+//!
+class MediaFeatureDispatchTable
+{
+public:
+    //!
+    //! \brief  Get the features implementing setting interface T
+    //! \param  [in] features
+    //!         Feature container, iterated in feature ID order
+    //! \return const std::vector<const void *> &
+    //!         Pointers already cast to const T *, in feature ID order
+    //!
+    template <typename T, typename Container>
+    const std::vector<const void *> &Get(const Container &features)
+    {
+        std::type_index key(typeid(T));
+        auto            iter = m_tables.find(key);
+        if (iter != m_tables.end())
+        {
+            return iter->second;
+        }
+
+        std::vector<const void *> &table = m_tables[key];
+        for (const auto &e : features)
+        {
+            auto p = dynamic_cast<const T *>(e.second);
+            if (p)
+            {
+                table.push_back(p);
+            }
+        }
+        return table;
+    }
+
+    //!
+    //! \brief  Drop all tables, must be called whenever the feature set changes
+    //!
+    void Invalidate() { m_tables.clear(); }
+
+private:
+    std::unordered_map<std::type_index, std::vector<const void *>> m_tables;
+};
+
 enum class LIST_TYPE
 {
     BLOCK_LIST,
@@ -143,8 +194,20 @@ public:
             return iter->second;
         }
 
+        //!
+        //! \brief  Get the features implementing setting interface T
+        //! \return const std::vector<const void *> &
+        //!         Pointers already cast to const T *, in feature ID order
+        //!
+        template <typename T>
+        const std::vector<const void *> &GetParSettingFeatures()
+        {
+            return m_dispatchTable.Get<T>(m_features);
+        }
+
     private:
-        container_t m_features;
+        container_t               m_features;
+        MediaFeatureDispatchTable m_dispatchTable;
     };
 
 public:
@@ -251,6 +314,19 @@ public:
     //!         actual pass number after feature check
     //!
     uint8_t GetNumPass() { return m_passNum; };
+
+    //!
+    //! \brief  Get the features implementing setting interface T
+    //! \details Used by SETPAR, resolved once and reused until features change
+    //! \return const std::vector<const void *> &
+    //!         Pointers already cast to const T *, in feature ID order
+    //!
+    template <typename T>
+    const std::vector<const void *> &GetParSettingFeatures()
+    {
+        return m_dispatchTable.Get<T>(m_features);
+    }
+
     MediaFeatureConstSettings *GetFeatureSettings() { return m_featureConstSettings; };
     //!
     //! \brief  Check the conflict between features
@@ -289,6 +365,7 @@ protected:
     container_t m_features;
     std::map<int, std::vector<int>> m_packetIdList;  // map feature ID to a vector of packet ID
     std::map<int, LIST_TYPE> m_packetIdListTypes;  // map feature ID to a flag, indicates whether packet ID vector is a block list or an allow list
+    MediaFeatureDispatchTable m_dispatchTable;  // ParSetting interface to features, rebuilt on feature changes
     MediaFeatureConstSettings *m_featureConstSettings = nullptr;
     uint8_t m_targetUsage = 0;
     uint8_t m_passNum = 1;
@@ -57,13 +57,10 @@ namespace mhw{namespace mi{class Itf;}}  // namespace mhw
     }                                                                                   \
     if (m_featureManager)                                                               \
     {                                                                                   \
-        for (auto feature : *m_featureManager)                                          \
+        for (auto feature : m_featureManager->template GetParSettingFeatures<setting_t>()) \
         {                                                                               \
-            p = dynamic_cast<const setting_t *>(feature);                               \
-            if (p)                                                                      \
-            {                                                                           \
-                MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                       \
-            }                                                                           \
+            p = static_cast<const setting_t *>(feature);                                \
+            MHW_CHK_STATUS_RETURN(p->MHW_SETPAR_F(CMD)(par));                           \
         }                                                                               \
     }
 
@@ -133,6 +133,20 @@ public:
     //!
     uint32_t GetReportedCount() const { return m_reportedCount; }
 
+    //!
+    //! \brief  Get the resource HW writes the completed count to.
+    //! \return PMOS_RESOURCE
+    //!         Completed count resource, GPU work on it finishes when a frame completes
+    //!
+    PMOS_RESOURCE GetCompletedCountResource() const { return m_completedCountBuf; }
+
+    //!
+    //! \brief  Check whether the next status report to be queried is completed.
+    //! \return bool
+    //!         true if completed or nothing is pending
+    //!
+    bool IsNextReportCompleted() const { return GetCompletedCount() != m_reportedCount || m_submittedCount == m_reportedCount; }
+
     uint32_t GetIndex(uint32_t count) { return CounterToIndex(count); }
     //!
     //! \brief  Regist observer of complete event.
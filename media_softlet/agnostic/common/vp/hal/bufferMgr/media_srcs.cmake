@@ -28,6 +28,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_allocator.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_resource_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_hdr_resource_manager.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_stmm_history.h
 )
 
 set(SOFTLET_VP_SOURCES_
@@ -30,6 +30,7 @@
 #include "sw_filter_pipe.h"
 #include "vp_utils.h"
 #include "vp_platform_interface.h"
+#include "vp_stmm_history.h"
 
 using namespace std;
 namespace vp
@@ -1561,8 +1562,6 @@ MOS_STATUS VpResourceManager::VeboxInitSTMMHistory(MOS_SURFACE *stmmSurface)
 {
     VP_FUNC_CALL();
 
-    uint32_t            dwSize = 0;
-    int32_t             x = 0, y = 0;
     uint8_t*            pByte = nullptr;
     MOS_LOCK_PARAMS     LockFlags;
 
@@ -1578,20 +1577,8 @@ MOS_STATUS VpResourceManager::VeboxInitSTMMHistory(MOS_SURFACE *stmmSurface)
         &LockFlags);
     VP_PUBLIC_CHK_NULL_RETURN(pByte);
 
-    dwSize = stmmSurface->dwWidth >> 2;
-
-    // Fill STMM surface with DN history init values.
-    for (y = 0; y < (int32_t)stmmSurface->dwHeight; y++)
-    {
-        for (x = 0; x < (int32_t)dwSize; x++)
-        {
-            MOS_FillMemory(pByte, 2, DNDI_HISTORY_INITVALUE);
-            // skip denosie history init.
-            pByte += 4;
-        }
-
-        pByte += stmmSurface->dwPitch - stmmSurface->dwWidth;
-    }
+    // Fill STMM surface with DN history init values, skip denoise history init.
+    VpFillStmmHistory(pByte, stmmSurface->dwWidth, stmmSurface->dwHeight, stmmSurface->dwPitch, DNDI_HISTORY_INITVALUE);
 
     // Unlock the surface
     VP_PUBLIC_CHK_STATUS_RETURN(m_allocator.UnLock(&stmmSurface->OsResource));
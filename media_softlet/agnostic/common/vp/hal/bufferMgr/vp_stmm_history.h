@@ -0,0 +1,120 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_stmm_history.h
+//! \brief    Initialization of Vebox STMM history surfaces
+//!
+#ifndef __VP_STMM_HISTORY_H__
+#define __VP_STMM_HISTORY_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VP_STMM_HISTORY_AVX512 1
+#else
+#define VP_STMM_HISTORY_AVX512 0
+#endif
+
+namespace vp
+{
+//!
+//! \brief    Fill the DN history of elements [first, width / 4) in each row
+//! \details  See VpFillStmmHistory, the elements are written one by one.
+//!
+inline void VpFillStmmHistoryScalar(uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue, uint32_t first = 0)
+{
+    uint32_t elements  = width >> 2;
+    uint32_t rowStride = elements * 4 + pitch - width;
+    uint16_t history   = 0;
+    memset(&history, initValue, sizeof(history));
+
+    for (uint32_t y = 0; y < height; y++, data += rowStride)
+    {
+        uint8_t *element = data + first * 4;
+        for (uint32_t x = first; x < elements; x++, element += 4)
+        {
+            memcpy(element, &history, sizeof(history));
+        }
+    }
+}
+
+#if VP_STMM_HISTORY_AVX512
+//!
+//! \brief    Fill the DN history with byte masked stores of 16 elements
+//! \details  See VpFillStmmHistory, the caller checks for AVX512BW support.
+//!
+__attribute__((target("avx512bw")))
+inline void VpFillStmmHistoryAvx512(uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue)
+{
+    const __m512i   value     = _mm512_set1_epi8((char)initValue);
+    const __mmask64 mask      = 0x3333333333333333ull;  // Bytes 0 and 1 of each element
+    uint32_t        elements  = width >> 2;
+    uint32_t        rowStride = elements * 4 + pitch - width;
+    uint32_t        blocks    = elements / 16;
+    uint8_t        *row       = data;
+
+    for (uint32_t y = 0; y < height; y++, row += rowStride)
+    {
+        for (uint32_t x = 0; x < blocks; x++)
+        {
+            _mm512_mask_storeu_epi8(row + x * 64, mask, value);
+        }
+    }
+    VpFillStmmHistoryScalar(data, width, height, pitch, initValue, blocks * 16);
+}
+#endif
+
+//!
+//! \brief    Fill the DN history of a locked STMM surface
+//! \details  Each 4 byte STMM element starts with 2 bytes of DN history which are
+//!           set to initValue. The 2 denoise history bytes are not written, the
+//!           surface is locked write only so they cannot be merged into wider stores.
+//!           With AVX512BW one byte masked store covers 16 elements, otherwise the
+//!           elements are written one by one. Rows advance by width / 4 elements
+//!           plus pitch - width bytes.
+//! \param    [in] data
+//!           Pointer to the locked surface
+//! \param    [in] width
+//!           Surface width in bytes
+//! \param    [in] height
+//!           Surface height
+//! \param    [in] pitch
+//!           Surface pitch, not less than width
+//! \param    [in] initValue
+//!           DN history init value
+//!
+inline void VpFillStmmHistory(uint8_t *data, uint32_t width, uint32_t height, uint32_t pitch, uint8_t initValue)
+{
+#if VP_STMM_HISTORY_AVX512
+    if (__builtin_cpu_supports("avx512bw"))
+    {
+        VpFillStmmHistoryAvx512(data, width, height, pitch, initValue);
+        return;
+    }
+#endif
+    VpFillStmmHistoryScalar(data, width, height, pitch, initValue);
+}
+}  // namespace vp
+
+#endif  // __VP_STMM_HISTORY_H__
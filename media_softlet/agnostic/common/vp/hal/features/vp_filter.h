@@ -496,8 +496,6 @@ struct _RENDER_HDR_PARAMS
     VPHAL_SURFACE                   OETF1DLUTSurface[VPHAL_MAX_HDR_INPUT_LAYER];        //!< OETF 1D LUT surface
     VPHAL_SURFACE                   CoeffSurface;                                       //!< CSC CCM Coeff surface
 
-    uint16_t                        OetfSmpteSt2084[VPHAL_HDR_OETF_1DLUT_POINT_NUMBER];      //!< EOTF 1D LUT SMPTE ST2084
-
     uint8_t*                        pInput3DLUT;                                             //!< Input 3DLUT address for GPU generate 3DLUT
 
     const uint16_t                  *pHDRStageConfigTable = nullptr;
@@ -32,6 +32,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_vebox_hdr_3dlut_kernel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_vebox_hvs_kernel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_hdr_kernel.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/vp_render_hdr_oetf.cpp
 )
 
 set(TMP_HEADERS_
@@ -53,6 +54,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_vebox_hdr_3dlut_kernel.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_vebox_hvs_kernel.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_render_hdr_kernel.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_render_hdr_oetf.h
 )
 
 set(SOFTLET_VP_SOURCES_
@@ -29,6 +29,7 @@
 #include "hal_kerneldll_next.h"
 #include "hal_oca_interface_next.h"
 #include "vp_user_feature_control.h"
+#include "vp_render_hdr_oetf.h"
 
 using namespace vp;
 
@@ -1261,90 +1262,6 @@ void VpRenderHdrKernel::HdrLimitFP32ArrayPrecisionToF3_9(float fps[], size_t siz
     }
 }
 
-typedef float (*pfnOETFFunc)(float radiance);
-
-float HdrOETF2084(float c)
-{
-    static const double C1 = 0.8359375;
-    static const double C2 = 18.8515625;
-    static const double C3 = 18.6875;
-    static const double M1 = 0.1593017578125;
-    static const double M2 = 78.84375;
-
-    double tmp         = c;
-    double numerator   = pow(tmp, M1);
-    double denominator = numerator;
-
-    denominator = 1.0 + C3 * denominator;
-    numerator   = C1 + C2 * numerator;
-    numerator   = numerator / denominator;
-
-    return (float)pow(numerator, M2);
-}
-
-float HdrOETFBT709(float c)
-{
-    static const double E0 = 0.45;
-    static const double C1 = 0.099;
-    static const double C2 = 4.5;
-    static const double P0 = 0.018;
-
-    double tmp = c;
-    double result;
-
-    if (tmp <= P0)
-    {
-        result = C2 * tmp;
-    }
-    else
-    {
-        result = (C1 + 1.0) * pow(tmp, E0) - C1;
-    }
-    return (float)result;
-}
-
-float HdrOETFsRGB(float c)
-{
-    static const double E1 = 2.4;
-    static const double C1 = 0.055;
-    static const double C2 = 12.92;
-    static const double P0 = 0.0031308;
-
-    double tmp = c;
-    double result;
-
-    if (tmp <= P0)
-    {
-        result = C2 * tmp;
-    }
-    else
-    {
-        result = (C1 + 1.0) * pow(tmp, 1.0 / E1) - C1;
-    }
-    return (float)result;
-}
-
-// Non-uniform OETF LUT generator.
-void HdrGenerate2SegmentsOETFLUT(float fStretchFactor, pfnOETFFunc oetfFunc, uint16_t *lut)
-{
-    int i = 0, j = 0;
-
-    for (i = 0; i < VPHAL_HDR_OETF_1DLUT_HEIGHT; ++i)
-    {
-        for (j = 0; j < VPHAL_HDR_OETF_1DLUT_WIDTH; ++j)
-        {
-            int   idx = j + i * (VPHAL_HDR_OETF_1DLUT_WIDTH - 1);
-            float a   = (idx < 32) ? ((1.0f / 1024.0f) * idx) : ((1.0f / 32.0f) * (idx - 31));
-
-            if (a > 1.0f)
-                a = 1.0f;
-
-            a *= fStretchFactor;
-            lut[i * VPHAL_HDR_OETF_1DLUT_WIDTH + j] = VpHal_FloatToHalfFloat(oetfFunc(a));
-        }
-    }
-}
-
 //!
 //! \brief    Initiate EOTF Surface for HDR
 //! \details  Initiate EOTF Surface for HDR
@@ -1365,7 +1282,7 @@ MOS_STATUS VpRenderHdrKernel::InitOETF1DLUT(
 
     MOS_STATUS      eStatus     = MOS_STATUS_SUCCESS;
     uint32_t        i           = 0;
-    uint16_t       *pSrcOetfLut = nullptr;
+    const uint16_t *pSrcOetfLut = nullptr;
     uint8_t        *pDstOetfLut = nullptr;
     MOS_LOCK_PARAMS LockFlags   = {};
 
@@ -1409,9 +1326,7 @@ MOS_STATUS VpRenderHdrKernel::InitOETF1DLUT(
     {
         if (params->HdrMode[iIndex] == VPHAL_HDR_MODE_INVERSE_TONE_MAPPING)
         {
-            const float fStretchFactor = 0.01f;
-            HdrGenerate2SegmentsOETFLUT(fStretchFactor, HdrOETF2084, params->OetfSmpteSt2084);
-            pSrcOetfLut = params->OetfSmpteSt2084;
+            pSrcOetfLut = HdrGetOETFSmpteSt2084LUT();
         }
         else  // params->HdrMode[iIndex] == VPHAL_HDR_MODE_H2H
         {
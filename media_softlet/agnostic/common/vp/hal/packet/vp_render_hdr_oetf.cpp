@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_render_hdr_oetf.cpp
+//! \brief    OETF 1D LUT generation of the HDR render kernel
+//!
+
+#include <math.h>
+#include <mutex>
+#include "vp_common.h"
+#include "vp_render_hdr_oetf.h"
+
+float HdrOETF2084(float c)
+{
+    static const double C1 = 0.8359375;
+    static const double C2 = 18.8515625;
+    static const double C3 = 18.6875;
+    static const double M1 = 0.1593017578125;
+    static const double M2 = 78.84375;
+
+    double tmp         = c;
+    double numerator   = pow(tmp, M1);
+    double denominator = numerator;
+
+    denominator = 1.0 + C3 * denominator;
+    numerator   = C1 + C2 * numerator;
+    numerator   = numerator / denominator;
+
+    return (float)pow(numerator, M2);
+}
+
+float HdrOETFBT709(float c)
+{
+    static const double E0 = 0.45;
+    static const double C1 = 0.099;
+    static const double C2 = 4.5;
+    static const double P0 = 0.018;
+
+    double tmp = c;
+    double result;
+
+    if (tmp <= P0)
+    {
+        result = C2 * tmp;
+    }
+    else
+    {
+        result = (C1 + 1.0) * pow(tmp, E0) - C1;
+    }
+    return (float)result;
+}
+
+float HdrOETFsRGB(float c)
+{
+    static const double E1 = 2.4;
+    static const double C1 = 0.055;
+    static const double C2 = 12.92;
+    static const double P0 = 0.0031308;
+
+    double tmp = c;
+    double result;
+
+    if (tmp <= P0)
+    {
+        result = C2 * tmp;
+    }
+    else
+    {
+        result = (C1 + 1.0) * pow(tmp, 1.0 / E1) - C1;
+    }
+    return (float)result;
+}
+
+// Non-uniform OETF LUT generator.
+void HdrGenerate2SegmentsOETFLUT(float fStretchFactor, pfnOETFFunc oetfFunc, uint16_t *lut)
+{
+    int i = 0, j = 0;
+
+    for (i = 0; i < VPHAL_HDR_OETF_1DLUT_HEIGHT; ++i)
+    {
+        for (j = 0; j < VPHAL_HDR_OETF_1DLUT_WIDTH; ++j)
+        {
+            int   idx = j + i * (VPHAL_HDR_OETF_1DLUT_WIDTH - 1);
+            float a   = (idx < 32) ? ((1.0f / 1024.0f) * idx) : ((1.0f / 32.0f) * (idx - 31));
+
+            if (a > 1.0f)
+                a = 1.0f;
+
+            a *= fStretchFactor;
+            lut[i * VPHAL_HDR_OETF_1DLUT_WIDTH + j] = VpHal_FloatToHalfFloat(oetfFunc(a));
+        }
+    }
+}
+
+const uint16_t *HdrGetOETFSmpteSt2084LUT()
+{
+    static uint16_t       lut[VPHAL_HDR_OETF_1DLUT_SIZE];
+    static std::once_flag lutOnce;
+    std::call_once(lutOnce, [] {
+        const float fStretchFactor = 0.01f;
+        HdrGenerate2SegmentsOETFLUT(fStretchFactor, HdrOETF2084, lut);
+    });
+
+    return lut;
+}
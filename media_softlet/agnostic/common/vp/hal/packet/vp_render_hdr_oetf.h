@@ -0,0 +1,60 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_render_hdr_oetf.h
+//! \brief    OETF 1D LUT generation of the HDR render kernel
+//!
+#ifndef __VP_RENDER_HDR_OETF_H__
+#define __VP_RENDER_HDR_OETF_H__
+
+#include <stdint.h>
+#include "vp_common_hdr.h"
+
+#define VPHAL_HDR_OETF_1DLUT_SIZE (VPHAL_HDR_OETF_1DLUT_WIDTH * VPHAL_HDR_OETF_1DLUT_HEIGHT)
+
+typedef float (*pfnOETFFunc)(float radiance);
+
+float HdrOETF2084(float c);
+float HdrOETFBT709(float c);
+float HdrOETFsRGB(float c);
+
+//!
+//! \brief    Generate a non-uniform OETF LUT in FP16
+//! \param    [in] fStretchFactor
+//!           Scale applied to the sampled input range
+//! \param    [in] oetfFunc
+//!           OETF to sample
+//! \param    [out] lut
+//!           VPHAL_HDR_OETF_1DLUT_SIZE entries
+//!
+void HdrGenerate2SegmentsOETFLUT(float fStretchFactor, pfnOETFFunc oetfFunc, uint16_t *lut);
+
+//!
+//! \brief    Get the SMPTE ST2084 OETF LUT used for inverse tone mapping
+//! \details  The table only depends on constants, it is generated on first use
+//!           and shared by all HDR kernels of the process.
+//! \return   const uint16_t *
+//!           VPHAL_HDR_OETF_1DLUT_SIZE FP16 entries
+//!
+const uint16_t *HdrGetOETFSmpteSt2084LUT();
+
+#endif  // __VP_RENDER_HDR_OETF_H__
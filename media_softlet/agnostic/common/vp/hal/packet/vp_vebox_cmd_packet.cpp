@@ -38,6 +38,7 @@
 #include "mhw_utilities.h"
 #include "media_scalability_defs.h"
 #include "renderhal_platform_interface_next.h"
+#include "vp_stmm_history.h"
 
 namespace vp {
 
@@ -282,8 +283,6 @@ MOS_STATUS VpVeboxCmdPacket::InitSTMMHistory()
     VP_FUNC_CALL();
 
     MOS_STATUS          eStatus;
-    uint32_t            dwSize;
-    int32_t             x, y;
     uint8_t*            pByte;
     MOS_LOCK_PARAMS     LockFlags;
     PVP_SURFACE         stmmSurface = GetSurface(SurfaceTypeSTMMIn);
@@ -304,20 +303,13 @@ MOS_STATUS VpVeboxCmdPacket::InitSTMMHistory()
 
     VP_RENDER_CHK_NULL(pByte);
 
-    dwSize = stmmSurface->osSurface->dwWidth >> 2;
-
-    // Fill STMM surface with DN history init values.
-    for (y = 0; y < (int32_t)stmmSurface->osSurface->dwHeight; y++)
-    {
-        for (x = 0; x < (int32_t)dwSize; x++)
-        {
-            MOS_FillMemory(pByte, 2, DNDI_HISTORY_INITVALUE);
-            // skip denosie history init.
-            pByte += 4;
-        }
-
-        pByte += stmmSurface->osSurface->dwPitch - stmmSurface->osSurface->dwWidth;
-    }
+    // Fill STMM surface with DN history init values, skip denoise history init.
+    VpFillStmmHistory(
+        pByte,
+        stmmSurface->osSurface->dwWidth,
+        stmmSurface->osSurface->dwHeight,
+        stmmSurface->osSurface->dwPitch,
+        DNDI_HISTORY_INITVALUE);
 
     // Unlock the surface
     VP_RENDER_CHK_STATUS(m_allocator->UnLock(&stmmSurface->osSurface->OsResource));
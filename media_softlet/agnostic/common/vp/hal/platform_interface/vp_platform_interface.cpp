@@ -106,6 +106,9 @@ MOS_STATUS VpRenderKernel::InitVPKernel(
     else
     {
         KernelDll_SetupFunctionPointers_Ext(m_kernelDllState);
+
+        // Opt-in cache of linked kernels shared with later processes
+        KernelDll_OpenPersistentCache(m_kernelDllState, getenv(DL_PERSISTENT_CACHE_ENV));
     }
 
     SetKernelName(VpRenderKernel::s_kernelNameNonAdvKernels);
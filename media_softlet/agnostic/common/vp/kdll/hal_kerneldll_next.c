@@ -1172,6 +1172,12 @@ uint32_t KernelDll_SimpleHash(void *pData, int32_t iSize)
    return hash;
 }
 
+static Kdll_CacheEntry *KernelDll_GetPersistentKernel(
+    Kdll_State       *pState,
+    Kdll_FilterEntry *pFilter,
+    int32_t           iFilterSize,
+    uint32_t          dwHash);
+
 //--------------------------------------------------------------
 // KernelDll_GetCombinedKernel - Search combined kernel
 //--------------------------------------------------------------
@@ -1196,7 +1202,10 @@ Kdll_CacheEntry *KernelDll_GetCombinedKernel(
 
     // No entries
     entry = pHashTable->wHashTable[folded_hash];
-    if (entry == 0 || entry > DL_MAX_COMBINED_KERNELS ) return nullptr;
+    if (entry == 0 || entry > DL_MAX_COMBINED_KERNELS)
+    {   // Kernel may have been linked by an earlier process
+        return pState->pPersistentCache ? KernelDll_GetPersistentKernel(pState, pFilter, iFilterSize, dwHash) : nullptr;
+    }
 
     entries = (&pHashTable->HashEntry[0]) - 1;  // all indices are 1 based (0 means null)
     curr    = &entries[entry];
@@ -1221,590 +1230,636 @@ Kdll_CacheEntry *KernelDll_GetCombinedKernel(
         curr->pCacheEntry->dwRefresh = pState->dwRefresh++;
         return (curr->pCacheEntry);
     }
+    else if (pState->pPersistentCache)
+    {   // Kernel may have been linked by an earlier process
+        return KernelDll_GetPersistentKernel(pState, pFilter, iFilterSize, dwHash);
+    }
     else
     {   // Kernel must be built
         return nullptr;
     }
 }
 
-/*----------------------------------------------------------------------------
-| Name      : KernelDll_FindRule
-| Purpose   : Find a rule that matches the current search/input state
-|
-| Input     : pState       - Kernel Dll state
-|             pSearchState - current DL search state
-|
-| Return    :
-\---------------------------------------------------------------------------*/
-bool KernelDll_FindRule(
-    Kdll_State *      pState,
-    Kdll_SearchState *pSearchState)
+//--------------------------------------------------------------
+// KernelDll_MatchRuleSet - Check if all match rules of a rule set hold
+//--------------------------------------------------------------
+static bool KernelDll_MatchRuleSet(
+    Kdll_SearchState        *pSearchState,
+    const Kdll_RuleEntrySet *pRuleSet)
 {
-    uint32_t              parser_state = (uint32_t)pSearchState->state;
-    Kdll_RuleEntrySet *   pRuleSet;
-    const Kdll_RuleEntry *pRuleEntry;
-    int32_t               iRuleCount;
-    int32_t               iMatchCount;
-    bool                  bLayerFormatMatched;
-    bool                  bSrc0FormatMatched;
-    bool                  bSrc1FormatMatched;
-    bool                  bTargetFormatMatched;
-    bool                  bSrc0SampingMatched;
-
-    VP_RENDER_FUNCTION_ENTER;
-
-    // All Custom states are handled as a single group
-    if (parser_state >= Parser_Custom)
+    // Points to the first rule, get number of matches
+    const Kdll_RuleEntry *pRuleEntry  = pRuleSet->pRuleEntry;
+    int32_t               iMatchCount = pRuleSet->iMatchCount;
+
+    // Initialize for each Ruleset
+    bool bLayerFormatMatched  = false;
+    bool bSrc0FormatMatched   = false;
+    bool bSrc1FormatMatched   = false;
+    bool bTargetFormatMatched = false;
+    bool bSrc0SampingMatched  = false;
+
+    // Match all rules within the same RuleSet
+    for (; iMatchCount > 0; iMatchCount--, pRuleEntry++)
     {
-        parser_state = Parser_Custom;
-    }
-
-    pRuleSet   = pState->pDllRuleTable[parser_state];
-    iRuleCount = pState->iDllRuleCount[parser_state];
+        switch (pRuleEntry->id)
+        {
+        // Match current Parser State
+        case RID_IsParserState:
+            if (pSearchState->state == (Kdll_ParserState)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-    if (pRuleSet == nullptr || iRuleCount == 0)
-    {
-        VP_RENDER_NORMALMESSAGE("Search rules undefined.");
-        pSearchState->pMatchingRuleSet = nullptr;
-        return false;
-    }
+        // Match render method
+        case RID_IsRenderMethod:
+            if (pSearchState->pFilter->RenderMethod == (Kdll_RenderMethod)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-    // Search matching entry
-    for (; iRuleCount > 0; iRuleCount--, pRuleSet++)
-    {
-        // Points to the first rule, get number of matches
-        pRuleEntry  = pRuleSet->pRuleEntry;
-        iMatchCount = pRuleSet->iMatchCount;
+        // Match target color space
+        case RID_IsTargetCspace:
+            if (KernelDll_IsCspace(pSearchState->cspace, (VPHAL_CSPACE)pRuleEntry->value))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-        // Initialize for each Ruleset
-        bLayerFormatMatched  = false;
-        bSrc0FormatMatched   = false;
-        bSrc1FormatMatched   = false;
-        bTargetFormatMatched = false;
-        bSrc0SampingMatched  = false;
+        // Match current layer ID
+        case RID_IsLayerID:
+            if (pSearchState->pFilter->layer == (Kdll_Layer)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-        // Match all rules within the same RuleSet
-        for (; iMatchCount > 0; iMatchCount--, pRuleEntry++)
-        {
-            switch (pRuleEntry->id)
+        // Match current layer format
+        case RID_IsLayerFormat:
+            if (pRuleEntry->logic == Kdll_Or && bLayerFormatMatched)
             {
-            // Match current Parser State
-            case RID_IsParserState:
-                if (pSearchState->state == (Kdll_ParserState)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
+                // Already found matching format in the ruleset
+                continue;
+            }
+            else
+            {
+                // Check if the layer format matches the rule
+                if (KernelDll_IsFormat(pSearchState->pFilter->format,
+                        pSearchState->pFilter->cspace,
+                        (MOS_FORMAT)pRuleEntry->value))
                 {
-                    break;
+                    bLayerFormatMatched = true;
                 }
 
-            // Match render method
-            case RID_IsRenderMethod:
-                if (pSearchState->pFilter->RenderMethod == (Kdll_RenderMethod)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
+                if (pRuleEntry->logic == Kdll_None && !bLayerFormatMatched)
                 {
+                    // Last entry and No matching format was found
                     break;
                 }
-
-            // Match target color space
-            case RID_IsTargetCspace:
-                if (KernelDll_IsCspace(pSearchState->cspace, (VPHAL_CSPACE)pRuleEntry->value))
-                {
-                    continue;
-                }
                 else
-                {
-                    break;
-                }
-
-            // Match current layer ID
-            case RID_IsLayerID:
-                if (pSearchState->pFilter->layer == (Kdll_Layer)pRuleEntry->value)
                 {
                     continue;
                 }
-                else
-                {
-                    break;
-                }
+            }
 
-            // Match current layer format
-            case RID_IsLayerFormat:
-                if (pRuleEntry->logic == Kdll_Or && bLayerFormatMatched)
-                {
-                    // Already found matching format in the ruleset
-                    continue;
-                }
-                else
-                {
-                    // Check if the layer format matches the rule
-                    if (KernelDll_IsFormat(pSearchState->pFilter->format,
-                            pSearchState->pFilter->cspace,
-                            (MOS_FORMAT)pRuleEntry->value))
-                    {
-                        bLayerFormatMatched = true;
-                    }
+        // Match shuffling requirement
+        case RID_IsShuffling:
+            if (pSearchState->ShuffleSamplerData == (Kdll_Shuffling)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-                    if (pRuleEntry->logic == Kdll_None && !bLayerFormatMatched)
-                    {
-                        // Last entry and No matching format was found
-                        break;
-                    }
-                    else
-                    {
-                        continue;
-                    }
-                }
+        // Check if RT rotates
+        case RID_IsRTRotate:
+            if (pSearchState->bRTRotate == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match shuffling requirement
-            case RID_IsShuffling:
-                if (pSearchState->ShuffleSamplerData == (Kdll_Shuffling)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match current layer rotation
+        case RID_IsLayerRotation:
+            if (pSearchState->pFilter->rotation == (VPHAL_ROTATION)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Check if RT rotates
-            case RID_IsRTRotate:
-                if (pSearchState->bRTRotate == (pRuleEntry->value ? true : false))
+        // Match Src0 source format (surface)
+        case RID_IsSrc0Format:
+            if (pRuleEntry->logic == Kdll_Or && bSrc0FormatMatched)
+            {
+                // Already found matching format in the ruleset
+                continue;
+            }
+            else
+            {
+                // Check if the source 0 format matches the rule
+                // The intermediate colorspace is used to determine
+                // if palettized input is given in RGB or YUV format.
+                if (KernelDll_IsFormat(pSearchState->src0_format,
+                        pSearchState->cspace,
+                        (MOS_FORMAT)pRuleEntry->value))
                 {
-                    continue;
+                    bSrc0FormatMatched = true;
                 }
-                else
+
+                if (pRuleEntry->logic == Kdll_None && !bSrc0FormatMatched)
                 {
+                    // Last entry and No matching format was found
                     break;
                 }
-
-            // Match current layer rotation
-            case RID_IsLayerRotation:
-                if (pSearchState->pFilter->rotation == (VPHAL_ROTATION)pRuleEntry->value)
+                else
                 {
                     continue;
                 }
-                else
+            }
+
+        // Match Src0 sampling mode
+        case RID_IsSrc0Sampling:
+            // Check if the layer format matches the rule
+            if (pSearchState->src0_sampling == (Kdll_Sampling)pRuleEntry->value)
+            {
+                bSrc0SampingMatched = true;
+                continue;
+            }
+            else if (bSrc0SampingMatched || pRuleEntry->logic == Kdll_Or)
+            {
+                continue;
+            }
+            else if ((Kdll_Sampling)pRuleEntry->value == Sample_Any &&
+                     pSearchState->src0_sampling != Sample_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 rotation
+        case RID_IsSrc0Rotation:
+            if (pSearchState->src0_rotation == (VPHAL_ROTATION)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 Colorfill
+        case RID_IsSrc0ColorFill:
+            if (pSearchState->src0_colorfill == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 Luma Key
+        case RID_IsSrc0LumaKey:
+            if (pSearchState->src0_lumakey == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 Procamp
+        case RID_IsSrc0Procamp:
+            if (pSearchState->pFilter->procamp == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 CSC coefficients
+        case RID_IsSrc0Coeff:
+            if (pSearchState->src0_coeff == (Kdll_CoeffID)pRuleEntry->value)
+            {
+                continue;
+            }
+            else if ((Kdll_CoeffID)pRuleEntry->value == CoeffID_Any &&
+                     pSearchState->src0_coeff != CoeffID_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 CSC coefficients setting mode
+        case RID_IsSetCoeffMode:
+            if (pSearchState->pFilter->SetCSCCoeffMode == (Kdll_SetCSCCoeffMethod)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 processing mode
+        case RID_IsSrc0Processing:
+            if (pSearchState->src0_process == (Kdll_Processing)pRuleEntry->value)
+            {
+                continue;
+            }
+            if ((Kdll_Processing)pRuleEntry->value == Process_Any &&
+                pSearchState->src0_process != Process_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src0 chromasiting mode
+        case RID_IsSrc0Chromasiting:
+            if (pSearchState->Filter->chromasiting == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+
+        // Match Src1 source format (surface)
+        case RID_IsSrc1Format:
+            if (pRuleEntry->logic == Kdll_Or && bSrc1FormatMatched)
+            {
+                // Already found matching format in the ruleset
+                continue;
+            }
+            else
+            {
+                // Check if the source 1 format matches the rule
+                // The intermediate colorspace is used to determine
+                // if palettized input is given in RGB or YUV format.
+                if (KernelDll_IsFormat(pSearchState->src1_format,
+                        pSearchState->cspace,
+                        (MOS_FORMAT)pRuleEntry->value))
                 {
-                    break;
+                    bSrc1FormatMatched = true;
                 }
 
-            // Match Src0 source format (surface)
-            case RID_IsSrc0Format:
-                if (pRuleEntry->logic == Kdll_Or && bSrc0FormatMatched)
+                if (pRuleEntry->logic == Kdll_None && !bSrc1FormatMatched)
                 {
-                    // Already found matching format in the ruleset
-                    continue;
+                    // Last entry and No matching format was found
+                    break;
                 }
                 else
                 {
-                    // Check if the source 0 format matches the rule
-                    // The intermediate colorspace is used to determine
-                    // if palettized input is given in RGB or YUV format.
-                    if (KernelDll_IsFormat(pSearchState->src0_format,
-                            pSearchState->cspace,
-                            (MOS_FORMAT)pRuleEntry->value))
-                    {
-                        bSrc0FormatMatched = true;
-                    }
-
-                    if (pRuleEntry->logic == Kdll_None && !bSrc0FormatMatched)
-                    {
-                        // Last entry and No matching format was found
-                        break;
-                    }
-                    else
-                    {
-                        continue;
-                    }
-                }
-
-            // Match Src0 sampling mode
-            case RID_IsSrc0Sampling:
-                // Check if the layer format matches the rule
-                if (pSearchState->src0_sampling == (Kdll_Sampling)pRuleEntry->value)
-                {
-                    bSrc0SampingMatched = true;
                     continue;
                 }
-                else if (bSrc0SampingMatched || pRuleEntry->logic == Kdll_Or)
-                {
-                    continue;
-                }
-                else if ((Kdll_Sampling)pRuleEntry->value == Sample_Any &&
-                         pSearchState->src0_sampling != Sample_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+            }
+        // Match Src1 sampling mode
+        case RID_IsSrc1Sampling:
+            if (pSearchState->src1_sampling == (Kdll_Sampling)pRuleEntry->value)
+            {
+                continue;
+            }
+            else if ((Kdll_Sampling)pRuleEntry->value == Sample_Any &&
+                     pSearchState->src1_sampling != Sample_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 rotation
-            case RID_IsSrc0Rotation:
-                if (pSearchState->src0_rotation == (VPHAL_ROTATION)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 Luma Key
+        case RID_IsSrc1LumaKey:
+            if (pSearchState->src1_lumakey == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 Colorfill
-            case RID_IsSrc0ColorFill:
-                if (pSearchState->src0_colorfill == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 Sampler LumaKey
+        case RID_IsSrc1SamplerLumaKey:
+            if (pSearchState->src1_samplerlumakey == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 Luma Key
-            case RID_IsSrc0LumaKey:
-                if (pSearchState->src0_lumakey == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 Procamp
+        case RID_IsSrc1Procamp:
+            if (pSearchState->pFilter->procamp == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 Procamp
-            case RID_IsSrc0Procamp:
-                if (pSearchState->pFilter->procamp == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 CSC coefficients
+        case RID_IsSrc1Coeff:
+            if (pSearchState->src1_coeff == (Kdll_CoeffID)pRuleEntry->value)
+            {
+                continue;
+            }
+            else if ((Kdll_CoeffID)pRuleEntry->value == CoeffID_Any &&
+                     pSearchState->src1_coeff != CoeffID_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 CSC coefficients
-            case RID_IsSrc0Coeff:
-                if (pSearchState->src0_coeff == (Kdll_CoeffID)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else if ((Kdll_CoeffID)pRuleEntry->value == CoeffID_Any &&
-                         pSearchState->src0_coeff != CoeffID_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 processing mode
+        case RID_IsSrc1Processing:
+            if (pSearchState->src1_process == (Kdll_Processing)pRuleEntry->value)
+            {
+                continue;
+            }
+            if ((Kdll_Processing)pRuleEntry->value == Process_Any &&
+                pSearchState->src1_process != Process_None)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 CSC coefficients setting mode
-            case RID_IsSetCoeffMode:
-                if (pSearchState->pFilter->SetCSCCoeffMode == (Kdll_SetCSCCoeffMethod)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Src1 chromasiting mode
+        case RID_IsSrc1Chromasiting:
+            //pSearchState->pFilter is pointed to the real sub layer
+            if (pSearchState->pFilter->chromasiting == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 processing mode
-            case RID_IsSrc0Processing:
-                if (pSearchState->src0_process == (Kdll_Processing)pRuleEntry->value)
-                {
-                    continue;
-                }
-                if ((Kdll_Processing)pRuleEntry->value == Process_Any &&
-                    pSearchState->src0_process != Process_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match Layer number
+        case RID_IsLayerNumber:
+            if (pSearchState->layer_number == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src0 chromasiting mode
-            case RID_IsSrc0Chromasiting:
-                if (pSearchState->Filter->chromasiting == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Match quadrant
+        case RID_IsQuadrant:
+            if (pSearchState->quadrant == (int32_t)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src1 source format (surface)
-            case RID_IsSrc1Format:
-                if (pRuleEntry->logic == Kdll_Or && bSrc1FormatMatched)
-                {
-                    // Already found matching format in the ruleset
-                    continue;
-                }
-                else
-                {
-                    // Check if the source 1 format matches the rule
-                    // The intermediate colorspace is used to determine
-                    // if palettized input is given in RGB or YUV format.
-                    if (KernelDll_IsFormat(pSearchState->src1_format,
-                            pSearchState->cspace,
-                            (MOS_FORMAT)pRuleEntry->value))
-                    {
-                        bSrc1FormatMatched = true;
-                    }
+        // Set CSC flag before Mix
+        case RID_IsCSCBeforeMix:
+            if (pSearchState->bCscBeforeMix == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-                    if (pRuleEntry->logic == Kdll_None && !bSrc1FormatMatched)
-                    {
-                        // Last entry and No matching format was found
-                        break;
-                    }
-                    else
-                    {
-                        continue;
-                    }
-                }
-            // Match Src1 sampling mode
-            case RID_IsSrc1Sampling:
-                if (pSearchState->src1_sampling == (Kdll_Sampling)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else if ((Kdll_Sampling)pRuleEntry->value == Sample_Any &&
-                         pSearchState->src1_sampling != Sample_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_IsDualOutput:
+            if (pSearchState->pFilter->dualout == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src1 Luma Key
-            case RID_IsSrc1LumaKey:
-                if (pSearchState->src1_lumakey == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
+        case RID_IsTargetFormat:
+            if (pRuleEntry->logic == Kdll_Or && bTargetFormatMatched)
+            {
+                // Already found matching format in the ruleset
+                continue;
+            }
+            else
+            {
+                if (pSearchState->target_format == (MOS_FORMAT)pRuleEntry->value)
                 {
-                    break;
+                    bTargetFormatMatched = true;
                 }
 
-            // Match Src1 Sampler LumaKey
-            case RID_IsSrc1SamplerLumaKey:
-                if (pSearchState->src1_samplerlumakey == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
+                if (pRuleEntry->logic == Kdll_None && !bTargetFormatMatched)
                 {
+                    // Last entry and No matching format was found
                     break;
                 }
-
-            // Match Src1 Procamp
-            case RID_IsSrc1Procamp:
-                if (pSearchState->pFilter->procamp == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
                 else
-                {
-                    break;
-                }
-
-            // Match Src1 CSC coefficients
-            case RID_IsSrc1Coeff:
-                if (pSearchState->src1_coeff == (Kdll_CoeffID)pRuleEntry->value)
                 {
                     continue;
                 }
-                else if ((Kdll_CoeffID)pRuleEntry->value == CoeffID_Any &&
-                         pSearchState->src1_coeff != CoeffID_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+            }
 
-            // Match Src1 processing mode
-            case RID_IsSrc1Processing:
-                if (pSearchState->src1_process == (Kdll_Processing)pRuleEntry->value)
-                {
-                    continue;
-                }
-                if ((Kdll_Processing)pRuleEntry->value == Process_Any &&
-                    pSearchState->src1_process != Process_None)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_Is64BSaveEnabled:
+            if (pSearchState->b64BSaveEnabled == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Src1 chromasiting mode
-            case RID_IsSrc1Chromasiting:
-                //pSearchState->pFilter is pointed to the real sub layer
-                if (pSearchState->pFilter->chromasiting == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_IsTargetTileType:
+            if (pRuleEntry->logic == Kdll_None &&
+                pSearchState->target_tiletype == (MOS_TILE_TYPE)pRuleEntry->value)
+            {
+                continue;
+            }
+            else if (pRuleEntry->logic == Kdll_Not &&
+                     pSearchState->target_tiletype != (MOS_TILE_TYPE)pRuleEntry->value)
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match Layer number
-            case RID_IsLayerNumber:
-                if (pSearchState->layer_number == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_IsProcampEnabled:
+            if (pSearchState->bProcamp == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Match quadrant
-            case RID_IsQuadrant:
-                if (pSearchState->quadrant == (int32_t)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_IsConstOutAlpha:
+            if (pSearchState->pFilter->bFillOutputAlphaWithConstant == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
 
-            // Set CSC flag before Mix
-            case RID_IsCSCBeforeMix:
-                if (pSearchState->bCscBeforeMix == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        case RID_IsDitherNeeded:
+            if (pSearchState->pFilter->bIsDitherNeeded == (pRuleEntry->value ? true : false))
+            {
+                continue;
+            }
+            else
+            {
+                break;
+            }
+        // Undefined search rule will fail
+        default:
+            VP_RENDER_ASSERTMESSAGE("Invalid rule %d @ layer %d, state %d.", pRuleEntry->id, pSearchState->layer_number, pSearchState->state);
+            MT_ERR3(MT_VP_KERNEL_RULE, MT_VP_KERNEL_RULE_ID, pRuleEntry->id, MT_VP_KERNEL_RULE_LAYERNUM, pSearchState->layer_number, MT_VP_KERNEL_RULE_SEARCH_STATE, pSearchState->state);
+            break;
+        }  // End of switch to deal with all matching rule IDs
 
-            case RID_IsDualOutput:
-                if (pSearchState->pFilter->dualout == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+        // Rule didn't match - try another RuleSet
+        break;
+    }  // End of file loop to test all rules for the current RuleSet
 
-            case RID_IsTargetFormat:
-                if (pRuleEntry->logic == Kdll_Or && bTargetFormatMatched)
-                {
-                    // Already found matching format in the ruleset
-                    continue;
-                }
-                else
-                {
-                    if (pSearchState->target_format == (MOS_FORMAT)pRuleEntry->value)
-                    {
-                        bTargetFormatMatched = true;
-                    }
+    return (iMatchCount == 0);
+}
 
-                    if (pRuleEntry->logic == Kdll_None && !bTargetFormatMatched)
-                    {
-                        // Last entry and No matching format was found
-                        break;
-                    }
-                    else
-                    {
-                        continue;
-                    }
-                }
+/*----------------------------------------------------------------------------
+| Name      : KernelDll_FindRule
+| Purpose   : Find a rule that matches the current search/input state
+|
+| Input     : pState       - Kernel Dll state
+|             pSearchState - current DL search state
+|
+| Return    :
+\---------------------------------------------------------------------------*/
+bool KernelDll_FindRule(
+    Kdll_State *      pState,
+    Kdll_SearchState *pSearchState)
+{
+    uint32_t              parser_state = (uint32_t)pSearchState->state;
+    Kdll_RuleEntrySet *   pRuleSet;
+    Kdll_RuleIndex *      pIndex;
+    const uint16_t *      pCandidate;
+    int32_t               iRuleCount;
+    int32_t               format;
 
-            case RID_Is64BSaveEnabled:
-                if (pSearchState->b64BSaveEnabled == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+    VP_RENDER_FUNCTION_ENTER;
 
-            case RID_IsTargetTileType:
-                if (pRuleEntry->logic == Kdll_None &&
-                    pSearchState->target_tiletype == (MOS_TILE_TYPE)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else if (pRuleEntry->logic == Kdll_Not &&
-                         pSearchState->target_tiletype != (MOS_TILE_TYPE)pRuleEntry->value)
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+    // All Custom states are handled as a single group
+    if (parser_state >= Parser_Custom)
+    {
+        parser_state = Parser_Custom;
+    }
 
-            case RID_IsProcampEnabled:
-                if (pSearchState->bProcamp == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+    pRuleSet   = pState->pDllRuleTable[parser_state];
+    iRuleCount = pState->iDllRuleCount[parser_state];
 
-            case RID_IsConstOutAlpha:
-                if (pSearchState->pFilter->bFillOutputAlphaWithConstant == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
+    if (pRuleSet == nullptr || iRuleCount == 0)
+    {
+        VP_RENDER_NORMALMESSAGE("Search rules undefined.");
+        pSearchState->pMatchingRuleSet = nullptr;
+        return false;
+    }
 
-            case RID_IsDitherNeeded:
-                if (pSearchState->pFilter->bIsDitherNeeded == (pRuleEntry->value ? true : false))
-                {
-                    continue;
-                }
-                else
-                {
-                    break;
-                }
-            // Undefined search rule will fail
-            default:
-                VP_RENDER_ASSERTMESSAGE("Invalid rule %d @ layer %d, state %d.", pRuleEntry->id, pSearchState->layer_number, pSearchState->state);
-                MT_ERR3(MT_VP_KERNEL_RULE, MT_VP_KERNEL_RULE_ID, pRuleEntry->id, MT_VP_KERNEL_RULE_LAYERNUM, pSearchState->layer_number, MT_VP_KERNEL_RULE_SEARCH_STATE, pSearchState->state);
-                break;
-            }  // End of switch to deal with all matching rule IDs
+    // Only try the rule sets which may match the current format
+    pIndex = &pState->RuleIndex[parser_state];
+    format = Format_Invalid;
+    if (pIndex->pStart)
+    {
+        if (pIndex->id == RID_IsSrc0Format)
+        {
+            format = pSearchState->src0_format;
+        }
+        else if (pIndex->id == RID_IsSrc1Format)
+        {
+            format = pSearchState->src1_format;
+        }
+        else if (pSearchState->pFilter)
+        {
+            format = pSearchState->pFilter->format;
+        }
+    }
 
-            // Rule didn't match - try another RuleSet
-            break;
-        }  // End of file loop to test all rules for the current RuleSet
+    if (format >= Format_None && format < Format_Count)
+    {
+        format -= Format_None;
+        pCandidate = pIndex->pList + pIndex->pStart[format];
+        iRuleCount = pIndex->pStart[format + 1] - pIndex->pStart[format];
 
-        // Match
-        if (iMatchCount == 0)
+        for (; iRuleCount > 0; iRuleCount--, pCandidate++)
+        {
+            if (KernelDll_MatchRuleSet(pSearchState, pRuleSet + *pCandidate))
+            {
+                pSearchState->pMatchingRuleSet = pRuleSet + *pCandidate;
+                return true;
+            }
+        }
+    }
+    else
+    {
+        // Search matching entry
+        for (; iRuleCount > 0; iRuleCount--, pRuleSet++)
         {
-            pSearchState->pMatchingRuleSet = pRuleSet;
-            return true;
+            if (KernelDll_MatchRuleSet(pSearchState, pRuleSet))
+            {
+                pSearchState->pMatchingRuleSet = pRuleSet;
+                return true;
+            }
         }
-    }  // End of for loop to test all RuleSets for the current parser state
+    }
 
     // Failed to find a matching rule -> kernel search will fail
     VP_RENDER_NORMALMESSAGE("Fail to find a matching rule @ layer %d, state %d.", pSearchState->layer_number, pSearchState->state);
@@ -3073,6 +3128,159 @@ bool KernelDll_UpdateState(
     return true;
 }
 
+//--------------------------------------------------------------
+// KernelDll_MayMatchFormat - Check if a format rule matches a format for any color space
+//--------------------------------------------------------------
+static bool KernelDll_MayMatchFormat(MOS_FORMAT format, MOS_FORMAT match)
+{
+    // Palettized formats are generic RGB or PA depending on the color space
+    if (IS_PAL_FORMAT(format) && (match == Format_RGB || match == Format_PA))
+    {
+        return true;
+    }
+
+    return KernelDll_IsFormat(format, CSpace_None, match);
+}
+
+//--------------------------------------------------------------
+// KernelDll_RuleSetMayMatchFormat - Replay the format rules of a rule set as
+//                                   KernelDll_MatchRuleSet does for a given format
+//--------------------------------------------------------------
+static bool KernelDll_RuleSetMayMatchFormat(
+    const Kdll_RuleEntrySet *pRuleSet,
+    Kdll_RuleID              id,
+    MOS_FORMAT               format)
+{
+    const Kdll_RuleEntry *pRuleEntry = pRuleSet->pRuleEntry;
+    bool                  bMatched   = false;
+    int32_t               i;
+
+    for (i = pRuleSet->iMatchCount; i > 0; i--, pRuleEntry++)
+    {
+        if (pRuleEntry->id != id ||
+            (pRuleEntry->logic == Kdll_Or && bMatched))
+        {
+            continue;
+        }
+
+        if (KernelDll_MayMatchFormat(format, (MOS_FORMAT)pRuleEntry->value))
+        {
+            bMatched = true;
+        }
+
+        if (pRuleEntry->logic == Kdll_None && !bMatched)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_ReleaseRuleIndex - Release format index of the rule table
+//--------------------------------------------------------------
+static void KernelDll_ReleaseRuleIndex(Kdll_State *pState)
+{
+    int32_t i;
+
+    for (i = 0; i < Parser_Count; i++)
+    {
+        MOS_FreeMemory(pState->RuleIndex[i].pStart);
+    }
+    MOS_ZeroMemory(pState->RuleIndex, sizeof(pState->RuleIndex));
+}
+
+//-----------------------------------------------------------------------------------------
+// KernelDll_BuildRuleIndex - Index the rule sets of each parser state by format
+//
+//    Parser states testing the Src0, Src1 or layer format get, for every format, the list
+//    of rule sets whose format rules may match it, in table order. Rule sets left out
+//    fail for that format whatever the rest of the search state, so searching only the
+//    candidates finds the same first match as searching the whole table.
+//
+// Parameters:
+//    Kdll_State *pState - [in/out] Kernel Dll state with sorted rule table
+//
+// Output: none, states without index are searched linearly
+//-----------------------------------------------------------------------------------------
+static void KernelDll_BuildRuleIndex(Kdll_State *pState)
+{
+    const Kdll_RuleID     keys[] = {RID_IsSrc0Format, RID_IsSrc1Format, RID_IsLayerFormat};
+    int32_t               iKeyCount[sizeof(keys) / sizeof(keys[0])];
+    Kdll_RuleIndex *      pIndex;
+    Kdll_RuleEntrySet *   pRuleSet;
+    const Kdll_RuleEntry *pRuleEntry;
+    uint32_t              n;
+    int32_t               state, format, i, j, k;
+
+    KernelDll_ReleaseRuleIndex(pState);
+
+    for (state = 0; state < Parser_Count; state++)
+    {
+        pIndex     = &pState->RuleIndex[state];
+        pIndex->id = RID_Op_EOF;
+        pRuleSet   = pState->pDllRuleTable[state];
+
+        if (!pRuleSet || pState->iDllRuleCount[state] == 0)
+        {
+            continue;
+        }
+
+        // Key the state on its most used format rule
+        MOS_ZeroMemory(iKeyCount, sizeof(iKeyCount));
+        for (i = 0; i < pState->iDllRuleCount[state]; i++)
+        {
+            pRuleEntry = pRuleSet[i].pRuleEntry;
+            for (j = pRuleSet[i].iMatchCount; j > 0; j--, pRuleEntry++)
+            {
+                for (k = 0; k < (int32_t)(sizeof(keys) / sizeof(keys[0])); k++)
+                {
+                    iKeyCount[k] += (pRuleEntry->id == keys[k]);
+                }
+            }
+        }
+
+        for (j = 0, k = 0; k < (int32_t)(sizeof(keys) / sizeof(keys[0])); k++)
+        {
+            if (iKeyCount[k] > j)
+            {
+                j          = iKeyCount[k];
+                pIndex->id = keys[k];
+            }
+        }
+
+        if (pIndex->id == RID_Op_EOF)
+        {
+            continue;
+        }
+
+        pIndex->pStart = (uint32_t *)MOS_AllocAndZeroMemory(
+            (DL_RULE_INDEX_FORMATS + 1) * sizeof(uint32_t) +
+            DL_RULE_INDEX_FORMATS * pState->iDllRuleCount[state] * sizeof(uint16_t));
+        if (!pIndex->pStart)
+        {
+            VP_RENDER_NORMALMESSAGE("Failed to allocate rule index, state %d searched linearly.", state);
+            pIndex->id = RID_Op_EOF;
+            continue;
+        }
+        pIndex->pList = (uint16_t *)(pIndex->pStart + DL_RULE_INDEX_FORMATS + 1);
+
+        for (n = 0, format = 0; format < DL_RULE_INDEX_FORMATS; format++)
+        {
+            pIndex->pStart[format] = n;
+            for (i = 0; i < pState->iDllRuleCount[state]; i++)
+            {
+                if (KernelDll_RuleSetMayMatchFormat(&pRuleSet[i], pIndex->id, (MOS_FORMAT)(format + Format_None)))
+                {
+                    pIndex->pList[n++] = (uint16_t)i;
+                }
+            }
+        }
+        pIndex->pStart[format] = n;
+    }
+}
+
 //-----------------------------------------------------------------------------------------
 // KernelDll_SortRuleTable - Sort master dynamic linking rule table
 //
@@ -3102,6 +3310,7 @@ bool KernelDll_SortRuleTable(Kdll_State *pState)
     {
         MOS_FreeMemory(pState->pSortedRules);
         pState->pSortedRules = nullptr;
+        KernelDll_ReleaseRuleIndex(pState);
 
         MOS_ZeroMemory(pState->pDllRuleTable, sizeof(pState->pDllRuleTable));
         MOS_ZeroMemory(pState->iDllRuleCount, sizeof(pState->iDllRuleCount));
@@ -3318,6 +3527,7 @@ bool KernelDll_SortRuleTable(Kdll_State *pState)
     }
 
     // Rule table is now sorted and integrated with custom rules
+    KernelDll_BuildRuleIndex(pState);
     return true;
 }
 
@@ -3612,6 +3822,7 @@ cleanup:
     {
         MOS_FreeMemory(pState->pSortedRules);
         pState->pSortedRules = nullptr;
+        KernelDll_ReleaseRuleIndex(pState);
     }
 
     // Free DL States and temporary sort buffers
@@ -3656,10 +3867,14 @@ void KernelDll_ReleaseStates(Kdll_State *pState)
 
     if (!pState)
         return;
+    KernelDll_SavePersistentCache(pState);
+    MOS_FreeMemory(pState->pPersistentCache);
+    MOS_FreeMemory(pState->pPersistentCachePath);
     KernelDll_ReleaseAdditionalCacheEntries(&pState->KernelCache);
     MOS_FreeMemory(pState->ComponentKernelCache.pCache);
     MOS_FreeMemory(pState->CmFcPatchCache.pCache);
     MOS_FreeMemory(pState->pSortedRules);
+    KernelDll_ReleaseRuleIndex(pState);
     MOS_FreeMemory(pState);
 }
 
@@ -4217,14 +4432,19 @@ KernelDll_AllocateAdditionalCacheEntries(Kdll_KernelCache *pCache)
 }
 
 //--------------------------------------------------------------
-// KernelDll_AddKernel - Add kernel into hash table and kernel cache
+// KernelDll_InsertKernel - Insert linked kernel into hash table and kernel cache
 //--------------------------------------------------------------
-Kdll_CacheEntry *
-KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
-                    Kdll_SearchState *pSearchState,     // Search state
-                    Kdll_FilterEntry *pFilter,          // Original filter
-                    int32_t           iFilterSize,      // Original filter size
-                    uint32_t          dwHash)
+static Kdll_CacheEntry *
+KernelDll_InsertKernel(Kdll_State             *pState,            // Kernel Dll state
+                       const uint8_t          *pKernel,           // Linked kernel
+                       int32_t                 iKernelSize,       // Linked kernel size
+                       const Kdll_FilterEntry *pModFilter,        // Modified filter
+                       int32_t                 iModFilterSize,    // Modified filter size
+                       const Kdll_CSC_Params  *pCscParams,        // CSC parameters
+                       VPHAL_CSPACE            colorfill_cspace,  // Intermediate color space for colorfill
+                       Kdll_FilterEntry       *pFilter,           // Original filter
+                       int32_t                 iFilterSize,       // Original filter size
+                       uint32_t                dwHash)
 {
     Kdll_CacheEntry      *pCacheEntry;
     Kdll_KernelHashTable *pHashTable;
@@ -4233,23 +4453,15 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     int32_t size;
     uint8_t *ptr;
 
-    VP_RENDER_FUNCTION_ENTER;
-
-    // Check kernel
-    if (pSearchState->KernelSize <= 0)
-    {
-        return nullptr;
-    }
-
     // Get hash table
     pHashTable = &pState->KernelHashTable;
     pHashEntry = &pHashTable->HashEntry[0] - 1;  // all indices are 1 based (0 = null)
 
     // allocate space in kernel cache to store the kernel, filter, CSC parameters
-    size  = pSearchState->KernelSize +                                  // Kernel
-            pSearchState->iFilterSize * sizeof(Kdll_FilterEntry) * 2 +  // Original + Modified Filter
-            sizeof(Kdll_CSC_Params) +                                   // CSC parameters
-            sizeof(VPHAL_CSPACE);                                       // Intermediate Color Space for colorfill
+    size  = iKernelSize +                                   // Kernel
+            iModFilterSize * sizeof(Kdll_FilterEntry) * 2 + // Original + Modified Filter
+            sizeof(Kdll_CSC_Params) +                       // CSC parameters
+            sizeof(VPHAL_CSPACE);                           // Intermediate Color Space for colorfill
 
     // Run garbage collection, create space for new kernel and metadata
     KernelDll_GarbageCollection(pState, size);
@@ -4278,22 +4490,22 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     pCacheEntry->wHashEntry  = entry;
 
     // Save kernel
-    pCacheEntry->iSize = pSearchState->KernelSize;
-    MOS_SecureMemcpy(pCacheEntry->pBinary, pSearchState->KernelSize, (void *)pSearchState->Kernel, pSearchState->KernelSize);
-    ptr = pCacheEntry->pBinary + pSearchState->KernelSize;
+    pCacheEntry->iSize = iKernelSize;
+    MOS_SecureMemcpy(pCacheEntry->pBinary, iKernelSize, (void *)pKernel, iKernelSize);
+    ptr = pCacheEntry->pBinary + iKernelSize;
 
     // Save modified filter
-    pCacheEntry->iFilterSize = pSearchState->iFilterSize;
+    pCacheEntry->iFilterSize = iModFilterSize;
     pCacheEntry->pFilter     = (Kdll_FilterEntry *) (ptr);
-    MOS_SecureMemcpy(ptr, pSearchState->iFilterSize * sizeof(Kdll_FilterEntry), (void *)pSearchState->Filter, pSearchState->iFilterSize * sizeof(Kdll_FilterEntry));
-    ptr += pSearchState->iFilterSize * sizeof(Kdll_FilterEntry);
+    MOS_SecureMemcpy(ptr, iModFilterSize * sizeof(Kdll_FilterEntry), (void *)pModFilter, iModFilterSize * sizeof(Kdll_FilterEntry));
+    ptr += iModFilterSize * sizeof(Kdll_FilterEntry);
 
     // Save CSC parameters associated with the kernel
     pCacheEntry->pCscParams = (Kdll_CSC_Params *) (ptr);
-    MOS_SecureMemcpy(ptr, sizeof(Kdll_CSC_Params), (void *)&pSearchState->CscParams, sizeof(Kdll_CSC_Params));
+    MOS_SecureMemcpy(ptr, sizeof(Kdll_CSC_Params), (void *)pCscParams, sizeof(Kdll_CSC_Params));
     ptr += sizeof(Kdll_CSC_Params);
     // Save intermediate color space for colorfill
-    pCacheEntry->colorfill_cspace = pState->colorfill_cspace;
+    pCacheEntry->colorfill_cspace = colorfill_cspace;
     ptr += sizeof(VPHAL_CSPACE);
 
     // increment KCID (Range = 0x00010000 - 0x7fffffff)
@@ -4311,6 +4523,366 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     return pCacheEntry;
 }
 
+//--------------------------------------------------------------
+// KernelDll_AddPersistentKernel - Append linked kernel to the persistent cache records
+//--------------------------------------------------------------
+static void KernelDll_AddPersistentKernel(
+    Kdll_State       *pState,
+    Kdll_CacheEntry  *pCacheEntry,
+    Kdll_FilterEntry *pFilter,
+    int32_t           iFilterSize,
+    uint32_t          dwHash)
+{
+    Kdll_PersistentCacheRecord *pRecord;
+    Kdll_CSC_Matrix            *pMatrix;
+    uint8_t                    *pNewCache;
+    uint8_t                    *ptr;
+    int32_t                     size, maxSize;
+    int32_t                     i;
+
+    if (pState->iPersistentCacheCount >= DL_PERSISTENT_CACHE_MAX_KERNELS)
+    {
+        return;
+    }
+
+    // CSC coefficients with procamp depend on procamp values which are only
+    // versioned within the process, such kernels are never shared
+    pMatrix = pCacheEntry->pCscParams->Matrix;
+    for (i = 0; i < DL_CSC_MAX; i++, pMatrix++)
+    {
+        if (pMatrix->bInUse && pMatrix->iProcampID != DL_PROCAMP_DISABLED)
+        {
+            return;
+        }
+    }
+
+    size = sizeof(Kdll_PersistentCacheRecord) +
+           (iFilterSize + pCacheEntry->iFilterSize) * sizeof(Kdll_FilterEntry) +
+           pCacheEntry->iSize;
+    size = MOS_ALIGN_CEIL(size, 8);
+
+    if (pState->iPersistentCacheSize + size > pState->iPersistentCacheMaxSize)
+    {
+        maxSize   = MOS_MAX(pState->iPersistentCacheMaxSize * 2, pState->iPersistentCacheSize + size);
+        pNewCache = (uint8_t *)MOS_AllocAndZeroMemory(maxSize);
+        if (!pNewCache)
+        {
+            return;
+        }
+        if (pState->pPersistentCache)
+        {
+            MOS_SecureMemcpy(pNewCache, maxSize, pState->pPersistentCache, pState->iPersistentCacheSize);
+            MOS_FreeMemory(pState->pPersistentCache);
+        }
+        pState->pPersistentCache        = pNewCache;
+        pState->iPersistentCacheMaxSize = maxSize;
+    }
+
+    ptr     = pState->pPersistentCache + pState->iPersistentCacheSize;
+    pRecord = (Kdll_PersistentCacheRecord *)ptr;
+    MOS_ZeroMemory(ptr, size);
+
+    pRecord->dwSize           = size;
+    pRecord->dwHash           = dwHash;
+    pRecord->iFilter          = iFilterSize;
+    pRecord->iFilterSize      = pCacheEntry->iFilterSize;
+    pRecord->iKernelSize      = pCacheEntry->iSize;
+    pRecord->colorfill_cspace = pCacheEntry->colorfill_cspace;
+    pRecord->CscParams        = *pCacheEntry->pCscParams;
+    ptr += sizeof(Kdll_PersistentCacheRecord);
+
+    MOS_SecureMemcpy(ptr, iFilterSize * sizeof(Kdll_FilterEntry), pFilter, iFilterSize * sizeof(Kdll_FilterEntry));
+    ptr += iFilterSize * sizeof(Kdll_FilterEntry);
+    MOS_SecureMemcpy(ptr, pCacheEntry->iFilterSize * sizeof(Kdll_FilterEntry), pCacheEntry->pFilter, pCacheEntry->iFilterSize * sizeof(Kdll_FilterEntry));
+    ptr += pCacheEntry->iFilterSize * sizeof(Kdll_FilterEntry);
+    MOS_SecureMemcpy(ptr, pCacheEntry->iSize, pCacheEntry->pBinary, pCacheEntry->iSize);
+
+    pState->iPersistentCacheSize += size;
+    pState->iPersistentCacheCount++;
+    pState->bPersistentCacheDirty = true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_GetPersistentKernel - Load combined kernel from the persistent cache records
+//--------------------------------------------------------------
+static Kdll_CacheEntry *KernelDll_GetPersistentKernel(
+    Kdll_State       *pState,
+    Kdll_FilterEntry *pFilter,
+    int32_t           iFilterSize,
+    uint32_t          dwHash)
+{
+    Kdll_PersistentCacheRecord *pRecord;
+    Kdll_FilterEntry           *pRecordFilter;
+    Kdll_CacheEntry            *pCacheEntry;
+    uint8_t                    *ptr = pState->pPersistentCache;
+    int32_t                     i;
+
+    for (i = 0; i < pState->iPersistentCacheCount; i++, ptr += pRecord->dwSize)
+    {
+        pRecord       = (Kdll_PersistentCacheRecord *)ptr;
+        pRecordFilter = (Kdll_FilterEntry *)(pRecord + 1);
+
+        if (pRecord->dwHash  != dwHash ||
+            pRecord->iFilter != iFilterSize ||
+            memcmp(pRecordFilter, pFilter, iFilterSize * sizeof(Kdll_FilterEntry)) != 0)
+        {
+            continue;
+        }
+
+        pCacheEntry = KernelDll_InsertKernel(
+            pState,
+            (uint8_t *)(pRecordFilter + pRecord->iFilter + pRecord->iFilterSize),
+            pRecord->iKernelSize,
+            pRecordFilter + pRecord->iFilter,
+            pRecord->iFilterSize,
+            &pRecord->CscParams,
+            pRecord->colorfill_cspace,
+            pFilter,
+            iFilterSize,
+            dwHash);
+
+        if (pCacheEntry)
+        {
+            pState->colorfill_cspace = pRecord->colorfill_cspace;
+            VP_RENDER_NORMALMESSAGE("Use kernel from persistent cache.");
+        }
+        return pCacheEntry;
+    }
+
+    return nullptr;
+}
+
+//--------------------------------------------------------------
+// KernelDll_GetPersistentCacheKey - Hash everything the combined kernels are derived from
+//--------------------------------------------------------------
+static uint32_t KernelDll_GetPersistentCacheKey(Kdll_State *pState)
+{
+    Kdll_RuleEntrySet *pRuleSet;
+    uint32_t           key;
+    int32_t            i, j;
+
+    // Component kernels are platform specific, so they also identify the platform
+    key = KernelDll_SimpleHash(pState->ComponentKernelCache.pCache, pState->ComponentKernelCache.iCacheSize);
+
+    if (pState->bEnableCMFC)
+    {
+        key = (key * 0x1000193) ^ KernelDll_SimpleHash(pState->CmFcPatchCache.pCache, pState->CmFcPatchCache.iCacheSize);
+    }
+
+    for (i = 0; i < Parser_Count; i++)
+    {
+        pRuleSet = pState->pDllRuleTable[i];
+        for (j = 0; pRuleSet && j < pState->iDllRuleCount[i]; j++, pRuleSet++)
+        {
+            key = (key * 0x1000193) ^ KernelDll_SimpleHash((void *)pRuleSet->pRuleEntry,
+                                          (pRuleSet->iMatchCount + pRuleSet->iSetCount) * sizeof(Kdll_RuleEntry));
+        }
+    }
+
+    return key;
+}
+
+//---------------------------------------------------------------------------------------
+// KernelDll_OpenPersistentCache - Enable the persistent combined kernel cache
+//
+//    Combined kernels linked by earlier processes are loaded from the file, so the first
+//    frames of a new process skip the rule search and linking. The file is rejected as a
+//    whole if it was written for different component kernels, rules or record layout, or
+//    if its checksum does not match.
+//
+// Parameters:
+//    Kdll_State *pState - [in/out] Kernel dll state
+//    const char *pcPath - [in]     Cache file, nullptr to leave the cache disabled
+//
+// Output: true  - Persistent cache enabled (possibly empty)
+//         false - Persistent cache disabled
+//-----------------------------------------------------------------------------------------
+bool KernelDll_OpenPersistentCache(Kdll_State *pState, const char *pcPath)
+{
+    Kdll_PersistentCacheHeader  header;
+    Kdll_PersistentCacheRecord *pRecord;
+    FILE                       *pFile  = nullptr;
+    uint8_t                    *pCache = nullptr;
+    size_t                      len;
+    uint32_t                    offset = 0;
+    uint32_t                    i;
+
+    VP_RENDER_FUNCTION_ENTER;
+
+    if (!pState || !pcPath || pcPath[0] == '\0' || pState->pPersistentCachePath)
+    {
+        return false;
+    }
+
+    len = strlen(pcPath) + 1;
+    pState->pPersistentCachePath = (char *)MOS_AllocAndZeroMemory(len);
+    if (!pState->pPersistentCachePath)
+    {
+        return false;
+    }
+    MOS_SecureMemcpy(pState->pPersistentCachePath, len, pcPath, len);
+    pState->dwPersistentCacheKey = KernelDll_GetPersistentCacheKey(pState);
+
+    // No file yet, start with an empty cache
+    if (MosUtilities::MosSecureFileOpen(&pFile, pcPath, "rb") != MOS_STATUS_SUCCESS)
+    {
+        return true;
+    }
+
+    if (fread(&header, sizeof(header), 1, pFile) != 1                          ||
+        header.dwMagic   != DL_PERSISTENT_CACHE_MAGIC                          ||
+        header.dwVersion != DL_PERSISTENT_CACHE_VERSION                        ||
+        header.dwLayout  != (sizeof(Kdll_FilterEntry) | (sizeof(Kdll_CSC_Params) << 16)) ||
+        header.dwKey     != pState->dwPersistentCacheKey                       ||
+        header.dwCount   >  DL_PERSISTENT_CACHE_MAX_KERNELS                    ||
+        header.dwSize    >  DL_PERSISTENT_CACHE_MAX_KERNELS * DL_CACHE_BLOCK_SIZE)
+    {
+        goto discard;
+    }
+
+    pCache = (uint8_t *)MOS_AllocAndZeroMemory(MOS_MAX(header.dwSize, 1));
+    if (!pCache ||
+        fread(pCache, 1, header.dwSize, pFile) != header.dwSize ||
+        KernelDll_SimpleHash(pCache, header.dwSize) != header.dwChecksum)
+    {
+        goto discard;
+    }
+
+    // Validate record boundaries before any record is used
+    for (i = 0; i < header.dwCount; i++, offset += pRecord->dwSize)
+    {
+        pRecord = (Kdll_PersistentCacheRecord *)(pCache + offset);
+        if (header.dwSize - offset < sizeof(Kdll_PersistentCacheRecord) ||
+            pRecord->dwSize > header.dwSize - offset                     ||
+            (pRecord->dwSize & 7)                                        ||
+            pRecord->iFilter     < 0 || pRecord->iFilter     > DL_MAX_SEARCH_FILTER_SIZE ||
+            pRecord->iFilterSize < 0 || pRecord->iFilterSize > DL_MAX_SEARCH_FILTER_SIZE ||
+            pRecord->iKernelSize <= 0 || pRecord->iKernelSize > DL_MAX_KERNEL_SIZE       ||
+            sizeof(Kdll_PersistentCacheRecord) + (pRecord->iFilter + pRecord->iFilterSize) * sizeof(Kdll_FilterEntry) +
+                pRecord->iKernelSize > pRecord->dwSize)
+        {
+            goto discard;
+        }
+    }
+    if (offset != header.dwSize)
+    {
+        goto discard;
+    }
+
+    fclose(pFile);
+    pState->pPersistentCache        = pCache;
+    pState->iPersistentCacheSize    = header.dwSize;
+    pState->iPersistentCacheMaxSize = header.dwSize;
+    pState->iPersistentCacheCount   = header.dwCount;
+    VP_RENDER_NORMALMESSAGE("Loaded %d kernels from persistent cache %s.", header.dwCount, pcPath);
+    return true;
+
+discard:
+    // Stale or corrupted, replaced by the kernels of this process on release
+    VP_RENDER_NORMALMESSAGE("Discard persistent kernel cache %s.", pcPath);
+    fclose(pFile);
+    MOS_FreeMemory(pCache);
+    pState->bPersistentCacheDirty = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------
+// KernelDll_SavePersistentCache - Write combined kernels to the persistent cache file
+//
+//    The file is written under a temporary name and renamed over the cache file, so
+//    concurrent processes never see a partial file. The last process to save wins.
+//
+// Parameters:
+//    Kdll_State *pState - [in] Kernel dll state
+//
+// Output: true  - Cache file is up to date
+//         false - Failed to write the cache file
+//-----------------------------------------------------------------------------------------
+bool KernelDll_SavePersistentCache(Kdll_State *pState)
+{
+    Kdll_PersistentCacheHeader header;
+    FILE *pFile = nullptr;
+    char  tmpPath[MOS_MAX_PATH_LENGTH];
+    bool  res;
+
+    VP_RENDER_FUNCTION_ENTER;
+
+    if (!pState || !pState->pPersistentCachePath || !pState->bPersistentCacheDirty)
+    {
+        return true;
+    }
+
+    MOS_ZeroMemory(&header, sizeof(header));
+    header.dwMagic    = DL_PERSISTENT_CACHE_MAGIC;
+    header.dwVersion  = DL_PERSISTENT_CACHE_VERSION;
+    header.dwLayout   = sizeof(Kdll_FilterEntry) | (sizeof(Kdll_CSC_Params) << 16);
+    header.dwKey      = pState->dwPersistentCacheKey;
+    header.dwCount    = pState->iPersistentCacheCount;
+    header.dwSize     = pState->iPersistentCacheSize;
+    header.dwChecksum = KernelDll_SimpleHash(pState->pPersistentCache, pState->iPersistentCacheSize);
+
+    MOS_SecureStringPrint(tmpPath, sizeof(tmpPath), sizeof(tmpPath), "%s.%d", pState->pPersistentCachePath, MosUtilities::MosGetPid());
+    if (MosUtilities::MosSecureFileOpen(&pFile, tmpPath, "wb") != MOS_STATUS_SUCCESS)
+    {
+        VP_RENDER_NORMALMESSAGE("Failed to create persistent kernel cache %s.", tmpPath);
+        return false;
+    }
+
+    res = fwrite(&header, sizeof(header), 1, pFile) == 1 &&
+          (header.dwSize == 0 || fwrite(pState->pPersistentCache, header.dwSize, 1, pFile) == 1);
+    res = (fclose(pFile) == 0) && res;
+    res = res && (rename(tmpPath, pState->pPersistentCachePath) == 0);
+    if (!res)
+    {
+        VP_RENDER_NORMALMESSAGE("Failed to write persistent kernel cache %s.", pState->pPersistentCachePath);
+        remove(tmpPath);
+        return false;
+    }
+
+    pState->bPersistentCacheDirty = false;
+    return true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_AddKernel - Add kernel into hash table and kernel cache
+//--------------------------------------------------------------
+Kdll_CacheEntry *
+KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
+                    Kdll_SearchState *pSearchState,     // Search state
+                    Kdll_FilterEntry *pFilter,          // Original filter
+                    int32_t           iFilterSize,      // Original filter size
+                    uint32_t          dwHash)
+{
+    Kdll_CacheEntry *pCacheEntry;
+
+    VP_RENDER_FUNCTION_ENTER;
+
+    // Check kernel
+    if (pSearchState->KernelSize <= 0)
+    {
+        return nullptr;
+    }
+
+    pCacheEntry = KernelDll_InsertKernel(
+        pState,
+        pSearchState->Kernel,
+        pSearchState->KernelSize,
+        pSearchState->Filter,
+        pSearchState->iFilterSize,
+        &pSearchState->CscParams,
+        pState->colorfill_cspace,
+        pFilter,
+        iFilterSize,
+        dwHash);
+
+    if (pCacheEntry && pState->pPersistentCachePath)
+    {
+        KernelDll_AddPersistentKernel(pState, pCacheEntry, pFilter, iFilterSize, dwHash);
+    }
+
+    return pCacheEntry;
+}
+
 //--------------------------------------------------------------
 // KernelDll_ReleaseHashEntry - Release hash table entry
 //--------------------------------------------------------------
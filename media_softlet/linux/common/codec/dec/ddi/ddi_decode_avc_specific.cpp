@@ -396,27 +396,8 @@ VAStatus DdiDecodeAvc::AllocSliceParamContext(
 
     uint32_t baseSize = sizeof(CODEC_AVC_SLICE_PARAMS);
 
-    if (m_sliceParamBufNum < (m_decodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices                       = numSlices + 10;
-        m_decodeCtx->DecodeParams.m_sliceParams = realloc(m_decodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_decodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_decodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum),
-            0,
-            baseSize * extraSlices);
-
-        m_sliceParamBufNum += extraSlices;
-    }
-
-    return VA_STATUS_SUCCESS;
+    return GrowParamArray(&m_decodeCtx->DecodeParams.m_sliceParams, baseSize,
+        m_sliceParamBufNum, m_decodeCtx->DecodeParams.m_numSlices + numSlices);
 }
 
 VAStatus DdiDecodeAvc::RenderPicture(
@@ -622,7 +603,6 @@ VAStatus DdiDecodeAvc::AllocSliceControlBuffer(
 
     DDI_CODEC_COM_BUFFER_MGR *bufMgr   = nullptr;
     uint32_t                 availSize = 0;
-    uint32_t                 newSize   = 0;
 
     bufMgr    = &(m_decodeCtx->BufMgr);
     availSize = m_sliceCtrlBufNum - bufMgr->dwNumSliceControl;
@@ -631,14 +611,8 @@ VAStatus DdiDecodeAvc::AllocSliceControlBuffer(
     {
         if (availSize < buf->uiNumElements)
         {
-            newSize = sizeof(VASliceParameterBufferBase) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base = (VASliceParameterBufferBase *)realloc(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base, newSize);
-            if (bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferBase) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CODEC_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base, sizeof(VASliceParameterBufferBase),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
         }
         buf->pData    = (uint8_t*)bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264Base;
         buf->uiOffset = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferBase);
@@ -647,14 +621,8 @@ VAStatus DdiDecodeAvc::AllocSliceControlBuffer(
     {
         if (availSize < buf->uiNumElements)
         {
-            newSize = sizeof(VASliceParameterBufferH264) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 = (VASliceParameterBufferH264 *)realloc(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264, newSize);
-            if (bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264 + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferH264) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CODEC_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264, sizeof(VASliceParameterBufferH264),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
          }
          buf->pData    = (uint8_t*)bufMgr->Codec_Param.Codec_Param_H264.pVASliceParaBufH264;
          buf->uiOffset = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferH264);
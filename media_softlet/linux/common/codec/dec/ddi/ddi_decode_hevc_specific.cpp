@@ -948,37 +948,20 @@ VAStatus DdiDecodeHevc::AllocSliceParamContext(uint32_t numSlices)
 
     uint32_t baseSize = sizeof(CODEC_HEVC_SLICE_PARAMS);
 
-    if (m_sliceParamBufNum < (m_decodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices = numSlices + 10;
-
-        m_decodeCtx->DecodeParams.m_sliceParams = realloc(m_decodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_decodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_decodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum), 0, baseSize * extraSlices);
+    uint32_t required = m_decodeCtx->DecodeParams.m_numSlices + numSlices;
 
+    if (m_sliceParamBufNum < required)
+    {
+        // The rext array shares m_sliceParamBufNum and grows to the same capacity
         if (IsRextProfile())
         {
-            uint32_t rextSize = sizeof(CODEC_HEVC_EXT_SLICE_PARAMS);
-            m_decodeCtx->DecodeParams.m_extSliceParams = realloc(m_decodeCtx->DecodeParams.m_extSliceParams,
-            rextSize * (m_sliceParamBufNum + extraSlices));
-
-            if (m_decodeCtx->DecodeParams.m_extSliceParams == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-    
-            memset((void *)((uint8_t *)m_decodeCtx->DecodeParams.m_extSliceParams + rextSize * m_sliceParamBufNum), 0, rextSize * extraSlices);
+            uint32_t extCapacity = m_sliceParamBufNum;
+            DDI_CODEC_CHK_RET(GrowParamArray(&m_decodeCtx->DecodeParams.m_extSliceParams, sizeof(CODEC_HEVC_EXT_SLICE_PARAMS),
+                extCapacity, required), "Fail to grow ext slice params");
         }
-        
-        m_sliceParamBufNum += extraSlices;
+
+        DDI_CODEC_CHK_RET(GrowParamArray(&m_decodeCtx->DecodeParams.m_sliceParams, baseSize,
+            m_sliceParamBufNum, required), "Fail to grow slice params");
     }
 
     return VA_STATUS_SUCCESS;
@@ -1183,7 +1166,6 @@ VAStatus DdiDecodeHevc::AllocSliceControlBuffer(DDI_MEDIA_BUFFER *buf)
 
     DDI_CODEC_COM_BUFFER_MGR *bufMgr   = nullptr;
     uint32_t                 availSize = 0;
-    uint32_t                 newSize   = 0;
 
     bufMgr    = &(m_decodeCtx->BufMgr);
     availSize = m_sliceCtrlBufNum - bufMgr->dwNumSliceControl;
@@ -1198,14 +1180,8 @@ VAStatus DdiDecodeHevc::AllocSliceControlBuffer(DDI_MEDIA_BUFFER *buf)
             if (buf->iSize / buf->uiNumElements != sizeof(VASliceParameterBufferBase))
                 return VA_STATUS_ERROR_ALLOCATION_FAILED;
 
-            newSize = sizeof(VASliceParameterBufferBase) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-            bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC = (VASliceParameterBufferBase *)realloc(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC, newSize);
-            if (bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC == nullptr)
-            {
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferBase) * (buf->uiNumElements - availSize));
-            m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+            DDI_CODEC_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC, sizeof(VASliceParameterBufferBase),
+                m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
         }
         buf->pData    = (uint8_t*)bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufBaseHEVC;
         buf->uiOffset = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferBase);
@@ -1219,14 +1195,8 @@ VAStatus DdiDecodeHevc::AllocSliceControlBuffer(DDI_MEDIA_BUFFER *buf)
                 if (buf->iSize / buf->uiNumElements != sizeof(VASliceParameterBufferHEVC))
                     return VA_STATUS_ERROR_ALLOCATION_FAILED;
 
-                newSize = sizeof(VASliceParameterBufferHEVC) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-                bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC = (VASliceParameterBufferHEVC *)realloc(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC, newSize);
-                if (bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC == nullptr)
-                {
-                    return VA_STATUS_ERROR_ALLOCATION_FAILED;
-                }
-                MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC + m_sliceCtrlBufNum, sizeof(VASliceParameterBufferHEVC) * (buf->uiNumElements - availSize));
-                m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+                DDI_CODEC_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC, sizeof(VASliceParameterBufferHEVC),
+                    m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
             }
             buf->pData    = (uint8_t*)bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVC;
             buf->uiOffset = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferHEVC);
@@ -1238,14 +1208,8 @@ VAStatus DdiDecodeHevc::AllocSliceControlBuffer(DDI_MEDIA_BUFFER *buf)
                 if (buf->iSize / buf->uiNumElements != sizeof(VASliceParameterBufferHEVCExtension))
                     return VA_STATUS_ERROR_ALLOCATION_FAILED;
 
-                newSize = sizeof(VASliceParameterBufferHEVCExtension) * (m_sliceCtrlBufNum - availSize + buf->uiNumElements);
-                bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext= (VASliceParameterBufferHEVCExtension*)realloc(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext, newSize);
-                if (bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext == nullptr)
-                {
-                    return VA_STATUS_ERROR_ALLOCATION_FAILED;
-                }
-                MOS_ZeroMemory(bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext+ m_sliceCtrlBufNum, sizeof(VASliceParameterBufferHEVCExtension) * (buf->uiNumElements - availSize));
-                m_sliceCtrlBufNum = m_sliceCtrlBufNum - availSize + buf->uiNumElements;
+                DDI_CODEC_CHK_RET(GrowParamArray((void **)&bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext, sizeof(VASliceParameterBufferHEVCExtension),
+                    m_sliceCtrlBufNum, bufMgr->dwNumSliceControl + buf->uiNumElements), "Fail to grow slice control buffer");
             }
             buf->pData    = (uint8_t*)bufMgr->Codec_Param.Codec_Param_HEVC.pVASliceParaBufHEVCRext;
             buf->uiOffset = bufMgr->dwNumSliceControl * sizeof(VASliceParameterBufferHEVCExtension);
@@ -654,25 +654,8 @@ VAStatus DdiDecodeJpeg::AllocSliceParamContext(
 {
     uint32_t baseSize = sizeof(CodecDecodeJpegScanParameter);
 
-    if (m_sliceParamBufNum < (m_decodeCtx->DecodeParams.m_numSlices + numSlices))
-    {
-        // in order to avoid that the buffer is reallocated multi-times,
-        // extra 10 slices are added.
-        uint32_t extraSlices = numSlices + 10;
-
-        m_decodeCtx->DecodeParams.m_sliceParams = realloc(m_decodeCtx->DecodeParams.m_sliceParams,
-            baseSize * (m_sliceParamBufNum + extraSlices));
-
-        if (m_decodeCtx->DecodeParams.m_sliceParams == nullptr)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        memset((void *)((uint8_t *)m_decodeCtx->DecodeParams.m_sliceParams + baseSize * m_sliceParamBufNum), 0, baseSize * extraSlices);
-        m_sliceParamBufNum += extraSlices;
-    }
-
-    return VA_STATUS_SUCCESS;
+    return GrowParamArray(&m_decodeCtx->DecodeParams.m_sliceParams, baseSize,
+        m_sliceParamBufNum, m_decodeCtx->DecodeParams.m_numSlices + numSlices);
 }
 
 void DdiDecodeJpeg::DestroyContext(
@@ -703,23 +686,12 @@ VAStatus DdiDecodeJpeg::AllocBsBuffer(
     /* the pSliceData needs to be reallocated in order to contain more SliceDataBuf */
     if (index >= bufMgr->m_maxNumSliceData)
     {
-        /* In theroy it can resize the m_maxNumSliceData one by one. But in order to
-         * avoid calling realloc frequently, it will try to allocate 10 to  hold more
-         * SliceDataBuf. This is only for the optimized purpose.
-         */
-        int32_t reallocSize = bufMgr->m_maxNumSliceData + 10;
-
-        bufMgr->pSliceData = (DDI_CODEC_BITSTREAM_BUFFER_INFO *)realloc(bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]) * reallocSize);
-
-        if (bufMgr->pSliceData == nullptr)
+        if (GrowParamArray((void **)&bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]),
+                bufMgr->m_maxNumSliceData, index + 1) != VA_STATUS_SUCCESS)
         {
             DDI_CODEC_ASSERTMESSAGE("fail to reallocate pSliceData for JPEG\n.");
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
-        memset((void *)(bufMgr->pSliceData + bufMgr->m_maxNumSliceData), 0,
-               sizeof(bufMgr->pSliceData[0]) * 10);
-
-        bufMgr->m_maxNumSliceData += 10;
     }
 
     bsAddr = (uint8_t*)MOS_AllocAndZeroMemory(buf->iSize);
@@ -28,6 +28,8 @@
 #include "ddi_encode_base_specific.h"
 #include "media_libva_util_next.h"
 #include "media_libva_interface_next.h"
+#include "media_status_report.h"
+#include "ddi_encode_status_wait.h"
 namespace encode
 {
 
@@ -174,6 +176,7 @@ VAStatus DdiEncodeBase::StatusReport(
     int32_t  index        = 0;
     uint32_t status       = 0;
     uint32_t timeOutCount = 0;
+    bool     pollStatus   = false;
     VAStatus eStatus      = VA_STATUS_SUCCESS;
 
     // Get encoded frame information from status buffer queue.
@@ -253,6 +256,17 @@ VAStatus DdiEncodeBase::StatusReport(
         {
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
             uint32_t maxTimeOut                               = 100000;  //set max sleep times to 100000 = 1s, other wise return error.
+            if (!pollStatus)
+            {
+                VAStatus waitStatus = WaitStatusReportCompletion(mediaBuf, maxTimeOut * 10);
+                if (VA_STATUS_SUCCESS == waitStatus)
+                {
+                    continue;
+                }
+                // Report the timeout, or fall back to polling if the wait is not available
+                timeOutCount = (VA_STATUS_ERROR_TIMEDOUT == waitStatus) ? maxTimeOut : timeOutCount;
+                pollStatus   = true;
+            }
             if (timeOutCount < maxTimeOut)
             {
                 //sleep 10 us to wait encode complete, it won't impact the performance.
@@ -296,6 +310,31 @@ VAStatus DdiEncodeBase::StatusReport(
     return VA_STATUS_SUCCESS;
 }
 
+VAStatus DdiEncodeBase::WaitStatusReportCompletion(DDI_MEDIA_BUFFER *mediaBuf, uint32_t timeoutUs)
+{
+    DDI_CODEC_CHK_NULL(m_encodeCtx->pCodecHal, "Null m_encodeCtx->pCodecHal", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CODEC_CHK_NULL(mediaBuf, "Null mediaBuf", VA_STATUS_ERROR_INVALID_BUFFER);
+
+    MediaStatusReport *statusReport = m_encodeCtx->pCodecHal->GetStatusReportInstance();
+    if (statusReport == nullptr)
+    {
+        return VA_STATUS_ERROR_UNIMPLEMENTED;
+    }
+    PMOS_RESOURCE completedCountBuf = statusReport->GetCompletedCountResource();
+    if (completedCountBuf == nullptr || completedCountBuf->bo == nullptr)
+    {
+        return VA_STATUS_ERROR_UNIMPLEMENTED;
+    }
+
+    return encode::WaitStatusReportCompletion(
+        *statusReport,
+        [completedCountBuf](int64_t timeoutNs) { return mos_gem_bo_wait(completedCountBuf->bo, timeoutNs); },
+        [mediaBuf](int64_t timeoutNs) { return mediaBuf->bo ? mos_gem_bo_wait(mediaBuf->bo, timeoutNs) : -EINVAL; },
+        timeoutUs,
+        m_statusWaitSliceUs,
+        m_statusPollUs);
+}
+
 VAStatus DdiEncodeBase::EncStatusReport(
     DDI_MEDIA_BUFFER    *mediaBuf,
     void                **buf)
@@ -308,6 +347,7 @@ VAStatus DdiEncodeBase::EncStatusReport(
     uint32_t maxTimeOut   = 500000;  //set max sleep times to 500000 = 5s, other wise return error.
     uint32_t sleepTime    = 10;  //sleep 10 us when encode is not complete.
     uint32_t timeOutCount = 0;
+    bool     pollStatus   = false;
 
     //when this function is called, there must be a frame is ready, will wait until get the right information.
     while (1)
@@ -329,6 +369,16 @@ VAStatus DdiEncodeBase::EncStatusReport(
         else if (CODECHAL_STATUS_INCOMPLETE == encodeStatusReportData[0].codecStatus)
         {
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
+            if (!pollStatus)
+            {
+                VAStatus waitStatus = WaitStatusReportCompletion(mediaBuf, maxTimeOut * sleepTime);
+                if (VA_STATUS_SUCCESS == waitStatus)
+                {
+                    continue;
+                }
+                timeOutCount = (VA_STATUS_ERROR_TIMEDOUT == waitStatus) ? maxTimeOut : timeOutCount;
+                pollStatus   = true;
+            }
             if (timeOutCount < maxTimeOut)
             {
                 //sleep 10 us to wait encode complete, it won't impact the performance.
@@ -552,6 +552,24 @@ protected:
         uint32_t                       *status,
         int32_t                        *index);
 
+    //!
+    //! \brief    Wait for the GPU to complete the next pending status report
+    //! \details  Blocks on the completion counter buffer of the codec status report
+    //!           while a single frame is pending, and on the buffer of the queried
+    //!           frame while more are queued, see encode::WaitStatusReportCompletion.
+    //!
+    //! \param    [in] mediaBuf
+    //!           Buffer of the queried frame
+    //! \param    [in] timeoutUs
+    //!           Max time to wait in microseconds
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if the report is completed,
+    //!           VA_STATUS_ERROR_TIMEDOUT if it is not completed within timeoutUs,
+    //!           VA_STATUS_ERROR_UNIMPLEMENTED if the caller should poll instead
+    //!
+    VAStatus WaitStatusReportCompletion(DDI_MEDIA_BUFFER *mediaBuf, uint32_t timeoutUs);
+
     //!
     //! \brief    Report extra encode status for completed coded buffer.
     //!
@@ -586,6 +604,9 @@ protected:
     uint8_t m_scalingLists4x4[6][16]{};          //!< Inverse quantization scale lists 4x4.
     uint8_t m_scalingLists8x8[2][64]{};          //!< Inverse quantization scale lists 8x8
 
+    static const uint32_t m_statusWaitSliceUs = 1000;  //!< Max time of one blocking wait on the status report or frame buffer
+    static const uint32_t m_statusPollUs      = 10;    //!< Poll interval once the queried frame buffer is idle
+
 MEDIA_CLASS_DEFINE_END(encode__DdiEncodeBase)
 };
 
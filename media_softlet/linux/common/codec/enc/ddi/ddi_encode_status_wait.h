@@ -0,0 +1,113 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_encode_status_wait.h
+//! \brief    Wait policy for pending encode status reports
+//!
+
+#ifndef __DDI_ENCODE_STATUS_WAIT_H__
+#define __DDI_ENCODE_STATUS_WAIT_H__
+
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <va/va.h>
+
+namespace encode
+{
+//!
+//! \brief    Wait for the next pending status report to complete
+//! \details  The completion counter buffer is referenced by every frame in flight
+//!           and only goes idle once the last of them completes. With a single
+//!           frame pending the wait blocks on the buffer in slices of sliceUs. With
+//!           more frames queued it blocks on the buffer of the queried frame
+//!           instead, then the report is polled every pollUs until it lands.
+//!
+//! \param    [in] statusReport
+//!           Provides IsNextReportCompleted, GetSubmittedCount and GetReportedCount
+//! \param    [in] boWait
+//!           Callable taking a timeout in ns, returns 0 once the counter buffer is idle
+//! \param    [in] frameWait
+//!           Callable taking a timeout in ns, returns 0 once the buffer of the queried
+//!           frame is idle, -ETIME if it is still busy, other errors to poll instead
+//! \param    [in] timeoutUs
+//!           Max time to wait in microseconds
+//! \param    [in] sliceUs
+//!           Max time of one blocking wait
+//! \param    [in] pollUs
+//!           Sleep time between two checks once the queried frame buffer is idle
+//!
+//! \return   VAStatus
+//!           VA_STATUS_SUCCESS if the report is completed,
+//!           VA_STATUS_ERROR_TIMEDOUT if it is not completed within timeoutUs,
+//!           VA_STATUS_ERROR_UNIMPLEMENTED if the caller should poll instead
+//!
+template <typename StatusReport, typename BoWait, typename FrameWait>
+VAStatus WaitStatusReportCompletion(
+    const StatusReport &statusReport,
+    BoWait            &&boWait,
+    FrameWait         &&frameWait,
+    uint32_t            timeoutUs,
+    uint32_t            sliceUs,
+    uint32_t            pollUs)
+{
+    uint32_t waitedUs  = 0;
+    bool     frameIdle = false;
+    while (!statusReport.IsNextReportCompleted())
+    {
+        if (waitedUs >= timeoutUs)
+        {
+            return VA_STATUS_ERROR_TIMEDOUT;
+        }
+
+        uint32_t waitUs = (sliceUs < timeoutUs - waitedUs) ? sliceUs : timeoutUs - waitedUs;
+        if (statusReport.GetSubmittedCount() - statusReport.GetReportedCount() > 1)
+        {
+            if (!frameIdle)
+            {
+                if (-ETIME == frameWait((int64_t)waitUs * 1000))
+                {
+                    waitedUs += waitUs;
+                    continue;
+                }
+                // Recheck the report, it is written right after the frame buffer
+                frameIdle = true;
+                continue;
+            }
+            usleep(pollUs);
+            waitedUs += pollUs;
+            continue;
+        }
+
+        if (0 == boWait((int64_t)waitUs * 1000))
+        {
+            // No GPU work left on the buffer, the status is not coming from it
+            return statusReport.IsNextReportCompleted() ? VA_STATUS_SUCCESS : VA_STATUS_ERROR_UNIMPLEMENTED;
+        }
+        waitedUs += waitUs;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+}  // namespace encode
+
+#endif  // __DDI_ENCODE_STATUS_WAIT_H__
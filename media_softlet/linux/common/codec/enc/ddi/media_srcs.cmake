@@ -32,6 +32,7 @@ set(TMP_SOURCES_
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_functions.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_base_specific.h
+    ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_status_wait.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_hevc_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_av1_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_vp9_specific.h
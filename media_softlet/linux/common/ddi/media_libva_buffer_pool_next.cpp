@@ -0,0 +1,154 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_buffer_pool_next.cpp
+//! \brief    Recycling pool for linear VA buffers
+//!
+
+#include "media_libva_buffer_pool_next.h"
+#include "media_libva_util_next.h"
+
+MediaLibvaBufferPoolNext::MediaLibvaBufferPoolNext(GMM_CLIENT_CONTEXT *gmmClientContext)
+    : m_gmmClientContext(gmmClientContext)
+{
+    MediaLibvaUtilNext::InitMutex(&m_mutex);
+    m_entries.reserve(m_maxEntries + 1);
+}
+
+MediaLibvaBufferPoolNext::~MediaLibvaBufferPoolNext()
+{
+    Clear();
+    MediaLibvaUtilNext::DestroyMutex(&m_mutex);
+}
+
+uint32_t MediaLibvaBufferPoolNext::GetAllocSize(uint32_t size)
+{
+    if (size == 0 || size > m_maxBufferSize)
+    {
+        return size;
+    }
+
+    // Four size classes per power of two, as the bufmgr BO cache buckets
+    uint32_t allocSize = MOS_ALIGN_CEIL(size, m_pageSize);
+    uint32_t pow2      = m_pageSize;
+    while (pow2 * 2 < allocSize)
+    {
+        pow2 <<= 1;
+    }
+
+    return MOS_ALIGN_CEIL(allocSize, MOS_MAX(pow2 / 4, m_pageSize));
+}
+
+MOS_LINUX_BO *MediaLibvaBufferPoolNext::Acquire(
+    uint32_t           type,
+    bool               sysGfxMem,
+    uint32_t           size,
+    GMM_RESOURCE_INFO **gmmResourceInfo)
+{
+    DDI_CHK_NULL(gmmResourceInfo, "nullptr gmmResourceInfo", nullptr);
+
+    uint32_t allocSize = GetAllocSize(size);
+    if (allocSize > m_maxBufferSize)
+    {
+        return nullptr;
+    }
+
+    MediaLibvaUtilNext_LockGuard guard(&m_mutex);
+
+    // Most recently returned first, skip buffers the GPU is still working on
+    for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it)
+    {
+        if (it->type != type || it->sysGfxMem != sysGfxMem || it->allocSize != allocSize)
+        {
+            continue;
+        }
+        if (mos_bo_busy(it->bo))
+        {
+            continue;
+        }
+
+        MOS_LINUX_BO *bo = it->bo;
+        *gmmResourceInfo = it->gmmResourceInfo;
+        m_totalSize -= it->allocSize;
+        m_entries.erase(std::next(it).base());
+        return bo;
+    }
+
+    return nullptr;
+}
+
+bool MediaLibvaBufferPoolNext::Release(
+    uint32_t           type,
+    bool               sysGfxMem,
+    uint32_t           size,
+    MOS_LINUX_BO      *bo,
+    GMM_RESOURCE_INFO *gmmResourceInfo)
+{
+    uint32_t allocSize = GetAllocSize(size);
+    if (bo == nullptr || gmmResourceInfo == nullptr ||
+        allocSize > m_maxBufferSize || bo->size < allocSize)
+    {
+        return false;
+    }
+
+    MediaLibvaUtilNext_LockGuard guard(&m_mutex);
+
+    m_entries.push_back({type, sysGfxMem, allocSize, bo, gmmResourceInfo});
+    m_totalSize += allocSize;
+
+    // Keep within budget by dropping the oldest buffers
+    uint32_t evictCount = 0;
+    uint64_t totalSize  = m_totalSize;
+    while (m_entries.size() - evictCount > m_maxEntries || totalSize > m_maxTotalSize)
+    {
+        totalSize -= m_entries[evictCount].allocSize;
+        FreeEntry(m_entries[evictCount++]);
+    }
+    m_entries.erase(m_entries.begin(), m_entries.begin() + evictCount);
+    m_totalSize = totalSize;
+
+    return true;
+}
+
+void MediaLibvaBufferPoolNext::Clear()
+{
+    MediaLibvaUtilNext_LockGuard guard(&m_mutex);
+
+    for (auto &entry : m_entries)
+    {
+        FreeEntry(entry);
+    }
+    m_entries.clear();
+    m_totalSize = 0;
+}
+
+void MediaLibvaBufferPoolNext::FreeEntry(Entry &entry)
+{
+    mos_bo_unreference(entry.bo);
+    entry.bo = nullptr;
+
+    if (m_gmmClientContext && entry.gmmResourceInfo)
+    {
+        m_gmmClientContext->DestroyResInfoObject(entry.gmmResourceInfo);
+    }
+    entry.gmmResourceInfo = nullptr;
+}
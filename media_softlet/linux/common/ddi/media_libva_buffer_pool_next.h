@@ -0,0 +1,134 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_buffer_pool_next.h
+//! \brief    Recycling pool for linear VA buffers
+//! \details  Buffers created by MediaLibvaUtilNext::AllocateBuffer are returned to the
+//!           pool on destroy together with their GMM resource info, and handed out again
+//!           to the next buffer of the same type, memory type and size class. This keeps
+//!           GMM and bufmgr calls out of the per frame vaCreateBuffer/vaDestroyBuffer path.
+//!
+
+#ifndef __MEDIA_LIBVA_BUFFER_POOL_NEXT_H__
+#define __MEDIA_LIBVA_BUFFER_POOL_NEXT_H__
+
+#include <vector>
+#include "media_libva_common_next.h"
+
+class MediaLibvaBufferPoolNext
+{
+public:
+    //!
+    //! \brief  Constructor
+    //! \param  [in] gmmClientContext
+    //!         GMM client context the pooled resource infos were created from
+    //!
+    MediaLibvaBufferPoolNext(GMM_CLIENT_CONTEXT *gmmClientContext);
+
+    //!
+    //! \brief  Destructor, releases all pooled buffers
+    //!
+    ~MediaLibvaBufferPoolNext();
+
+    //!
+    //! \brief  Get the size to allocate for a buffer so it can be pooled
+    //! \param  [in] size
+    //!         Requested buffer size
+    //! \return uint32_t
+    //!         Upper bound of the size class of \a size, \a size itself if it is not pooled
+    //!
+    static uint32_t GetAllocSize(uint32_t size);
+
+    //!
+    //! \brief  Take an idle buffer of the same class out of the pool
+    //! \param  [in] type
+    //!         VA buffer type
+    //! \param  [in] sysGfxMem
+    //!         Buffer is in system memory
+    //! \param  [in] size
+    //!         Requested buffer size
+    //! \param  [out] gmmResourceInfo
+    //!         GMM resource info of the returned buffer
+    //! \return MOS_LINUX_BO *
+    //!         Buffer object, nullptr if none is available
+    //!
+    MOS_LINUX_BO *Acquire(
+        uint32_t           type,
+        bool               sysGfxMem,
+        uint32_t           size,
+        GMM_RESOURCE_INFO **gmmResourceInfo);
+
+    //!
+    //! \brief  Return a buffer to the pool
+    //! \details Buffers above the size limit are refused. When the pool is full the
+    //!          oldest buffers are released to make room.
+    //! \param  [in] type
+    //!         VA buffer type
+    //! \param  [in] sysGfxMem
+    //!         Buffer is in system memory
+    //! \param  [in] size
+    //!         Size the buffer was requested with
+    //! \param  [in] bo
+    //!         Buffer object, the pool takes over the reference
+    //! \param  [in] gmmResourceInfo
+    //!         GMM resource info, the pool takes over its ownership
+    //! \return bool
+    //!         true if the pool took the buffer
+    //!
+    bool Release(
+        uint32_t           type,
+        bool               sysGfxMem,
+        uint32_t           size,
+        MOS_LINUX_BO      *bo,
+        GMM_RESOURCE_INFO *gmmResourceInfo);
+
+    //!
+    //! \brief  Release all pooled buffers
+    //!
+    void Clear();
+
+    static const uint32_t m_pageSize      = 0x1000;
+    static const uint32_t m_maxBufferSize = 0x800000;   //!< Larger buffers are not pooled
+    static const uint32_t m_maxEntries    = 64;
+    static const uint64_t m_maxTotalSize  = 0x4000000;  //!< Memory budget of the pool
+
+private:
+    struct Entry
+    {
+        uint32_t           type;
+        bool               sysGfxMem;
+        uint32_t           allocSize;
+        MOS_LINUX_BO      *bo;
+        GMM_RESOURCE_INFO *gmmResourceInfo;
+    };
+
+    void FreeEntry(Entry &entry);
+
+    GMM_CLIENT_CONTEXT *m_gmmClientContext = nullptr;
+    MEDIA_MUTEX_T       m_mutex            = {};
+    std::vector<Entry>  m_entries;                     //!< Oldest first
+    uint64_t            m_totalSize        = 0;
+
+MEDIA_CLASS_DEFINE_END(MediaLibvaBufferPoolNext)
+};
+
+#endif  //__MEDIA_LIBVA_BUFFER_POOL_NEXT_H__
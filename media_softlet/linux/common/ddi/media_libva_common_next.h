@@ -284,6 +284,7 @@ typedef struct _DDI_MEDIA_BUFFER
 
     bool                   bCFlushReq        = false; // No LLC between CPU & GPU, requries to call CPU Flush for CPU mapped buffer
     bool                   bUseSysGfxMem     = false;
+    bool                   bPoolable         = false; // Allocated in a buffer pool size class, goes back to the pool on free
     PDDI_MEDIA_SURFACE     pSurface          = nullptr;
     GMM_RESOURCE_INFO     *pGmmResourceInfo  = nullptr; // GMM resource descriptor
     PDDI_MEDIA_CONTEXT     pMediaCtx         = nullptr; // Media driver Context
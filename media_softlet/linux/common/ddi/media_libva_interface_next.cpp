@@ -45,6 +45,7 @@
 #include "ddi_encode_functions.h"
 #include "ddi_vp_functions.h"
 #include "media_libva_register.h"
+#include "media_libva_buffer_pool_next.h"
 
 MEDIA_MUTEX_T MediaLibvaInterfaceNext::m_GlobalMutex = MEDIA_MUTEX_INITIALIZER;
 
@@ -65,6 +66,7 @@ void MediaLibvaInterfaceNext::FreeForMediaContext(PDDI_MEDIA_CONTEXT mediaCtx)
         MOS_FreeMemory(mediaCtx->pEncoderCtxHeap);
         MOS_FreeMemory(mediaCtx->pVpCtxHeap);
         MOS_FreeMemory(mediaCtx->pProtCtxHeap);
+        MOS_Delete(mediaCtx->m_bufferPool);
         mediaCtx->m_userSettingPtr.reset();
         MOS_Delete(mediaCtx);
     }
@@ -136,6 +138,13 @@ VAStatus MediaLibvaInterfaceNext::HeapInitialize(PDDI_MEDIA_CONTEXT mediaCtx)
     DDI_CHK_NULL(mediaCtx->pProtCtxHeap, "nullptr pProtCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pProtCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
 
+    // Buffers are still allocated one by one without the pool
+    mediaCtx->m_bufferPool = MOS_New(MediaLibvaBufferPoolNext, mediaCtx->pGmmClientContext);
+    if (nullptr == mediaCtx->m_bufferPool)
+    {
+        DDI_NORMALMESSAGE("Failed to create buffer pool.");
+    }
+
     // init the mutexs
     MediaLibvaUtilNext::InitMutex(&mediaCtx->SurfaceMutex);
     MediaLibvaUtilNext::InitMutex(&mediaCtx->BufferMutex);
@@ -696,6 +705,9 @@ VAStatus MediaLibvaInterfaceNext::HeapDestroy(PDDI_MEDIA_CONTEXT mediaCtx)
     MOS_FreeMemory(mediaCtx->pProtCtxHeap->pHeapBase);
     MOS_FreeMemory(mediaCtx->pProtCtxHeap);
 
+    // All buffers are destroyed, release the recycled ones
+    MOS_Delete(mediaCtx->m_bufferPool);
+
     // destroy the mutexs
     MediaLibvaUtilNext::DestroyMutex(&mediaCtx->SurfaceMutex);
     MediaLibvaUtilNext::DestroyMutex(&mediaCtx->BufferMutex);
@@ -3643,6 +3655,8 @@ VAStatus MediaLibvaInterfaceNext::AcquireBufferHandle(
 
     ++buf->uiExportcount;
     mos_bo_reference(buf->bo);
+    // Exported buffers may be in use outside of the driver, never recycle them
+    buf->bPoolable = false;
 
     bufInfo->type     = buf->uiType;
     bufInfo->handle   = buf->handle;
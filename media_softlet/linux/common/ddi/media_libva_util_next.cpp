@@ -26,6 +26,7 @@
 #include <sys/time.h>
 #include "inttypes.h"
 #include "media_libva_util_next.h"
+#include "media_libva_buffer_pool_next.h"
 #include "mos_utilities.h"
 #include "mos_os.h"
 #include "mos_defs.h"
@@ -1082,6 +1083,16 @@ void MediaLibvaUtilNext::FreeBuffer(DDI_MEDIA_BUFFER  *buf)
         MOS_FreeMemory(buf->pData);
         buf->pData = nullptr;
     }
+    else if (buf->bPoolable && buf->format != Media_Format_2DBuffer &&
+             nullptr != buf->pMediaCtx && nullptr != buf->pMediaCtx->m_bufferPool &&
+             buf->pMediaCtx->m_bufferPool->Release(buf->uiType, buf->bUseSysGfxMem, buf->iSize, buf->bo, buf->pGmmResourceInfo))
+    {
+        // The pool owns the BO and GMM resource info now
+        buf->bo               = nullptr;
+        buf->pData            = nullptr;
+        buf->pGmmResourceInfo = nullptr;
+        buf->bPoolable        = false;
+    }
     else
     {
         mos_bo_unreference(buf->bo);
@@ -1691,35 +1702,53 @@ VAStatus MediaLibvaUtilNext::AllocateBuffer(
     VAStatus     hRes = VA_STATUS_SUCCESS;
     int32_t      mem_type = MOS_MEMPOOL_VIDEOMEMORY;
 
-    // create fake GmmResourceInfo
-    GMM_RESCREATE_PARAMS gmmParams;
-    MOS_ZeroMemory(&gmmParams, sizeof(gmmParams));
-    gmmParams.BaseWidth             = 1;
-    gmmParams.BaseHeight            = 1;
-    gmmParams.ArraySize             = 0;
-    gmmParams.Type                  = RESOURCE_1D;
-    gmmParams.Format                = GMM_FORMAT_GENERIC_8BIT;
-    gmmParams.Flags.Gpu.Video       = true;
-    gmmParams.Flags.Info.Linear     = true;
-    gmmParams.Flags.Info.LocalOnly  = MEDIA_IS_SKU(&mediaBuffer->pMediaCtx->SkuTable, FtrLocalMemory);
+    // Reuse an idle buffer of the same class destroyed earlier
+    MediaLibvaBufferPoolNext *bufferPool = mediaBuffer->pMediaCtx->m_bufferPool;
+    MOS_LINUX_BO             *bo         = nullptr;
+    if (bufferPool)
+    {
+        bo = bufferPool->Acquire(mediaBuffer->uiType, mediaBuffer->bUseSysGfxMem, size, &mediaBuffer->pGmmResourceInfo);
+    }
+
+    if (bo == nullptr)
+    {
+        // create fake GmmResourceInfo
+        GMM_RESCREATE_PARAMS gmmParams;
+        MOS_ZeroMemory(&gmmParams, sizeof(gmmParams));
+        gmmParams.BaseWidth             = 1;
+        gmmParams.BaseHeight            = 1;
+        gmmParams.ArraySize             = 0;
+        gmmParams.Type                  = RESOURCE_1D;
+        gmmParams.Format                = GMM_FORMAT_GENERIC_8BIT;
+        gmmParams.Flags.Gpu.Video       = true;
+        gmmParams.Flags.Info.Linear     = true;
+        gmmParams.Flags.Info.LocalOnly  = MEDIA_IS_SKU(&mediaBuffer->pMediaCtx->SkuTable, FtrLocalMemory);
 
-    mediaBuffer->pGmmResourceInfo = mediaBuffer->pMediaCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
-    DDI_CHK_NULL(mediaBuffer->pGmmResourceInfo, "pGmmResourceInfo is nullptr", VA_STATUS_ERROR_INVALID_BUFFER);
+        mediaBuffer->pGmmResourceInfo = mediaBuffer->pMediaCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
+        DDI_CHK_NULL(mediaBuffer->pGmmResourceInfo, "pGmmResourceInfo is nullptr", VA_STATUS_ERROR_INVALID_BUFFER);
+    }
     mediaBuffer->pGmmResourceInfo->OverrideSize(mediaBuffer->iSize);
     mediaBuffer->pGmmResourceInfo->OverrideBaseWidth(mediaBuffer->iSize);
     mediaBuffer->pGmmResourceInfo->OverridePitch(mediaBuffer->iSize);
 
-    MemoryPolicyParameter memPolicyPar = { 0 };
-    memPolicyPar.skuTable = &mediaBuffer->pMediaCtx->SkuTable;
-    memPolicyPar.waTable  = &mediaBuffer->pMediaCtx->WaTable;
-    memPolicyPar.resInfo  = mediaBuffer->pGmmResourceInfo;
-    memPolicyPar.resName  = "Media Buffer";
-    memPolicyPar.uiType   = mediaBuffer->uiType;
-    memPolicyPar.preferredMemType = mediaBuffer->bUseSysGfxMem ? MOS_MEMPOOL_SYSTEMMEMORY : 0;
+    if (bo == nullptr)
+    {
+        MemoryPolicyParameter memPolicyPar = { 0 };
+        memPolicyPar.skuTable = &mediaBuffer->pMediaCtx->SkuTable;
+        memPolicyPar.waTable  = &mediaBuffer->pMediaCtx->WaTable;
+        memPolicyPar.resInfo  = mediaBuffer->pGmmResourceInfo;
+        memPolicyPar.resName  = "Media Buffer";
+        memPolicyPar.uiType   = mediaBuffer->uiType;
+        memPolicyPar.preferredMemType = mediaBuffer->bUseSysGfxMem ? MOS_MEMPOOL_SYSTEMMEMORY : 0;
 
-    mem_type = MemoryPolicyManager::UpdateMemoryPolicy(&memPolicyPar);
-    MOS_LINUX_BO *bo  = mos_bo_alloc(bufmgr, "Media Buffer", size, 4096, mem_type);
-    mediaBuffer->bMapped = false;
+        mem_type = MemoryPolicyManager::UpdateMemoryPolicy(&memPolicyPar);
+
+        // Round up to the pool size class so the buffer can be reused for any size of the class
+        uint32_t allocSize = bufferPool ? MediaLibvaBufferPoolNext::GetAllocSize(size) : size;
+        bo  = mos_bo_alloc(bufmgr, "Media Buffer", allocSize, 4096, mem_type);
+    }
+    mediaBuffer->bMapped   = false;
+    mediaBuffer->bPoolable = (bufferPool != nullptr);
     if (bo)
     {
         mediaBuffer->format     = format;
@@ -81,11 +81,15 @@ enum mos_memory_zone {
 #define PAGE_SIZE_4G          (1ull << 32)
 #define ARRAY_INIT_SIZE       5
 
+struct mos_gem_exec_list;
+
 struct mos_linux_context {
     unsigned int ctx_id;
     struct mos_bufmgr *bufmgr;
     struct _MOS_OS_CONTEXT    *pOsContext;
     struct drm_i915_gem_vm_control* vm;
+    /* validation list reused by the execbuffers of this context */
+    struct mos_gem_exec_list *exec_list;
 };
 
 struct mos_linux_bo {
@@ -156,6 +160,14 @@ struct mos_aub_annotation {
     uint32_t ending_offset;
 };
 
+/** Counters of the buffer object reuse cache */
+struct mos_bufmgr_cache_stats {
+    uint64_t hits;          /* allocations served from the cache */
+    uint64_t misses;        /* cacheable allocations that created a new bo */
+    uint64_t evictions;     /* cached bos released by age or over budget */
+    uint64_t cached_bytes;  /* bytes currently held by the cache */
+};
+
 #define BO_ALLOC_FOR_RENDER (1<<0)
 
 struct mos_linux_bo *mos_bo_alloc(struct mos_bufmgr *bufmgr, const char *name,
@@ -233,6 +245,9 @@ struct mos_linux_bo *mos_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
                         const char *name,
                         unsigned int handle);
 void mos_bufmgr_gem_enable_reuse(struct mos_bufmgr *bufmgr);
+void mos_bufmgr_gem_set_cache_budget(struct mos_bufmgr *bufmgr, uint64_t budget);
+int mos_bufmgr_gem_get_cache_stats(struct mos_bufmgr *bufmgr,
+                 struct mos_bufmgr_cache_stats *stats);
 void mos_bufmgr_gem_enable_fenced_relocs(struct mos_bufmgr *bufmgr);
 void mos_bufmgr_gem_enable_softpin(struct mos_bufmgr *bufmgr, bool va1m_align);
 void mos_bufmgr_gem_enable_vmbind(struct mos_bufmgr *bufmgr);
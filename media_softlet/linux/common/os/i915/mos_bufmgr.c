@@ -113,8 +113,34 @@
 struct mos_gem_bo_bucket {
     drmMMListHead head;
     unsigned long size;
+    /** Protects head, taken without bufmgr_gem->lock on the alloc path */
+    pthread_mutex_t lock;
+};
+
+/**
+ * Validation list of an execbuffer. Each context owns one so independent
+ * contexts don't share the arrays, and their capacity is kept between execs.
+ */
+struct mos_gem_exec_list {
+    /** Held from building the list until the submission is retired */
+    pthread_mutex_t lock;
+
+    struct drm_i915_gem_exec_object *exec_objects;
+    struct drm_i915_gem_exec_object2 *exec2_objects;
+    struct mos_linux_bo **exec_bos;
+    int exec_size;
+    int exec_count;
+
+    /** do_exec3 scratch for the merged objects and the batch objects */
+    struct drm_i915_gem_exec_object2 *merge_objects;
+    uint32_t merge_size;
+    struct drm_i915_gem_exec_object2 *batch_objects;
+    uint32_t batch_size;
 };
 
+/** Once over budget the cache is trimmed down to 3/4 of it */
+#define MOS_BO_CACHE_LOW_WATER(budget) ((budget) - (budget) / 4)
+
 struct mos_bufmgr_gem {
     struct mos_bufmgr bufmgr;
 
@@ -126,20 +152,30 @@ struct mos_bufmgr_gem {
 
     pthread_mutex_t lock;
 
-    struct drm_i915_gem_exec_object *exec_objects;
-    struct drm_i915_gem_exec_object2 *exec2_objects;
-    struct mos_linux_bo **exec_bos;
-    int exec_size;
-    int exec_count;
+    /** Validation list for submissions without a context */
+    struct mos_gem_exec_list exec_list;
 
     /** Array of lists of cached gem objects of power-of-two sizes */
     struct mos_gem_bo_bucket cache_bucket[14 * 4];
     int num_buckets;
     time_t time;
 
+    /** Serializes the eviction passes over the buckets */
+    pthread_mutex_t cache_evict_lock;
+    /** Bytes held by the reuse cache and its budget, 0 for no budget,
+     * cache_bytes is updated under the bucket locks so access it atomically */
+    uint64_t cache_bytes;
+    uint64_t cache_budget;
+    /** Stamp for LRU order across buckets, taken under bufmgr_gem->lock */
+    uint64_t cache_free_seq;
+    struct mos_bufmgr_cache_stats cache_stats;
+
     drmMMListHead managers;
 
     drmMMListHead named;
+    /** Lookup tables for the named list, keyed by gem_handle and by global_name */
+    void *named_handle_table;
+    void *named_name_table;
 
     uint64_t gtt_size;
     int available_fences;
@@ -165,13 +201,13 @@ struct mos_bufmgr_gem {
 
     // manage address for softpin buffer object
     mos_vma_heap vma_heap[MEMZONE_COUNT];
+    pthread_mutex_t vma_lock;
     bool use_softpin;
     bool softpin_va1Malign;
 
     bool object_capture_disabled;
 
     #define MEM_PROFILER_BUFFER_SIZE 256
-    char mem_profiler_buffer[MEM_PROFILER_BUFFER_SIZE];
     char* mem_profiler_path;
     int mem_profiler_fd;
 } mos_bufmgr_gem;
@@ -217,6 +253,7 @@ struct mos_bo_gem {
     unsigned long stride;
 
     time_t free_time;
+    uint64_t free_seq;
 
     /** Array passed to the DRM containing relocation information. */
     struct drm_i915_gem_relocation_entry *relocs;
@@ -344,8 +381,6 @@ struct mos_exec_info {
     struct drm_i915_gem_exec_object2* obj;
     /* save batch buffer*/
     struct drm_i915_gem_exec_object2* batch_obj;
-    /* save previous ptr to void mem leak when free*/
-    struct drm_i915_gem_exec_object2* pSavePreviousExec2Objects;
     /*bo resource count*/
     uint32_t obj_count;
     /*batch buffer bo count*/
@@ -432,26 +467,32 @@ static struct mos_gem_bo_bucket *
 mos_gem_bo_bucket_for_size(struct mos_bufmgr_gem *bufmgr_gem,
                  unsigned long size)
 {
-    int i;
+    int lo = 0;
+    int hi = bufmgr_gem->num_buckets;
 
-    for (i = 0; i < bufmgr_gem->num_buckets; i++) {
-        struct mos_gem_bo_bucket *bucket =
-            &bufmgr_gem->cache_bucket[i];
-        if (bucket->size >= size) {
-            return bucket;
-        }
+    /* Bucket sizes are increasing, find the first one that fits */
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+
+        if (bufmgr_gem->cache_bucket[mid].size >= size)
+            hi = mid;
+        else
+            lo = mid + 1;
     }
 
+    if (lo < bufmgr_gem->num_buckets)
+        return &bufmgr_gem->cache_bucket[lo];
+
     return nullptr;
 }
 
 static void
-mos_gem_dump_validation_list(struct mos_bufmgr_gem *bufmgr_gem)
+mos_gem_dump_validation_list(struct mos_bufmgr_gem *bufmgr_gem, struct mos_gem_exec_list *list)
 {
     int i, j;
 
-    for (i = 0; i < bufmgr_gem->exec_count; i++) {
-        struct mos_linux_bo *bo = bufmgr_gem->exec_bos[i];
+    for (i = 0; i < list->exec_count; i++) {
+        struct mos_linux_bo *bo = list->exec_bos[i];
         struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
 
         if (bo_gem->relocs == nullptr || bo_gem->softpin_target == nullptr) {
@@ -507,6 +548,121 @@ mos_gem_bo_reference(struct mos_linux_bo *bo)
     atomic_inc(&bo_gem->refcount);
 }
 
+static struct mos_gem_exec_list *
+mos_gem_exec_list_create(void)
+{
+    struct mos_gem_exec_list *list;
+
+    list = (struct mos_gem_exec_list *)calloc(1, sizeof(*list));
+    if (list == nullptr)
+        return nullptr;
+
+    if (pthread_mutex_init(&list->lock, nullptr) != 0) {
+        free(list);
+        return nullptr;
+    }
+
+    return list;
+}
+
+static void
+mos_gem_exec_list_fini(struct mos_gem_exec_list *list)
+{
+    free(list->exec2_objects);
+    free(list->exec_objects);
+    free(list->exec_bos);
+    free(list->merge_objects);
+    free(list->batch_objects);
+    pthread_mutex_destroy(&list->lock);
+}
+
+static void
+mos_gem_exec_list_destroy(struct mos_gem_exec_list *list)
+{
+    if (list == nullptr)
+        return;
+
+    mos_gem_exec_list_fini(list);
+    free(list);
+}
+
+/* Double the validation arrays, the capacity is reused by later execs */
+static int
+mos_gem_exec_list_grow(struct mos_bufmgr_gem *bufmgr_gem, struct mos_gem_exec_list *list, bool legacy)
+{
+    struct mos_linux_bo **exec_bos;
+    int new_size = list->exec_size * 2;
+
+    if (new_size == 0)
+        new_size = ARRAY_INIT_SIZE;
+
+    if (legacy) {
+        struct drm_i915_gem_exec_object *exec_objects;
+
+        exec_objects = (struct drm_i915_gem_exec_object *)realloc(list->exec_objects,
+                sizeof(*list->exec_objects) * new_size);
+        if (!exec_objects)
+            return -ENOMEM;
+
+        list->exec_objects = exec_objects;
+    } else {
+        struct drm_i915_gem_exec_object2 *exec2_objects;
+
+        exec2_objects = (struct drm_i915_gem_exec_object2 *)
+                realloc(list->exec2_objects,
+                    sizeof(*list->exec2_objects) * new_size);
+        if (!exec2_objects)
+        {
+            MOS_DBG("realloc exec2_objects failed!\n");
+            return -ENOMEM;
+        }
+
+        list->exec2_objects = exec2_objects;
+    }
+
+    exec_bos = (struct mos_linux_bo **)realloc(list->exec_bos,
+            sizeof(*list->exec_bos) * new_size);
+    if (!exec_bos)
+    {
+        MOS_DBG("realloc exec_bo failed!\n");
+        return -ENOMEM;
+    }
+
+    list->exec_bos = exec_bos;
+    list->exec_size = new_size;
+
+    return 0;
+}
+
+/**
+ * Disconnects the listed buffers from the list so other submitters can
+ * validate them, must be called before dropping bufmgr_gem->lock.
+ */
+static void
+mos_gem_exec_list_detach(struct mos_gem_exec_list *list)
+{
+    int i;
+
+    for (i = 0; i < list->exec_count; i++) {
+        struct mos_bo_gem *bo_gem = to_bo_gem(list->exec_bos[i]);
+
+        if (bo_gem) {
+            bo_gem->idle = false;
+            bo_gem->validate_index = -1;
+        }
+    }
+}
+
+static void
+mos_gem_exec_list_reset(struct mos_gem_exec_list *list)
+{
+    int i;
+
+    for (i = 0; i < list->exec_count; i++)
+        list->exec_bos[i] = nullptr;
+    list->exec_count = 0;
+}
+
 /**
  * Adds the given buffer to the list of buffers to be validated (moved into the
  * appropriate memory type) with the next batch submission.
@@ -516,60 +672,71 @@ mos_gem_bo_reference(struct mos_linux_bo *bo)
  * access flags.
  */
 static void
-mos_add_validate_buffer(struct mos_linux_bo *bo)
+mos_add_validate_buffer(struct mos_gem_exec_list *list, struct mos_linux_bo *bo)
 {
-    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
     int index;
-    struct drm_i915_gem_exec_object *exec_objects;
-    struct mos_linux_bo **exec_bos;
 
     if (bo_gem->validate_index != -1)
         return;
 
     /* Extend the array of validation entries as necessary. */
-    if (bufmgr_gem->exec_count == bufmgr_gem->exec_size) {
-        int new_size = bufmgr_gem->exec_size * 2;
-
-        if (new_size == 0)
-            new_size = ARRAY_INIT_SIZE;
-
-        exec_objects = (struct drm_i915_gem_exec_object *)realloc(bufmgr_gem->exec_objects,
-                sizeof(*bufmgr_gem->exec_objects) * new_size);
-        if (!exec_objects)
-            return;
+    if (list->exec_count == list->exec_size &&
+        mos_gem_exec_list_grow((struct mos_bufmgr_gem *)bo->bufmgr, list, true) != 0)
+        return;
 
-        bufmgr_gem->exec_objects = exec_objects;
+    index = list->exec_count;
+    bo_gem->validate_index = index;
+    /* Fill in array entry */
+    list->exec_objects[index].handle = bo_gem->gem_handle;
+    list->exec_objects[index].relocation_count = bo_gem->reloc_count;
+    list->exec_objects[index].relocs_ptr = (uintptr_t) bo_gem->relocs;
+    list->exec_objects[index].alignment = bo->align;
+    list->exec_objects[index].offset = 0;
+    list->exec_bos[index] = bo;
+    list->exec_count++;
+}
 
-        exec_bos = (struct mos_linux_bo **)realloc(bufmgr_gem->exec_bos,
-                sizeof(*bufmgr_gem->exec_bos) * new_size);
-        if (!exec_bos)
-            return;
+/* Appends @bo to the exec2 list, or merges @flags into its existing entry */
+static void
+mos_gem_exec_list_add2(struct mos_gem_exec_list *list,
+              struct mos_linux_bo *bo,
+              uint64_t offset,
+              uint64_t flags)
+{
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)bo;
+    int index;
 
-        bufmgr_gem->exec_bos = exec_bos;
-        bufmgr_gem->exec_size = new_size;
+    if (bo_gem->validate_index != -1) {
+        list->exec2_objects[bo_gem->validate_index].flags |= flags;
+        return;
     }
 
-    index = bufmgr_gem->exec_count;
+    /* Extend the array of validation entries as necessary. */
+    if (list->exec_count == list->exec_size &&
+        mos_gem_exec_list_grow((struct mos_bufmgr_gem *)bo->bufmgr, list, false) != 0)
+        return;
+
+    index = list->exec_count;
     bo_gem->validate_index = index;
     /* Fill in array entry */
-    bufmgr_gem->exec_objects[index].handle = bo_gem->gem_handle;
-    bufmgr_gem->exec_objects[index].relocation_count = bo_gem->reloc_count;
-    bufmgr_gem->exec_objects[index].relocs_ptr = (uintptr_t) bo_gem->relocs;
-    bufmgr_gem->exec_objects[index].alignment = bo->align;
-    bufmgr_gem->exec_objects[index].offset = 0;
-    bufmgr_gem->exec_bos[index] = bo;
-    bufmgr_gem->exec_count++;
+    list->exec2_objects[index].handle           = bo_gem->gem_handle;
+    list->exec2_objects[index].relocation_count = bo_gem->reloc_count;
+    list->exec2_objects[index].relocs_ptr       = (uintptr_t)bo_gem->relocs;
+    list->exec2_objects[index].alignment        = bo->align;
+    list->exec2_objects[index].offset           = offset;
+    list->exec2_objects[index].flags            = flags;
+    list->exec2_objects[index].rsvd1            = 0;
+    list->exec2_objects[index].pad_to_size      = bo_gem->pad_to_size;
+    list->exec2_objects[index].rsvd2            = 0;
+    list->exec_bos[index]                       = bo;
+    list->exec_count++;
 }
 
 static void
-mos_add_validate_buffer2(struct mos_linux_bo *bo, int need_fence)
+mos_add_validate_buffer2(struct mos_gem_exec_list *list, struct mos_linux_bo *bo, int need_fence)
 {
-    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)bo;
-    int index;
-    struct drm_i915_gem_exec_object2 *exec2_objects;
-    struct mos_linux_bo **exec_bos;
     int flags = 0;
 
     if (need_fence)
@@ -585,167 +752,19 @@ mos_add_validate_buffer2(struct mos_linux_bo *bo, int need_fence)
     if (bo_gem->exec_capture)
         flags |= EXEC_OBJECT_CAPTURE;
 
-    if (bo_gem->validate_index != -1) {
-        bufmgr_gem->exec2_objects[bo_gem->validate_index].flags |= flags;
-        return;
-    }
-
-    /* Extend the array of validation entries as necessary. */
-    if (bufmgr_gem->exec_count == bufmgr_gem->exec_size) {
-        int new_size = bufmgr_gem->exec_size * 2;
-
-        if (new_size == 0)
-            new_size = ARRAY_INIT_SIZE;
-        exec2_objects = (struct drm_i915_gem_exec_object2 *)
-                realloc(bufmgr_gem->exec2_objects,
-                    sizeof(*bufmgr_gem->exec2_objects) * new_size);
-        if (!exec2_objects)
-            return;
-
-        bufmgr_gem->exec2_objects = exec2_objects;
-
-        exec_bos = (struct mos_linux_bo **)realloc(bufmgr_gem->exec_bos,
-                sizeof(*bufmgr_gem->exec_bos) * new_size);
-        if (!exec_bos)
-            return;
-
-        bufmgr_gem->exec_bos = exec_bos;
-        bufmgr_gem->exec_size = new_size;
-    }
-
-    index = bufmgr_gem->exec_count;
-    bo_gem->validate_index = index;
-    /* Fill in array entry */
-    bufmgr_gem->exec2_objects[index].handle = bo_gem->gem_handle;
-    bufmgr_gem->exec2_objects[index].relocation_count = bo_gem->reloc_count;
-    bufmgr_gem->exec2_objects[index].relocs_ptr = (uintptr_t)bo_gem->relocs;
-    bufmgr_gem->exec2_objects[index].alignment = bo->align;
-    bufmgr_gem->exec2_objects[index].offset = bo_gem->is_softpin ?
-        bo->offset64 : 0;
-    bufmgr_gem->exec_bos[index] = bo;
-    bufmgr_gem->exec2_objects[index].flags = flags;
-    bufmgr_gem->exec2_objects[index].rsvd1 = 0;
-    bufmgr_gem->exec2_objects[index].pad_to_size = bo_gem->pad_to_size;
-    bufmgr_gem->exec2_objects[index].rsvd2 = 0;
-    bufmgr_gem->exec_count++;
+    mos_gem_exec_list_add2(list, bo, bo_gem->is_softpin ? bo->offset64 : 0, flags);
 }
 
 static void
-mos_add_reloc_objects(struct mos_reloc_target reloc_target)
+mos_add_reloc_objects(struct mos_gem_exec_list *list, struct mos_reloc_target reloc_target)
 {
-    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)reloc_target.bo->bufmgr;
-    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)reloc_target.bo;
-    int index;
-    struct drm_i915_gem_exec_object2 *exec2_objects;
-    struct mos_linux_bo **exec_bos;
-
-    if (bo_gem->validate_index != -1) {
-        bufmgr_gem->exec2_objects[bo_gem->validate_index].flags |= reloc_target.flags;
-        return;
-    }
-
-    /* Extend the array of validation entries as necessary. */
-    if (bufmgr_gem->exec_count == bufmgr_gem->exec_size) {
-        int new_size = bufmgr_gem->exec_size * 2;
-
-        if (new_size == 0)
-            new_size = ARRAY_INIT_SIZE;
-        exec2_objects = (struct drm_i915_gem_exec_object2 *)
-                realloc(bufmgr_gem->exec2_objects,
-                    sizeof(*bufmgr_gem->exec2_objects) * new_size);
-        if (!exec2_objects)
-        {
-            MOS_DBG("realloc exec2_objects failed!\n");
-            return;
-        }
-
-        bufmgr_gem->exec2_objects = exec2_objects;
-
-        exec_bos = (struct mos_linux_bo **)realloc(bufmgr_gem->exec_bos,
-                sizeof(*bufmgr_gem->exec_bos) * new_size);
-        if (!exec_bos)
-        {
-            MOS_DBG("realloc exec_bo failed!\n");
-            return;
-        }
-
-        bufmgr_gem->exec_bos = exec_bos;
-        bufmgr_gem->exec_size = new_size;
-    }
-
-    index = bufmgr_gem->exec_count;
-    bo_gem->validate_index = index;
-    /* Fill in array entry */
-    bufmgr_gem->exec2_objects[index].handle           = bo_gem->gem_handle;
-    bufmgr_gem->exec2_objects[index].relocation_count = bo_gem->reloc_count;
-    bufmgr_gem->exec2_objects[index].relocs_ptr       = (uintptr_t)bo_gem->relocs;
-    bufmgr_gem->exec2_objects[index].alignment        = reloc_target.bo->align;
-    bufmgr_gem->exec2_objects[index].offset           = 0;
-    bufmgr_gem->exec_bos[index]                       = reloc_target.bo;
-    bufmgr_gem->exec2_objects[index].flags            = reloc_target.flags;
-    bufmgr_gem->exec2_objects[index].rsvd1            = 0;
-    bufmgr_gem->exec2_objects[index].pad_to_size      = bo_gem->pad_to_size;
-    bufmgr_gem->exec2_objects[index].rsvd2            = 0;
-    bufmgr_gem->exec_count++;
+    mos_gem_exec_list_add2(list, reloc_target.bo, 0, reloc_target.flags);
 }
 
 static void
-mos_add_softpin_objects(struct mos_softpin_target softpin_target)
+mos_add_softpin_objects(struct mos_gem_exec_list *list, struct mos_softpin_target softpin_target)
 {
-    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)softpin_target.bo->bufmgr;
-    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)softpin_target.bo;
-    int index;
-    struct drm_i915_gem_exec_object2 *exec2_objects;
-    struct mos_linux_bo **exec_bos;
-
-    if (bo_gem->validate_index != -1) {
-        bufmgr_gem->exec2_objects[bo_gem->validate_index].flags |= softpin_target.flags;
-        return;
-    }
-
-    /* Extend the array of validation entries as necessary. */
-    if (bufmgr_gem->exec_count == bufmgr_gem->exec_size) {
-        int new_size = bufmgr_gem->exec_size * 2;
-
-        if (new_size == 0)
-            new_size = ARRAY_INIT_SIZE;
-        exec2_objects = (struct drm_i915_gem_exec_object2 *)
-                realloc(bufmgr_gem->exec2_objects,
-                    sizeof(*bufmgr_gem->exec2_objects) * new_size);
-        if (!exec2_objects)
-        {
-            MOS_DBG("realloc exec2_objects failed!\n");
-            return;
-        }
-
-        bufmgr_gem->exec2_objects = exec2_objects;
-
-        exec_bos = (struct mos_linux_bo **)realloc(bufmgr_gem->exec_bos,
-                sizeof(*bufmgr_gem->exec_bos) * new_size);
-        if (!exec_bos)
-        {
-            MOS_DBG("realloc exec_bo failed!\n");
-            return;
-        }
-
-        bufmgr_gem->exec_bos = exec_bos;
-        bufmgr_gem->exec_size = new_size;
-    }
-
-    index = bufmgr_gem->exec_count;
-    bo_gem->validate_index = index;
-    /* Fill in array entry */
-    bufmgr_gem->exec2_objects[index].handle           = bo_gem->gem_handle;
-    bufmgr_gem->exec2_objects[index].relocation_count = bo_gem->reloc_count;
-    bufmgr_gem->exec2_objects[index].relocs_ptr       = (uintptr_t)bo_gem->relocs;
-    bufmgr_gem->exec2_objects[index].alignment        = softpin_target.bo->align;
-    bufmgr_gem->exec2_objects[index].offset           = softpin_target.bo->offset64;
-    bufmgr_gem->exec2_objects[index].flags            = softpin_target.flags;
-    bufmgr_gem->exec2_objects[index].pad_to_size      = bo_gem->pad_to_size;
-    bufmgr_gem->exec2_objects[index].rsvd1            = 0;
-    bufmgr_gem->exec2_objects[index].rsvd2            = 0;
-    bufmgr_gem->exec_bos[index]                       = softpin_target.bo;
-    bufmgr_gem->exec_count++;
+    mos_gem_exec_list_add2(list, softpin_target.bo, softpin_target.bo->offset64, softpin_target.flags);
 }
 
 #define RELOC_BUF_SIZE(x) ((I915_RELOC_HEADER + x * I915_RELOC0_STRIDE) * \
@@ -848,11 +867,45 @@ mos_gem_bo_madvise(struct mos_linux_bo *bo, int madv)
          madv);
 }
 
+/* bytes held by the reuse cache, read without the bucket locks */
+static inline uint64_t
+mos_gem_bo_cache_bytes(struct mos_bufmgr_gem *bufmgr_gem)
+{
+    return __sync_fetch_and_add(&bufmgr_gem->cache_bytes, 0);
+}
+
+/* take a cached bo off its bucket, the bucket lock must be held */
+static void
+mos_gem_bo_cache_unlink(struct mos_bufmgr_gem *bufmgr_gem,
+                   struct mos_bo_gem *bo_gem)
+{
+    DRMLISTDEL(&bo_gem->head);
+    __sync_fetch_and_sub(&bufmgr_gem->cache_bytes, bo_gem->bo.size);
+}
+
+/* free bos unlinked from the cache, called without any bucket lock held */
+static void
+mos_gem_bo_cache_free_list(drmMMListHead *list)
+{
+    while (!DRMLISTEMPTY(list)) {
+        struct mos_bo_gem *bo_gem;
+
+        bo_gem = DRMLISTENTRY(struct mos_bo_gem, list->next, head);
+        DRMLISTDEL(&bo_gem->head);
+        mos_gem_bo_free(&bo_gem->bo);
+    }
+}
+
 /* drop the oldest entries that have been purged by the kernel */
 static void
 mos_gem_bo_cache_purge_bucket(struct mos_bufmgr_gem *bufmgr_gem,
                     struct mos_gem_bo_bucket *bucket)
 {
+    drmMMListHead purged;
+
+    DRMINITLISTHEAD(&purged);
+
+    pthread_mutex_lock(&bucket->lock);
     while (!DRMLISTEMPTY(&bucket->head)) {
         struct mos_bo_gem *bo_gem;
 
@@ -862,9 +915,12 @@ mos_gem_bo_cache_purge_bucket(struct mos_bufmgr_gem *bufmgr_gem,
             (bufmgr_gem, bo_gem, I915_MADV_DONTNEED))
             break;
 
-        DRMLISTDEL(&bo_gem->head);
-        mos_gem_bo_free(&bo_gem->bo);
+        mos_gem_bo_cache_unlink(bufmgr_gem, bo_gem);
+        DRMLISTADDTAIL(&bo_gem->head, &purged);
     }
+    pthread_mutex_unlock(&bucket->lock);
+
+    mos_gem_bo_cache_free_list(&purged);
 }
 
 static int
@@ -984,7 +1040,9 @@ mos_gem_bo_vma_free(struct mos_bufmgr *bufmgr,
 
     CHK_CONDITION(address == 0ull, "invalid address.\n", );
     enum mos_memory_zone memzone = mos_gem_bo_memzone_for_address(address);
+    pthread_mutex_lock(&bufmgr_gem->vma_lock);
     mos_vma_heap_free(&bufmgr_gem->vma_heap[memzone], address, size);
+    pthread_mutex_unlock(&bufmgr_gem->vma_lock);
 }
 
 drm_export struct mos_linux_bo *
@@ -1023,19 +1081,23 @@ mos_gem_bo_alloc_internal(struct mos_bufmgr *bufmgr,
         bo_size = bucket->size;
     }
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
-    /* Get a buffer out of the cache if available */
+    /* Get a buffer out of the cache if available, only the bucket is
+     * locked so allocations of other sizes don't serialize on this one.
+     */
 retry:
     alloc_from_cache = false;
-    if (bucket != nullptr && !DRMLISTEMPTY(&bucket->head)) {
-        if (for_render) {
+    if (bucket != nullptr) {
+        pthread_mutex_lock(&bucket->lock);
+        if (DRMLISTEMPTY(&bucket->head)) {
+            /* nothing cached at this size */
+        } else if (for_render) {
             /* Allocate new render-target BOs from the tail (MRU)
              * of the list, as it will likely be hot in the GPU
              * cache and in the aperture for us.
              */
             bo_gem = DRMLISTENTRY(struct mos_bo_gem,
                           bucket->head.prev, head);
-            DRMLISTDEL(&bo_gem->head);
+            mos_gem_bo_cache_unlink(bufmgr_gem, bo_gem);
             alloc_from_cache = true;
             bo_gem->bo.align = alignment;
         } else {
@@ -1051,10 +1113,12 @@ retry:
                           bucket->head.next, head);
             if (!mos_gem_bo_busy(&bo_gem->bo)) {
                 alloc_from_cache = true;
-                DRMLISTDEL(&bo_gem->head);
+                mos_gem_bo_cache_unlink(bufmgr_gem, bo_gem);
             }
         }
+        pthread_mutex_unlock(&bucket->lock);
 
+        /* The bo is owned by this thread once unlinked */
         if (alloc_from_cache) {
             if (!mos_gem_bo_madvise_internal
                 (bufmgr_gem, bo_gem, I915_MADV_WILLNEED)) {
@@ -1074,9 +1138,13 @@ retry:
                 mos_gem_bo_free(&bo_gem->bo);
                 goto retry;
             }
+
+            /* Only a bo which was not purged and fits the request is a hit */
+            __sync_fetch_and_add(&bufmgr_gem->cache_stats.hits, 1);
+        } else {
+            __sync_fetch_and_add(&bufmgr_gem->cache_stats.misses, 1);
         }
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
 
     if (!alloc_from_cache) {
 
@@ -1134,8 +1202,10 @@ retry:
         bo_gem->stride = 0;
         if (bufmgr_gem->mem_profiler_fd != -1)
         {
-            snprintf(bufmgr_gem->mem_profiler_buffer, MEM_PROFILER_BUFFER_SIZE, "GEM_CREATE, %d, %d, %lu, %d, %s\n", getpid(), bo_gem->bo.handle, bo_gem->bo.size,bo_gem->mem_region, name);
-            ret = write(bufmgr_gem->mem_profiler_fd, bufmgr_gem->mem_profiler_buffer, strnlen(bufmgr_gem->mem_profiler_buffer, MEM_PROFILER_BUFFER_SIZE));
+            /* Formatted on the stack, frees may run concurrently without any lock */
+            char profiler_buffer[MEM_PROFILER_BUFFER_SIZE];
+            snprintf(profiler_buffer, MEM_PROFILER_BUFFER_SIZE, "GEM_CREATE, %d, %d, %lu, %d, %s\n", getpid(), bo_gem->bo.handle, bo_gem->bo.size,bo_gem->mem_region, name);
+            ret = write(bufmgr_gem->mem_profiler_fd, profiler_buffer, strnlen(profiler_buffer, MEM_PROFILER_BUFFER_SIZE));
             if (ret == -1)
             {
                 MOS_DBG("Failed to write to %s: %s\n", bufmgr_gem->mem_profiler_path, strerror(errno));
@@ -1396,6 +1466,59 @@ check_bo_alloc_userptr(struct mos_bufmgr *bufmgr,
                       tiling_mode, stride, size, flags);
 }
 
+/*
+ * Find a bo on the named list by gem handle, or by flink name when
+ * by_global_name is set. Must be called with bufmgr_gem->lock held.
+ */
+static struct mos_bo_gem *
+mos_gem_bo_find_named(struct mos_bufmgr_gem *bufmgr_gem, unsigned int key, bool by_global_name)
+{
+    void *table = by_global_name ? bufmgr_gem->named_name_table : bufmgr_gem->named_handle_table;
+    void *value = nullptr;
+    drmMMListHead *list;
+    struct mos_bo_gem *bo_gem;
+
+    if (table) {
+        return drmHashLookup(table, key, &value) == 0 ? (struct mos_bo_gem *)value : nullptr;
+    }
+
+    for (list = bufmgr_gem->named.next;
+         list != &bufmgr_gem->named;
+         list = list->next) {
+        bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
+        if ((by_global_name ? bo_gem->global_name : bo_gem->gem_handle) == key) {
+            return bo_gem;
+        }
+    }
+    return nullptr;
+}
+
+static void
+mos_gem_bo_add_named(struct mos_bufmgr_gem *bufmgr_gem, struct mos_bo_gem *bo_gem)
+{
+    DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
+    if (bufmgr_gem->named_handle_table)
+        drmHashInsert(bufmgr_gem->named_handle_table, bo_gem->gem_handle, bo_gem);
+    if (bufmgr_gem->named_name_table && bo_gem->global_name)
+        drmHashInsert(bufmgr_gem->named_name_table, bo_gem->global_name, bo_gem);
+}
+
+static void
+mos_gem_bo_del_named(struct mos_bufmgr_gem *bufmgr_gem, struct mos_bo_gem *bo_gem)
+{
+    void *value = nullptr;
+
+    if (bufmgr_gem->named_handle_table &&
+        drmHashLookup(bufmgr_gem->named_handle_table, bo_gem->gem_handle, &value) == 0 &&
+        value == bo_gem)
+        drmHashDelete(bufmgr_gem->named_handle_table, bo_gem->gem_handle);
+    if (bufmgr_gem->named_name_table && bo_gem->global_name &&
+        drmHashLookup(bufmgr_gem->named_name_table, bo_gem->global_name, &value) == 0 &&
+        value == bo_gem)
+        drmHashDelete(bufmgr_gem->named_name_table, bo_gem->global_name);
+    DRMLISTDEL(&bo_gem->name_list);
+}
+
 /**
  * Returns a drm_intel_bo wrapping the given buffer object handle.
  *
@@ -1412,24 +1535,16 @@ mos_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
     int ret;
     struct drm_gem_open open_arg;
     struct drm_i915_gem_get_tiling get_tiling;
-    drmMMListHead *list;
 
-    /* At the moment most applications only have a few named bo.
-     * For instance, in a DRI client only the render buffers passed
-     * between X and the client are named. And since X returns the
-     * alternating names for the front/back buffer a linear search
-     * provides a sufficiently fast match.
+    /* Named and prime imported bos are hashed by flink name and by gem
+     * handle, a transcoding process may keep thousands of them alive.
      */
     pthread_mutex_lock(&bufmgr_gem->lock);
-    for (list = bufmgr_gem->named.next;
-         list != &bufmgr_gem->named;
-         list = list->next) {
-        bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
-        if (bo_gem->global_name == handle) {
-            mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
-            return &bo_gem->bo;
-        }
+    bo_gem = mos_gem_bo_find_named(bufmgr_gem, handle, true);
+    if (bo_gem) {
+        mos_gem_bo_reference(&bo_gem->bo);
+        pthread_mutex_unlock(&bufmgr_gem->lock);
+        return &bo_gem->bo;
     }
 
     memclear(open_arg);
@@ -1444,18 +1559,13 @@ mos_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
         return nullptr;
     }
         /* Now see if someone has used a prime handle to get this
-         * object from the kernel before by looking through the list
-         * again for a matching gem_handle
+         * object from the kernel before by looking for a matching gem_handle
          */
-    for (list = bufmgr_gem->named.next;
-         list != &bufmgr_gem->named;
-         list = list->next) {
-        bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
-        if (bo_gem->gem_handle == open_arg.handle) {
-            mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
-            return &bo_gem->bo;
-        }
+    bo_gem = mos_gem_bo_find_named(bufmgr_gem, open_arg.handle, false);
+    if (bo_gem) {
+        mos_gem_bo_reference(&bo_gem->bo);
+        pthread_mutex_unlock(&bufmgr_gem->lock);
+        return &bo_gem->bo;
     }
 
     bo_gem = (struct mos_bo_gem *)calloc(1, sizeof(*bo_gem));
@@ -1500,7 +1610,7 @@ mos_bo_gem_create_from_name(struct mos_bufmgr *bufmgr,
 
     mos_bo_gem_set_in_aperture_size(bufmgr_gem, bo_gem, 0);
 
-    DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
+    mos_gem_bo_add_named(bufmgr_gem, bo_gem);
     pthread_mutex_unlock(&bufmgr_gem->lock);
 
     if (bufmgr_gem->use_softpin)
@@ -1554,8 +1664,10 @@ mos_gem_bo_free(struct mos_linux_bo *bo)
     }
     if (bufmgr_gem->mem_profiler_fd != -1)
     {
-        snprintf(bufmgr_gem->mem_profiler_buffer, MEM_PROFILER_BUFFER_SIZE, "GEM_CLOSE, %d, %d, %lu, %d\n", getpid(), bo->handle,bo->size,bo_gem->mem_region);
-        ret = write(bufmgr_gem->mem_profiler_fd, bufmgr_gem->mem_profiler_buffer, strnlen(bufmgr_gem->mem_profiler_buffer, MEM_PROFILER_BUFFER_SIZE));
+        /* Formatted on the stack, frees may run concurrently without any lock */
+        char profiler_buffer[MEM_PROFILER_BUFFER_SIZE];
+        snprintf(profiler_buffer, MEM_PROFILER_BUFFER_SIZE, "GEM_CLOSE, %d, %d, %lu, %d\n", getpid(), bo->handle,bo->size,bo_gem->mem_region);
+        ret = write(bufmgr_gem->mem_profiler_fd, profiler_buffer, strnlen(profiler_buffer, MEM_PROFILER_BUFFER_SIZE));
         if (ret == -1)
         {
             MOS_DBG("Failed to write to %s: %s\n", bufmgr_gem->mem_profiler_path, strerror(errno));
@@ -1588,19 +1700,78 @@ mos_gem_bo_mark_mmaps_incoherent(struct mos_linux_bo *bo)
 #endif
 }
 
-/** Frees all cached buffers significantly older than @time. */
+/* unlink least recently freed bos across all buckets down to @low_water */
+static void
+mos_gem_bo_cache_evict_lru(struct mos_bufmgr_gem *bufmgr_gem,
+                 uint64_t low_water,
+                 drmMMListHead *evicted)
+{
+    while (mos_gem_bo_cache_bytes(bufmgr_gem) > low_water) {
+        struct mos_gem_bo_bucket *oldest = nullptr;
+        uint64_t oldest_seq = UINT64_MAX;
+        struct mos_bo_gem *bo_gem;
+        int i;
+
+        /* Buckets are kept in free order, their heads are the LRU candidates */
+        for (i = 0; i < bufmgr_gem->num_buckets; i++) {
+            struct mos_gem_bo_bucket *bucket =
+                &bufmgr_gem->cache_bucket[i];
+
+            pthread_mutex_lock(&bucket->lock);
+            if (!DRMLISTEMPTY(&bucket->head)) {
+                bo_gem = DRMLISTENTRY(struct mos_bo_gem,
+                              bucket->head.next, head);
+                if (bo_gem->free_seq < oldest_seq) {
+                    oldest_seq = bo_gem->free_seq;
+                    oldest = bucket;
+                }
+            }
+            pthread_mutex_unlock(&bucket->lock);
+        }
+
+        if (oldest == nullptr)
+            break;
+
+        /* A racing allocation may have emptied it, then pick again */
+        pthread_mutex_lock(&oldest->lock);
+        if (!DRMLISTEMPTY(&oldest->head)) {
+            bo_gem = DRMLISTENTRY(struct mos_bo_gem,
+                          oldest->head.next, head);
+            mos_gem_bo_cache_unlink(bufmgr_gem, bo_gem);
+            DRMLISTADDTAIL(&bo_gem->head, evicted);
+            __sync_fetch_and_add(&bufmgr_gem->cache_stats.evictions, 1);
+        }
+        pthread_mutex_unlock(&oldest->lock);
+    }
+}
+
+/**
+ * Frees all cached buffers significantly older than @time, and the least
+ * recently freed ones once the cache is over its budget.
+ */
 static void
 mos_gem_cleanup_bo_cache(struct mos_bufmgr_gem *bufmgr_gem, time_t time)
 {
+    drmMMListHead expired;
+    uint64_t budget = bufmgr_gem->cache_budget;
     int i;
 
-    if (bufmgr_gem->time == time)
+    /* Unlocked peek, both are updated by other threads */
+    if (__sync_fetch_and_add(&bufmgr_gem->time, 0) == time &&
+        (budget == 0 || mos_gem_bo_cache_bytes(bufmgr_gem) <= budget))
         return;
 
-    for (i = 0; i < bufmgr_gem->num_buckets; i++) {
+    /* Another thread is already evicting */
+    if (pthread_mutex_trylock(&bufmgr_gem->cache_evict_lock) != 0)
+        return;
+
+    DRMINITLISTHEAD(&expired);
+
+    for (i = 0; bufmgr_gem->time != time && i < bufmgr_gem->num_buckets; i++) {
         struct mos_gem_bo_bucket *bucket =
             &bufmgr_gem->cache_bucket[i];
 
+        pthread_mutex_lock(&bucket->lock);
         while (!DRMLISTEMPTY(&bucket->head)) {
             struct mos_bo_gem *bo_gem;
 
@@ -1609,13 +1780,20 @@ mos_gem_cleanup_bo_cache(struct mos_bufmgr_gem *bufmgr_gem, time_t time)
             if (time - bo_gem->free_time <= 1)
                 break;
 
-            DRMLISTDEL(&bo_gem->head);
-
-            mos_gem_bo_free(&bo_gem->bo);
+            mos_gem_bo_cache_unlink(bufmgr_gem, bo_gem);
+            DRMLISTADDTAIL(&bo_gem->head, &expired);
+            __sync_fetch_and_add(&bufmgr_gem->cache_stats.evictions, 1);
         }
+        pthread_mutex_unlock(&bucket->lock);
     }
+    __sync_lock_test_and_set(&bufmgr_gem->time, time);
 
-    bufmgr_gem->time = time;
+    if (budget != 0 && mos_gem_bo_cache_bytes(bufmgr_gem) > budget)
+        mos_gem_bo_cache_evict_lru(bufmgr_gem, MOS_BO_CACHE_LOW_WATER(budget), &expired);
+
+    pthread_mutex_unlock(&bufmgr_gem->cache_evict_lock);
+
+    mos_gem_bo_cache_free_list(&expired);
 }
 
 drm_export void
@@ -1668,7 +1846,7 @@ mos_gem_bo_unreference_final(struct mos_linux_bo *bo, time_t time)
         mos_gem_bo_mark_mmaps_incoherent(bo);
     }
 
-    DRMLISTDEL(&bo_gem->name_list);
+    mos_gem_bo_del_named(bufmgr_gem, bo_gem);
 
     bucket = mos_gem_bo_bucket_for_size(bufmgr_gem, bo->size);
     /* Put the buffer into our internal cache for reuse if we can. */
@@ -1680,7 +1858,11 @@ mos_gem_bo_unreference_final(struct mos_linux_bo *bo, time_t time)
         bo_gem->name = nullptr;
         bo_gem->validate_index = -1;
 
+        pthread_mutex_lock(&bucket->lock);
+        bo_gem->free_seq = bufmgr_gem->cache_free_seq++;
         DRMLISTADDTAIL(&bo_gem->head, &bucket->head);
+        __sync_fetch_and_add(&bufmgr_gem->cache_bytes, bo->size);
+        pthread_mutex_unlock(&bucket->lock);
     } else {
         mos_gem_bo_free(bo);
     }
@@ -1706,6 +1888,7 @@ static void mos_gem_bo_unreference(struct mos_linux_bo *bo)
         struct mos_bufmgr_gem *bufmgr_gem =
             (struct mos_bufmgr_gem *) bo->bufmgr;
         struct timespec time;
+        bool released = false;
 
         clock_gettime(CLOCK_MONOTONIC, &time);
 
@@ -1713,10 +1896,14 @@ static void mos_gem_bo_unreference(struct mos_linux_bo *bo)
 
         if (atomic_dec_and_test(&bo_gem->refcount)) {
             mos_gem_bo_unreference_final(bo, time.tv_sec);
-            mos_gem_cleanup_bo_cache(bufmgr_gem, time.tv_sec);
+            released = true;
         }
 
         pthread_mutex_unlock(&bufmgr_gem->lock);
+
+        /* Evict outside of the manager lock, freeing may wait on the GPU */
+        if (released)
+            mos_gem_cleanup_bo_cache(bufmgr_gem, time.tv_sec);
     }
 }
 
@@ -2458,11 +2645,14 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
     struct drm_gem_close close_bo;
     int i, ret;
 
-    free(bufmgr_gem->exec2_objects);
-    free(bufmgr_gem->exec_objects);
-    free(bufmgr_gem->exec_bos);
+    mos_gem_exec_list_fini(&bufmgr_gem->exec_list);
     pthread_mutex_destroy(&bufmgr_gem->lock);
 
+    if (bufmgr_gem->named_handle_table)
+        drmHashDestroy(bufmgr_gem->named_handle_table);
+    if (bufmgr_gem->named_name_table)
+        drmHashDestroy(bufmgr_gem->named_name_table);
+
     /* Free any cached buffer objects we were going to reuse */
     for (i = 0; i < bufmgr_gem->num_buckets; i++) {
         struct mos_gem_bo_bucket *bucket =
@@ -2476,7 +2666,9 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
 
             mos_gem_bo_free(&bo_gem->bo);
         }
+        pthread_mutex_destroy(&bucket->lock);
     }
+    pthread_mutex_destroy(&bufmgr_gem->cache_evict_lock);
 
     /* Release userptr bo kept hanging around for optimisation. */
     if (bufmgr_gem->userptr_active.ptr) {
@@ -2492,6 +2684,7 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
 
     mos_vma_heap_finish(&bufmgr_gem->vma_heap[MEMZONE_SYS]);
     mos_vma_heap_finish(&bufmgr_gem->vma_heap[MEMZONE_DEVICE]);
+    pthread_mutex_destroy(&bufmgr_gem->vma_lock);
 
     if (bufmgr_gem->mem_profiler_fd != -1)
     {
@@ -2959,7 +3152,7 @@ mos_gem_bo_clear_relocs(struct mos_linux_bo *bo, int start)
  * index values into the validation list.
  */
 static void
-mos_gem_bo_process_reloc(struct mos_linux_bo *bo)
+mos_gem_bo_process_reloc(struct mos_gem_exec_list *list, struct mos_linux_bo *bo)
 {
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
     int i;
@@ -2976,15 +3169,15 @@ mos_gem_bo_process_reloc(struct mos_linux_bo *bo)
         mos_gem_bo_mark_mmaps_incoherent(bo);
 
         /* Continue walking the tree depth-first. */
-        mos_gem_bo_process_reloc(target_bo);
+        mos_gem_bo_process_reloc(list, target_bo);
 
         /* Add the target to the validate list */
-        mos_add_validate_buffer(target_bo);
+        mos_add_validate_buffer(list, target_bo);
     }
 }
 
 static void
-mos_gem_bo_process_reloc2(struct mos_linux_bo *bo)
+mos_gem_bo_process_reloc2(struct mos_gem_exec_list *list, struct mos_linux_bo *bo)
 {
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)bo;
     int i;
@@ -3001,10 +3194,10 @@ mos_gem_bo_process_reloc2(struct mos_linux_bo *bo)
         mos_gem_bo_mark_mmaps_incoherent(bo);
 
         /* Continue walking the tree depth-first. */
-        mos_gem_bo_process_reloc2(target_bo);
+        mos_gem_bo_process_reloc2(list, target_bo);
 
         /* Add the target to the validate list */
-        mos_add_reloc_objects(bo_gem->reloc_target_info[i]);
+        mos_add_reloc_objects(list, bo_gem->reloc_target_info[i]);
     }
 
     for (i = 0; i < bo_gem->softpin_target_count; i++) {
@@ -3014,45 +3207,45 @@ mos_gem_bo_process_reloc2(struct mos_linux_bo *bo)
             continue;
 
         mos_gem_bo_mark_mmaps_incoherent(bo);
-        mos_gem_bo_process_reloc2(target_bo);
-        mos_add_softpin_objects(bo_gem->softpin_target[i]);
+        mos_gem_bo_process_reloc2(list, target_bo);
+        mos_add_softpin_objects(list, bo_gem->softpin_target[i]);
     }
 }
 
 static void
-mos_update_buffer_offsets(struct mos_bufmgr_gem *bufmgr_gem)
+mos_update_buffer_offsets(struct mos_bufmgr_gem *bufmgr_gem, struct mos_gem_exec_list *list)
 {
     int i;
 
-    for (i = 0; i < bufmgr_gem->exec_count; i++) {
-        struct mos_linux_bo *bo = bufmgr_gem->exec_bos[i];
+    for (i = 0; i < list->exec_count; i++) {
+        struct mos_linux_bo *bo = list->exec_bos[i];
         struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
 
         /* Update the buffer offset */
-        if (bufmgr_gem->exec_objects[i].offset != bo->offset64) {
+        if (list->exec_objects[i].offset != bo->offset64) {
             MOS_DBG("BO %d (%s) migrated: 0x%08x %08x -> 0x%08x %08x\n",
                 bo_gem->gem_handle, bo_gem->name,
                 upper_32_bits(bo->offset64),
                 lower_32_bits(bo->offset64),
-                upper_32_bits(bufmgr_gem->exec_objects[i].offset),
-                lower_32_bits(bufmgr_gem->exec_objects[i].offset));
-            bo->offset64 = bufmgr_gem->exec_objects[i].offset;
-            bo->offset = bufmgr_gem->exec_objects[i].offset;
+                upper_32_bits(list->exec_objects[i].offset),
+                lower_32_bits(list->exec_objects[i].offset));
+            bo->offset64 = list->exec_objects[i].offset;
+            bo->offset = list->exec_objects[i].offset;
         }
     }
 }
 
 static void
-mos_update_buffer_offsets2 (struct mos_bufmgr_gem *bufmgr_gem, mos_linux_context *ctx, mos_linux_bo *cmd_bo)
+mos_update_buffer_offsets2 (struct mos_bufmgr_gem *bufmgr_gem, struct mos_gem_exec_list *list, mos_linux_context *ctx, mos_linux_bo *cmd_bo)
 {
     int i;
 
-    for (i = 0; i < bufmgr_gem->exec_count; i++) {
-        struct mos_linux_bo *bo = bufmgr_gem->exec_bos[i];
+    for (i = 0; i < list->exec_count; i++) {
+        struct mos_linux_bo *bo = list->exec_bos[i];
         struct mos_bo_gem *bo_gem = (struct mos_bo_gem *)bo;
 
         /* Update the buffer offset */
-        if (bufmgr_gem->exec2_objects[i].offset != bo->offset64) {
+        if (list->exec2_objects[i].offset != bo->offset64) {
             /* If we're seeing softpinned object here it means that the kernel
              * has relocated our object... Indicating a programming error
              */
@@ -3061,28 +3254,16 @@ mos_update_buffer_offsets2 (struct mos_bufmgr_gem *bufmgr_gem, mos_linux_context
                 bo_gem->gem_handle, bo_gem->name,
                 upper_32_bits(bo->offset64),
                 lower_32_bits(bo->offset64),
-                upper_32_bits(bufmgr_gem->exec2_objects[i].offset),
-                lower_32_bits(bufmgr_gem->exec2_objects[i].offset));
-            bo->offset64 = bufmgr_gem->exec2_objects[i].offset;
-            bo->offset = bufmgr_gem->exec2_objects[i].offset;
+                upper_32_bits(list->exec2_objects[i].offset),
+                lower_32_bits(list->exec2_objects[i].offset));
+            bo->offset64 = list->exec2_objects[i].offset;
+            bo->offset = list->exec2_objects[i].offset;
         }
 
         if(!bufmgr_gem->use_softpin)
         {
             if (cmd_bo != bo) {
-                auto item_ctx = ctx->pOsContext->contextOffsetList.begin();
-                for (; item_ctx != ctx->pOsContext->contextOffsetList.end(); item_ctx++) {
-                    if (item_ctx->intel_context == ctx && item_ctx->target_bo == bo) {
-                        item_ctx->offset64 = bo->offset64;
-                        break;
-                    }
-                }
-                if ( item_ctx == ctx->pOsContext->contextOffsetList.end()) {
-                    struct MOS_CONTEXT_OFFSET newContext = {ctx,
-                                        bo,
-                                        bo->offset64};
-                    ctx->pOsContext->contextOffsetList.push_back(newContext);
-                }
+                ctx->pOsContext->contextOffsetCache.Update(ctx, bo, bo->offset64);
             }
         }
     }
@@ -3093,24 +3274,26 @@ mos_gem_bo_exec(struct mos_linux_bo *bo, int used,
               drm_clip_rect_t * cliprects, int num_cliprects, int DR4)
 {
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+    struct mos_gem_exec_list *list = &bufmgr_gem->exec_list;
     struct drm_i915_gem_execbuffer execbuf;
-    int ret, i;
+    int ret;
 
     if (to_bo_gem(bo)->has_error)
         return -ENOMEM;
 
+    pthread_mutex_lock(&list->lock);
     pthread_mutex_lock(&bufmgr_gem->lock);
     /* Update indices and set up the validate list. */
-    mos_gem_bo_process_reloc(bo);
+    mos_gem_bo_process_reloc(list, bo);
 
     /* Add the batch buffer to the validation list.  There are no
      * relocations pointing to it.
      */
-    mos_add_validate_buffer(bo);
+    mos_add_validate_buffer(list, bo);
 
     memclear(execbuf);
-    execbuf.buffers_ptr = (uintptr_t) bufmgr_gem->exec_objects;
-    execbuf.buffer_count = bufmgr_gem->exec_count;
+    execbuf.buffers_ptr = (uintptr_t) list->exec_objects;
+    execbuf.buffer_count = list->exec_count;
     execbuf.batch_start_offset = 0;
     execbuf.batch_len = used;
     execbuf.cliprects_ptr = (uintptr_t) cliprects;
@@ -3126,30 +3309,22 @@ mos_gem_bo_exec(struct mos_linux_bo *bo, int used,
         if (errno == ENOSPC) {
             MOS_DBG("Execbuffer fails to pin. "
                 "Estimate: %u. Actual: %u. Available: %u\n",
-                mos_gem_estimate_batch_space(bufmgr_gem->exec_bos,
-                                   bufmgr_gem->
-                                   exec_count),
-                mos_gem_compute_batch_space(bufmgr_gem->exec_bos,
-                                  bufmgr_gem->
-                                  exec_count),
+                mos_gem_estimate_batch_space(list->exec_bos,
+                                   list->exec_count),
+                mos_gem_compute_batch_space(list->exec_bos,
+                                  list->exec_count),
                 (unsigned int)bufmgr_gem->gtt_size);
         }
     }
-    mos_update_buffer_offsets(bufmgr_gem);
+    mos_update_buffer_offsets(bufmgr_gem, list);
 
     if (bufmgr_gem->bufmgr.debug)
-        mos_gem_dump_validation_list(bufmgr_gem);
+        mos_gem_dump_validation_list(bufmgr_gem, list);
 
-    for (i = 0; i < bufmgr_gem->exec_count; i++) {
-        struct mos_bo_gem *bo_gem = to_bo_gem(bufmgr_gem->exec_bos[i]);
-        bo_gem->idle = false;
-
-        /* Disconnect the buffer from the validate list */
-        bo_gem->validate_index = -1;
-        bufmgr_gem->exec_bos[i] = nullptr;
-    }
-    bufmgr_gem->exec_count = 0;
+    mos_gem_exec_list_detach(list);
+    mos_gem_exec_list_reset(list);
     pthread_mutex_unlock(&bufmgr_gem->lock);
+    pthread_mutex_unlock(&list->lock);
 
     return ret;
 }
@@ -3162,9 +3337,9 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
 {
 
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bo->bufmgr;
+    struct mos_gem_exec_list *list;
     struct drm_i915_gem_execbuffer2 execbuf;
     int ret = 0;
-    int i;
 
     if (to_bo_gem(bo)->has_error)
         return -ENOMEM;
@@ -3189,18 +3364,28 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
         break;
     }
 
+    list = (ctx != nullptr && ctx->exec_list != nullptr) ?
+            ctx->exec_list : &bufmgr_gem->exec_list;
+
+    pthread_mutex_lock(&list->lock);
     pthread_mutex_lock(&bufmgr_gem->lock);
     /* Update indices and set up the validate list. */
-    mos_gem_bo_process_reloc2(bo);
+    mos_gem_bo_process_reloc2(list, bo);
 
     /* Add the batch buffer to the validation list.  There are no relocations
      * pointing to it.
      */
-    mos_add_validate_buffer2(bo, 0);
+    mos_add_validate_buffer2(list, bo, 0);
+
+    /* The list is owned by this context from here on, only the offset
+     * writeback below needs the manager lock again.
+     */
+    mos_gem_exec_list_detach(list);
+    pthread_mutex_unlock(&bufmgr_gem->lock);
 
     memclear(execbuf);
-    execbuf.buffers_ptr = (uintptr_t)bufmgr_gem->exec2_objects;
-    execbuf.buffer_count = bufmgr_gem->exec_count;
+    execbuf.buffers_ptr = (uintptr_t)list->exec2_objects;
+    execbuf.buffer_count = list->exec_count;
     execbuf.batch_start_offset = 0;
     execbuf.batch_len = used;
     execbuf.cliprects_ptr = (uintptr_t)cliprects;
@@ -3233,17 +3418,19 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
         if (ret == -ENOSPC) {
             MOS_DBG("Execbuffer fails to pin. "
                 "Estimate: %u. Actual: %u. Available: %u\n",
-                mos_gem_estimate_batch_space(bufmgr_gem->exec_bos,
-                                   bufmgr_gem->exec_count),
-                mos_gem_compute_batch_space(bufmgr_gem->exec_bos,
-                                  bufmgr_gem->exec_count),
+                mos_gem_estimate_batch_space(list->exec_bos,
+                                   list->exec_count),
+                mos_gem_compute_batch_space(list->exec_bos,
+                                  list->exec_count),
                 (unsigned int) bufmgr_gem->gtt_size);
         }
     }
 
     if (ctx != nullptr)
     {
-        mos_update_buffer_offsets2(bufmgr_gem, ctx, bo);
+        pthread_mutex_lock(&bufmgr_gem->lock);
+        mos_update_buffer_offsets2(bufmgr_gem, list, ctx, bo);
+        pthread_mutex_unlock(&bufmgr_gem->lock);
     }
 
     if(flags & I915_EXEC_FENCE_OUT)
@@ -3253,180 +3440,206 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
 
 skip_execution:
     if (bufmgr_gem->bufmgr.debug)
-        mos_gem_dump_validation_list(bufmgr_gem);
-
-    for (i = 0; i < bufmgr_gem->exec_count; i++) {
-        struct mos_bo_gem *bo_gem = to_bo_gem(bufmgr_gem->exec_bos[i]);
-
-        bo_gem->idle = false;
-
-        /* Disconnect the buffer from the validate list */
-        bo_gem->validate_index = -1;
-        bufmgr_gem->exec_bos[i] = nullptr;
+    {
+        pthread_mutex_lock(&bufmgr_gem->lock);
+        mos_gem_dump_validation_list(bufmgr_gem, list);
+        pthread_mutex_unlock(&bufmgr_gem->lock);
     }
-    bufmgr_gem->exec_count = 0;
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    mos_gem_exec_list_reset(list);
+    pthread_mutex_unlock(&list->lock);
 
     return ret;
 }
 
-drm_export int
-do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
-     drm_clip_rect_t *cliprects, int num_cliprects, int DR4,
-     unsigned int _flags, int *fence
-     )
+/* Grows the do_exec3 scratch arrays of @list, they are reused by later execs */
+static int
+mos_gem_exec_list_reserve3(struct mos_gem_exec_list *list,
+                  uint32_t merge_count,
+                  uint32_t batch_count)
 {
-    uint64_t flags = _flags;
-    uint64_t num_bo = _num_bo;
-    if((bo == nullptr) || (ctx == nullptr) || (num_bo == 0))
-    {
-        return -EINVAL;
+    if (list->merge_size < merge_count) {
+        struct drm_i915_gem_exec_object2 *merge_objects;
+
+        merge_objects = (struct drm_i915_gem_exec_object2 *)realloc(list->merge_objects,
+                merge_count * sizeof(*merge_objects));
+        if (merge_objects == nullptr)
+            return -ENOMEM;
+
+        list->merge_objects = merge_objects;
+        list->merge_size = merge_count;
     }
 
-    struct mos_bufmgr_gem           *bufmgr_gem = (struct mos_bufmgr_gem *)bo[0]->bufmgr;
-    struct drm_i915_gem_execbuffer2 execbuf;
-    int                             ret = 0;
-    int                             i;
+    if (list->batch_size < batch_count) {
+        struct drm_i915_gem_exec_object2 *batch_objects;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+        batch_objects = (struct drm_i915_gem_exec_object2 *)realloc(list->batch_objects,
+                batch_count * sizeof(*batch_objects));
+        if (batch_objects == nullptr)
+            return -ENOMEM;
 
-    struct mos_exec_info exec_info;
-    memset(static_cast<void*>(&exec_info), 0, sizeof(exec_info));
-    exec_info.batch_obj = (struct drm_i915_gem_exec_object2 *) calloc (num_bo, sizeof(struct drm_i915_gem_exec_object2));
-    if(exec_info.batch_obj == nullptr)
-    {
-        ret = -ENOMEM;
-        goto skip_execution;
-    }
-    exec_info.obj_remain_size = OBJ512_SIZE;
-    exec_info.obj = (struct drm_i915_gem_exec_object2 *) calloc (OBJ512_SIZE, sizeof(struct drm_i915_gem_exec_object2));
-    if(exec_info.obj == nullptr)
-    {
-        ret = -ENOMEM;
-        goto skip_execution;
+        list->batch_objects = batch_objects;
+        list->batch_size = batch_count;
     }
 
+    return 0;
+}
+
+/**
+ * Merges the validation lists of @num_bo batches into @exec_info, with the
+ * batches moved to the end. Called with bufmgr_gem->lock held.
+ */
+static int
+mos_gem_exec3_build(struct mos_gem_exec_list *list,
+           struct mos_linux_bo **bo,
+           uint64_t num_bo,
+           struct mos_exec_info *exec_info)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bo[0]->bufmgr;
+    int i;
+
+    if (mos_gem_exec_list_reserve3(list, OBJ512_SIZE, num_bo) != 0)
+        return -ENOMEM;
+
+    exec_info->batch_obj = list->batch_objects;
+    memset(exec_info->batch_obj, 0, num_bo * sizeof(*exec_info->batch_obj));
+    exec_info->obj = list->merge_objects;
+    exec_info->obj_remain_size = list->merge_size;
+
     for(i = 0; i < num_bo; i++)
     {
         if (to_bo_gem(bo[i])->has_error)
         {
-            ret = -ENOMEM;
-            goto skip_execution;
+            return -ENOMEM;
         }
 
         /* Update indices and set up the validate list. */
-        mos_gem_bo_process_reloc2(bo[i]);
+        mos_gem_bo_process_reloc2(list, bo[i]);
 
         /* Add the batch buffer to the validation list.  There are no relocations
          * pointing to it.
          */
-        mos_add_validate_buffer2(bo[i], 0);
+        mos_add_validate_buffer2(list, bo[i], 0);
 
-        if((bufmgr_gem->exec_count - 1 + num_bo) > exec_info.obj_remain_size)
+        if((list->exec_count - 1 + num_bo) > exec_info->obj_remain_size)
         {
             // origin size + OBJ512_SIZE + obj_count + batch_count;
-            uint32_t new_obj_size = exec_info.obj_count + exec_info.obj_remain_size + OBJ512_SIZE + bufmgr_gem->exec_count - 1 + num_bo;
-            struct drm_i915_gem_exec_object2 *new_obj = (struct drm_i915_gem_exec_object2 *)realloc(exec_info.obj, new_obj_size * sizeof(struct drm_i915_gem_exec_object2));
-            if(new_obj == nullptr)
+            uint32_t new_obj_size = exec_info->obj_count + exec_info->obj_remain_size + OBJ512_SIZE + list->exec_count - 1 + num_bo;
+            if (mos_gem_exec_list_reserve3(list, new_obj_size, num_bo) != 0)
             {
-                ret = -ENOMEM;
-                goto skip_execution;
+                return -ENOMEM;
             }
-            exec_info.obj_remain_size = new_obj_size - exec_info.obj_count;
-            exec_info.obj = new_obj;
+            exec_info->obj_remain_size = list->merge_size - exec_info->obj_count;
+            exec_info->obj = list->merge_objects;
         }
         if(0 == i)
         {
-            uint32_t cp_size = (bufmgr_gem->exec_count - 1) * sizeof(struct drm_i915_gem_exec_object2);
-            memcpy(exec_info.obj, bufmgr_gem->exec2_objects, cp_size);
-            exec_info.obj_count += (bufmgr_gem->exec_count - 1);
-            exec_info.obj_remain_size -= (bufmgr_gem->exec_count - 1);
+            uint32_t cp_size = (list->exec_count - 1) * sizeof(struct drm_i915_gem_exec_object2);
+            memcpy(exec_info->obj, list->exec2_objects, cp_size);
+            exec_info->obj_count += (list->exec_count - 1);
+            exec_info->obj_remain_size -= (list->exec_count - 1);
         }
         else
         {
-            for(int e2 = 0; e2 < bufmgr_gem->exec_count - 1; e2++)
+            for(int e2 = 0; e2 < list->exec_count - 1; e2++)
             {
                 int e1;
-                for(e1 = 0; e1 < exec_info.obj_count; e1++)
+                for(e1 = 0; e1 < exec_info->obj_count; e1++)
                 {
-                    // skip the duplicated bo if it is already in the list of exec_info.obj
-                    if(bufmgr_gem->exec2_objects[e2].handle == exec_info.obj[e1].handle)
+                    // skip the duplicated bo if it is already in the list of exec_info->obj
+                    if(list->exec2_objects[e2].handle == exec_info->obj[e1].handle)
                     {
                         break;
                     }
                 }
-                //if no duplicated bo found, add it into list of exec_info.obj
-                if(e1 == exec_info.obj_count)
+                //if no duplicated bo found, add it into list of exec_info->obj
+                if(e1 == exec_info->obj_count)
                 {
-                    exec_info.obj[exec_info.obj_count] = bufmgr_gem->exec2_objects[e2];
-                    exec_info.obj_count++;
-                    exec_info.obj_remain_size--;
+                    exec_info->obj[exec_info->obj_count] = list->exec2_objects[e2];
+                    exec_info->obj_count++;
+                    exec_info->obj_remain_size--;
                 }
             }
         }
-        memcpy(&exec_info.batch_obj[i], &bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1], sizeof(struct drm_i915_gem_exec_object2));
-        exec_info.batch_count++;
-        uint32_t reloc_count = bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1].relocation_count;
+        memcpy(&exec_info->batch_obj[i], &list->exec2_objects[list->exec_count - 1], sizeof(struct drm_i915_gem_exec_object2));
+        exec_info->batch_count++;
+        uint32_t reloc_count = list->exec2_objects[list->exec_count - 1].relocation_count;
         uint32_t cp_size = (reloc_count * sizeof(struct drm_i915_gem_relocation_entry));
-        
+
         struct drm_i915_gem_relocation_entry* ptr_reloc = (struct drm_i915_gem_relocation_entry *)calloc(reloc_count,sizeof(struct drm_i915_gem_relocation_entry));
         if(ptr_reloc == nullptr)
         {
-            ret = -ENOMEM;
-            goto skip_execution;
+            return -ENOMEM;
         }
-        memcpy(ptr_reloc, (struct drm_i915_gem_relocation_entry *)bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1].relocs_ptr, cp_size);
+        memcpy(ptr_reloc, (struct drm_i915_gem_relocation_entry *)list->exec2_objects[list->exec_count - 1].relocs_ptr, cp_size);
 
-        exec_info.batch_obj[i].relocs_ptr = (uintptr_t)ptr_reloc;
-        exec_info.batch_obj[i].relocation_count = reloc_count;
+        exec_info->batch_obj[i].relocs_ptr = (uintptr_t)ptr_reloc;
+        exec_info->batch_obj[i].relocation_count = reloc_count;
 
         //clear bo
         if (bufmgr_gem->bufmgr.debug)
         {
-            mos_gem_dump_validation_list(bufmgr_gem);
+            mos_gem_dump_validation_list(bufmgr_gem, list);
         }
 
-        for (int j = 0; j < bufmgr_gem->exec_count; j++) {
-            struct mos_bo_gem *bo_gem = to_bo_gem(bufmgr_gem->exec_bos[j]);
-
-            if(bo_gem)
-            {
-                bo_gem->idle = false;
-
-                /* Disconnect the buffer from the validate list */
-                bo_gem->validate_index = -1;
-                bufmgr_gem->exec_bos[j] = nullptr;
-            }
-        }
-        bufmgr_gem->exec_count = 0;
+        mos_gem_exec_list_detach(list);
+        mos_gem_exec_list_reset(list);
     }
 
     //add back batch obj to the last position
     for(i = 0; i < num_bo; i++)
     {
-       exec_info.obj[exec_info.obj_count] = exec_info.batch_obj[i];
-       exec_info.obj_count++;
-       exec_info.obj_remain_size--;
+       exec_info->obj[exec_info->obj_count] = exec_info->batch_obj[i];
+       exec_info->obj_count++;
+       exec_info->obj_remain_size--;
+    }
+
+    return 0;
+}
+
+drm_export int
+do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
+     drm_clip_rect_t *cliprects, int num_cliprects, int DR4,
+     unsigned int _flags, int *fence
+     )
+{
+    uint64_t flags = _flags;
+    uint64_t num_bo = _num_bo;
+    if((bo == nullptr) || (ctx == nullptr) || (num_bo == 0))
+    {
+        return -EINVAL;
     }
 
-    //save previous ptr
-    exec_info.pSavePreviousExec2Objects = bufmgr_gem->exec2_objects;
-    bufmgr_gem->exec_count = exec_info.obj_count;
-    bufmgr_gem->exec2_objects = exec_info.obj;
+    struct mos_bufmgr_gem           *bufmgr_gem = (struct mos_bufmgr_gem *)bo[0]->bufmgr;
+    struct mos_gem_exec_list        *list = ctx->exec_list ? ctx->exec_list : &bufmgr_gem->exec_list;
+    struct drm_i915_gem_execbuffer2 execbuf;
+    struct mos_exec_info            exec_info;
+    int                             ret = 0;
+    int                             i;
+
+    memset(static_cast<void*>(&exec_info), 0, sizeof(exec_info));
+
+    pthread_mutex_lock(&list->lock);
+    pthread_mutex_lock(&bufmgr_gem->lock);
+    ret = mos_gem_exec3_build(list, bo, num_bo, &exec_info);
+    /* Disconnect whatever a failed build left in the list */
+    mos_gem_exec_list_detach(list);
+    mos_gem_exec_list_reset(list);
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    if (ret != 0)
+        goto skip_execution;
 
     memclear(execbuf);
-    execbuf.buffers_ptr = (uintptr_t)bufmgr_gem->exec2_objects;
-    execbuf.buffer_count = bufmgr_gem->exec_count;
+    execbuf.buffers_ptr = (uintptr_t)exec_info.obj;
+    execbuf.buffer_count = exec_info.obj_count;
     execbuf.batch_start_offset = 0;
     execbuf.cliprects_ptr = (uintptr_t)cliprects;
     execbuf.num_cliprects = num_cliprects;
     execbuf.DR1 = 0;
     execbuf.DR4 = DR4;
     execbuf.flags = flags;
-    if (ctx == nullptr)
-        i915_execbuffer2_set_context_id(execbuf, 0);
-    else
-        i915_execbuffer2_set_context_id(execbuf, ctx->ctx_id);
+    i915_execbuffer2_set_context_id(execbuf, ctx->ctx_id);
     execbuf.rsvd2 = 0;
     if((flags & I915_EXEC_FENCE_SUBMIT) || (flags & I915_EXEC_FENCE_IN))
     {
@@ -3440,7 +3653,7 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
     if (bufmgr_gem->no_exec)
         goto skip_execution;
 
-   ret = drmIoctl(bufmgr_gem->fd,
+    ret = drmIoctl(bufmgr_gem->fd,
                DRM_IOCTL_I915_GEM_EXECBUFFER2_WR,
                &execbuf);
 
@@ -3448,27 +3661,18 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
         ret = -errno;
         if (ret == -ENOSPC) {
             MOS_DBG("Execbuffer fails to pin. "
-                "Estimate: %u. Actual: %u. Available: %u\n",
-                mos_gem_estimate_batch_space(bufmgr_gem->exec_bos,
-                                   bufmgr_gem->exec_count),
-                mos_gem_compute_batch_space(bufmgr_gem->exec_bos,
-                                  bufmgr_gem->exec_count),
+                "Objects: %u. Available: %u\n",
+                exec_info.obj_count,
                 (unsigned int) bufmgr_gem->gtt_size);
         }
     }
 
-    bufmgr_gem->exec2_objects = exec_info.pSavePreviousExec2Objects;
-
     if(flags & I915_EXEC_FENCE_OUT)
     {
         *fence = execbuf.rsvd2 >> 32;
     }
 
 skip_execution:
-    if (bufmgr_gem->bufmgr.debug)
-        mos_gem_dump_validation_list(bufmgr_gem);
-
-    bufmgr_gem->exec_count = 0;
     if(exec_info.batch_obj)
     {
         for(i = 0; i < num_bo; i++)
@@ -3476,9 +3680,7 @@ skip_execution:
             mos_safe_free((struct drm_i915_gem_relocation_entry *)exec_info.batch_obj[i].relocs_ptr);
         }
     }
-    mos_safe_free(exec_info.obj);
-    mos_safe_free(exec_info.batch_obj);
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    pthread_mutex_unlock(&list->lock);
 
     return ret;
 }
@@ -3680,14 +3882,14 @@ mos_gem_bo_set_softpin(MOS_LINUX_BO *bo)
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
+    pthread_mutex_lock(&bufmgr_gem->vma_lock);
     if (!mos_gem_bo_is_softpin(bo))
     {
         uint64_t alignment = (bufmgr_gem->softpin_va1Malign) ? PAGE_SIZE_1M : PAGE_SIZE_64K;
         uint64_t offset = mos_gem_bo_vma_alloc(bo->bufmgr, (enum mos_memory_zone)bo_gem->mem_region, bo->size, alignment);
         ret = mos_gem_bo_set_softpin_offset(bo, offset);
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
+    pthread_mutex_unlock(&bufmgr_gem->vma_lock);
 
     if (ret == 0)
     {
@@ -3705,7 +3907,6 @@ mos_bo_gem_create_from_prime(struct mos_bufmgr *bufmgr, int prime_fd, int size)
     uint32_t handle;
     struct mos_bo_gem *bo_gem;
     struct drm_i915_gem_get_tiling get_tiling;
-    drmMMListHead *list;
 
     pthread_mutex_lock(&bufmgr_gem->lock);
     ret = drmPrimeFDToHandle(bufmgr_gem->fd, prime_fd, &handle);
@@ -3720,15 +3921,11 @@ mos_bo_gem_create_from_prime(struct mos_bufmgr *bufmgr, int prime_fd, int size)
      * for named buffers, we must not create two bo's pointing at the same
      * kernel object
      */
-    for (list = bufmgr_gem->named.next;
-         list != &bufmgr_gem->named;
-         list = list->next) {
-        bo_gem = DRMLISTENTRY(struct mos_bo_gem, list, name_list);
-        if (bo_gem->gem_handle == handle) {
-            mos_gem_bo_reference(&bo_gem->bo);
-            pthread_mutex_unlock(&bufmgr_gem->lock);
-            return &bo_gem->bo;
-        }
+    bo_gem = mos_gem_bo_find_named(bufmgr_gem, handle, false);
+    if (bo_gem) {
+        mos_gem_bo_reference(&bo_gem->bo);
+        pthread_mutex_unlock(&bufmgr_gem->lock);
+        return &bo_gem->bo;
     }
 
     bo_gem = (struct mos_bo_gem *)calloc(1, sizeof(*bo_gem));
@@ -3762,7 +3959,7 @@ mos_bo_gem_create_from_prime(struct mos_bufmgr *bufmgr, int prime_fd, int size)
     bo_gem->reusable = false;
     bo_gem->use_48b_address_range = bufmgr_gem->bufmgr.bo_use_48b_address_range ? true : false;
 
-    DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
+    mos_gem_bo_add_named(bufmgr_gem, bo_gem);
     pthread_mutex_unlock(&bufmgr_gem->lock);
 
     memclear(get_tiling);
@@ -3797,7 +3994,7 @@ mos_bo_gem_export_to_prime(struct mos_linux_bo *bo, int *prime_fd)
 
     pthread_mutex_lock(&bufmgr_gem->lock);
         if (DRMLISTEMPTY(&bo_gem->name_list))
-                DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
+                mos_gem_bo_add_named(bufmgr_gem, bo_gem);
     pthread_mutex_unlock(&bufmgr_gem->lock);
 
     if (drmPrimeHandleToFD(bufmgr_gem->fd, bo_gem->gem_handle,
@@ -3834,7 +4031,9 @@ mos_gem_bo_flink(struct mos_linux_bo *bo, uint32_t * name)
         bo_gem->reusable = false;
 
                 if (DRMLISTEMPTY(&bo_gem->name_list))
-                        DRMLISTADDTAIL(&bo_gem->name_list, &bufmgr_gem->named);
+                        mos_gem_bo_add_named(bufmgr_gem, bo_gem);
+                else if (bufmgr_gem->named_name_table)
+                        drmHashInsert(bufmgr_gem->named_name_table, bo_gem->global_name, bo_gem);
         pthread_mutex_unlock(&bufmgr_gem->lock);
     }
 
@@ -3857,6 +4056,44 @@ mos_bufmgr_gem_enable_reuse(struct mos_bufmgr *bufmgr)
     bufmgr_gem->bo_reuse = true;
 }
 
+/**
+ * Sets the memory budget in bytes of the buffer object reuse cache.
+ *
+ * Once the cached buffers exceed the budget, the least recently freed ones
+ * are released until the cache is back under 3/4 of it. 0 leaves only the
+ * age based expiry of cached buffers.
+ */
+void
+mos_bufmgr_gem_set_cache_budget(struct mos_bufmgr *bufmgr, uint64_t budget)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bufmgr;
+
+    if (bufmgr_gem == nullptr)
+        return;
+
+    bufmgr_gem->cache_budget = budget;
+}
+
+/**
+ * Reads the hit/miss/eviction counters of the buffer object reuse cache.
+ */
+int
+mos_bufmgr_gem_get_cache_stats(struct mos_bufmgr *bufmgr,
+                 struct mos_bufmgr_cache_stats *stats)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bufmgr;
+
+    if (bufmgr_gem == nullptr || stats == nullptr)
+        return -EINVAL;
+
+    stats->hits = __sync_fetch_and_add(&bufmgr_gem->cache_stats.hits, 0);
+    stats->misses = __sync_fetch_and_add(&bufmgr_gem->cache_stats.misses, 0);
+    stats->evictions = __sync_fetch_and_add(&bufmgr_gem->cache_stats.evictions, 0);
+    stats->cached_bytes = mos_gem_bo_cache_bytes(bufmgr_gem);
+
+    return 0;
+}
+
 /**
  * Enable use of fenced reloc type.
  *
@@ -4113,6 +4350,7 @@ add_bucket(struct mos_bufmgr_gem *bufmgr_gem, int size)
 
     DRMINITLISTHEAD(&bufmgr_gem->cache_bucket[i].head);
     bufmgr_gem->cache_bucket[i].size = size;
+    pthread_mutex_init(&bufmgr_gem->cache_bucket[i].lock, nullptr);
     bufmgr_gem->num_buckets++;
 }
 
@@ -4302,6 +4540,8 @@ mos_gem_context_create(struct mos_bufmgr *bufmgr)
     context->ctx_id = create.ctx_id;
     context->bufmgr = bufmgr;
 
+    context->exec_list = mos_gem_exec_list_create();
+
     ret = mos_gem_ctx_set_user_ctx_params(context);
 
     return context;
@@ -4327,6 +4567,7 @@ mos_gem_context_destroy(struct mos_linux_context *ctx)
         fprintf(stderr, "DRM_IOCTL_I915_GEM_CONTEXT_DESTROY failed: %s\n",
             strerror(errno));
 
+    mos_gem_exec_list_destroy(ctx->exec_list);
     free(ctx);
 }
 
@@ -4679,6 +4920,9 @@ mos_bufmgr_gem_init(int fd, int batch_size)
         bufmgr_gem = nullptr;
         goto exit;
     }
+    pthread_mutex_init(&bufmgr_gem->cache_evict_lock, nullptr);
+    pthread_mutex_init(&bufmgr_gem->exec_list.lock, nullptr);
+    pthread_mutex_init(&bufmgr_gem->vma_lock, nullptr);
 
     bufmgr_gem->mem_profiler_path = getenv("MEDIA_MEMORY_PROFILER_LOG");
     if (bufmgr_gem->mem_profiler_path != nullptr)
@@ -4866,6 +5110,9 @@ mos_bufmgr_gem_init(int fd, int batch_size)
     bufmgr_gem->bufmgr.bo_references = mos_gem_bo_references;
 
     DRMINITLISTHEAD(&bufmgr_gem->named);
+    /* Falls back to walking the named list if a table can't be created */
+    bufmgr_gem->named_handle_table = drmHashCreate();
+    bufmgr_gem->named_name_table = drmHashCreate();
     init_cache_buckets(bufmgr_gem);
 
     DRMLISTADD(&bufmgr_gem->managers, &bufmgr_list);
@@ -4926,6 +5173,8 @@ mos_gem_context_create_ext(struct mos_bufmgr *bufmgr, __u32 flags, bool bContext
     context->ctx_id = create.ctx_id;
     context->bufmgr = bufmgr;
 
+    context->exec_list = mos_gem_exec_list_create();
+
     ret = mos_gem_ctx_set_user_ctx_params(context);
 
     return context;
@@ -5028,6 +5277,8 @@ mos_gem_context_create_shared(struct mos_bufmgr *bufmgr, mos_linux_context* ctx,
         return nullptr;
     }
 
+    context->exec_list = mos_gem_exec_list_create();
+
     ret = mos_gem_ctx_set_user_ctx_params(context);
 
     return context;
@@ -97,6 +97,13 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
         }
         mos_bufmgr_gem_enable_reuse(m_bufmgr);
 
+        ReadUserSetting(
+            userSettingPtr,
+            value,
+            __MEDIA_USER_FEATURE_VALUE_BO_CACHE_BUDGET_MB,
+            MediaUserSetting::Group::Device);
+        mos_bufmgr_gem_set_cache_budget(m_bufmgr, (uint64_t)value * 1024 * 1024);
+
         osDriverContext->bufmgr                 = m_bufmgr;
 
         //Latency reducation:replace HWGetDeviceID to get device using ioctl from drm.
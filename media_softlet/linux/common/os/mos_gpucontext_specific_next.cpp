@@ -232,6 +232,17 @@ MOS_STATUS GpuContextSpecificNext::Init(OsContextNext *osContext,
     m_writeModeList = (bool *)MOS_AllocAndZeroMemory(sizeof(bool) * ALLOCATIONLIST_SIZE);
     MOS_OS_CHK_NULL_RETURN(m_writeModeList);
 
+    // Keep the index at most half full so probe sequences stay short
+    m_boIndexMask = 1;
+    while (m_boIndexMask < 2 * ALLOCATIONLIST_SIZE)
+    {
+        m_boIndexMask <<= 1;
+    }
+    m_boIndex = (BoIndexEntry *)MOS_AllocAndZeroMemory(sizeof(BoIndexEntry) * m_boIndexMask);
+    MOS_OS_CHK_NULL_RETURN(m_boIndex);
+    m_boIndexMask--;
+    m_boIndexGeneration = 1;
+
     m_GPUStatusTag = 1;
 
     StoreCreateOptions(createOption);
@@ -527,6 +538,7 @@ void GpuContextSpecificNext::Clear()
     MOS_SafeFreeMemory(m_patchLocationList);
     MOS_SafeFreeMemory(m_attachedResources);
     MOS_SafeFreeMemory(m_writeModeList);
+    MOS_SafeFreeMemory(m_boIndex);
 
     for (int i=0; i<MAX_ENGINE_INSTANCE_NUM; i++)
     {
@@ -550,16 +562,10 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
 
     MOS_OS_CHK_NULL_RETURN(m_attachedResources);
 
-    PMOS_RESOURCE registeredResources = m_attachedResources;
-    uint32_t      allocationIndex     = 0;
+    MOS_OS_CHK_NULL_RETURN(m_boIndex);
 
-    for ( allocationIndex = 0; allocationIndex < m_resCount; allocationIndex++, registeredResources++)
-    {
-        if (osResource->bo == registeredResources->bo)
-        {
-            break;
-        }
-    }
+    int32_t  registeredIndex = FindAllocationIndex(osResource->bo);
+    uint32_t allocationIndex = (registeredIndex >= 0) ? (uint32_t)registeredIndex : m_resCount;
 
     // Allocation list to be updated
     if (allocationIndex < m_maxNumAllocations)
@@ -568,6 +574,7 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
         if (allocationIndex == m_resCount)
         {
             m_resCount++;
+            InsertAllocationIndex(osResource->bo, allocationIndex);
         }
 
         // Set allocation
@@ -593,6 +600,53 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
     return MOS_STATUS_SUCCESS;
 }
 
+int32_t GpuContextSpecificNext::FindAllocationIndex(const MOS_LINUX_BO *bo)
+{
+    uint32_t slot = (uint32_t)(((uintptr_t)bo >> 4) * 0x9E3779B1u) & m_boIndexMask;
+
+    while (m_boIndex[slot].generation == m_boIndexGeneration)
+    {
+        if (m_boIndex[slot].bo == bo)
+        {
+            return (int32_t)m_boIndex[slot].allocationIndex;
+        }
+        slot = (slot + 1) & m_boIndexMask;
+    }
+
+    return -1;
+}
+
+void GpuContextSpecificNext::InsertAllocationIndex(const MOS_LINUX_BO *bo, uint32_t allocationIndex)
+{
+    // At most m_maxNumAllocations entries live in a table of twice that size,
+    // so a free slot is always found.
+    uint32_t slot = (uint32_t)(((uintptr_t)bo >> 4) * 0x9E3779B1u) & m_boIndexMask;
+
+    while (m_boIndex[slot].generation == m_boIndexGeneration)
+    {
+        slot = (slot + 1) & m_boIndexMask;
+    }
+
+    m_boIndex[slot].bo              = bo;
+    m_boIndex[slot].allocationIndex = allocationIndex;
+    m_boIndex[slot].generation      = m_boIndexGeneration;
+}
+
+void GpuContextSpecificNext::ResetAllocationIndex()
+{
+    if (m_boIndex == nullptr)
+    {
+        return;
+    }
+
+    // Bumping the generation empties every slot at once
+    if (++m_boIndexGeneration == 0)
+    {
+        MosUtilities::MosZeroMemory(m_boIndex, sizeof(BoIndexEntry) * (m_boIndexMask + 1));
+        m_boIndexGeneration = 1;
+    }
+}
+
 MOS_STATUS GpuContextSpecificNext::SetPatchEntry(
     MOS_STREAM_HANDLE streamState,
     PMOS_PATCH_ENTRY_PARAMS params)
@@ -1116,17 +1170,14 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
                 it++;
             }
 
-            for(auto allocIdx = 0; allocIdx < m_numAllocations && (!isSecondaryCmdBuf); allocIdx++)
+            int32_t allocIdx = isSecondaryCmdBuf ? -1 : FindAllocationIndex(tempCmdBo);
+            if (allocIdx >= 0 && (uint32_t)allocIdx < m_numAllocations)
             {
                 auto tempRes = (PMOS_RESOURCE)m_allocationList[allocIdx].hAllocation;
-                if (tempCmdBo == tempRes->bo)
-                {
-                    GraphicsResourceNext::LockParams param;
-                    param.m_writeRequest = true;
-                    tempRes->pGfxResourceNext->Lock(m_osContext, param);
-                    mappedResList.push_back(tempRes);
-                    break;
-                }
+                GraphicsResourceNext::LockParams param;
+                param.m_writeRequest = true;
+                tempRes->pGfxResourceNext->Lock(m_osContext, param);
+                mappedResList.push_back(tempRes);
             }
         }
 
@@ -1152,15 +1203,7 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
         {
             if (alloc_bo != tempCmdBo)
             {
-                auto item_ctx = perStreamParameters->contextOffsetList.begin();
-                for (; item_ctx != perStreamParameters->contextOffsetList.end(); item_ctx++)
-                {
-                    if (item_ctx->intel_context == perStreamParameters->intel_context && item_ctx->target_bo == alloc_bo)
-                    {
-                        boOffset = item_ctx->offset64;
-                        break;
-                    }
-                }
+                perStreamParameters->contextOffsetCache.Find(perStreamParameters->intel_context, alloc_bo, boOffset);
             }
         }
 
@@ -1507,6 +1550,7 @@ if (streamState->dumpCommandBuffer)
     m_currentNumPatchLocations = 0;
     MosUtilities::MosZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * m_maxNumAllocations);
     m_resCount = 0;
+    ResetAllocationIndex();
 
     MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * m_maxNumAllocations);
 finish:
@@ -1752,6 +1796,7 @@ void GpuContextSpecificNext::ResetGpuContextStatus()
 
     MosUtilities::MosZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * ALLOCATIONLIST_SIZE);
     m_resCount = 0;
+    ResetAllocationIndex();
 
     MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * ALLOCATIONLIST_SIZE);
 
@@ -223,6 +223,29 @@ protected:
     //!
     MOS_STATUS MapResourcesToAuxTable(mos_linux_bo *cmd_bo);
 
+    //!
+    //! \brief    Look up the allocation index registered for a bo
+    //! \param    [in] bo
+    //!           Buffer object to look up
+    //! \return   int32_t
+    //!           Allocation index, -1 if the bo is not registered
+    //!
+    int32_t FindAllocationIndex(const MOS_LINUX_BO *bo);
+
+    //!
+    //! \brief    Record the allocation index of a newly registered bo
+    //! \param    [in] bo
+    //!           Buffer object registered
+    //! \param    [in] allocationIndex
+    //!           Index in m_attachedResources and m_allocationList
+    //!
+    void InsertAllocationIndex(const MOS_LINUX_BO *bo, uint32_t allocationIndex);
+
+    //!
+    //! \brief    Drop all bo to allocation index entries
+    //!
+    void ResetAllocationIndex();
+
     MOS_VDBOX_NODE_IND GetVdboxNodeId(
         PMOS_COMMAND_BUFFER cmdBuffer);
 
@@ -315,6 +338,19 @@ private:
     PMOS_RESOURCE m_attachedResources = nullptr;  //!< Pointer to resources list
     bool         *m_writeModeList     = nullptr;  //!< Write mode
 
+    //! \brief    Open addressing index of bo to allocation index, keeps
+    //!           RegisterResource and nested BB lookups O(1). Slots whose
+    //!           generation differs from m_boIndexGeneration are empty.
+    struct BoIndexEntry
+    {
+        const MOS_LINUX_BO *bo;
+        uint32_t            allocationIndex;
+        uint32_t            generation;
+    };
+    BoIndexEntry *m_boIndex           = nullptr;
+    uint32_t      m_boIndexMask       = 0;  //!< table size - 1, table size is a power of 2
+    uint32_t      m_boIndexGeneration = 1;
+
     //! \brief    GPU Status tag
     uint32_t m_GPUStatusTag = 0;
 
@@ -850,22 +850,9 @@ MOS_STATUS GraphicsResourceSpecificNext::FreeExternalResource(
         MOS_OS_CHK_NULL_RETURN(streamState->perStreamParameters);
         auto perStreamParameters = (PMOS_CONTEXT)streamState->perStreamParameters;
 
-        if (perStreamParameters != nullptr && perStreamParameters->contextOffsetList.size())
+        if (perStreamParameters != nullptr)
         {
-            MOS_CONTEXT *pOsCtx   = perStreamParameters;
-            auto         item_ctx = pOsCtx->contextOffsetList.begin();
-
-            for (; item_ctx != pOsCtx->contextOffsetList.end();)
-            {
-                if (item_ctx->target_bo == resource->bo)
-                {
-                    item_ctx = pOsCtx->contextOffsetList.erase(item_ctx);
-                }
-                else
-                {
-                    item_ctx++;
-                }
-            }
+            perStreamParameters->contextOffsetCache.Remove(resource->bo);
         }
 
         resource->bo = nullptr;
@@ -52,5 +52,12 @@ MOS_STATUS MosUserSetting::InitMosUserSettingSpecific(MediaUserSettingSharedPtr
         0,
         true); //"Enable VM Bind."
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_BO_CACHE_BUDGET_MB,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Memory budget of the BO reuse cache in MB, 0 for age based expiry only."
+
     return MOS_STATUS_SUCCESS;
 }
@@ -26,11 +26,215 @@
 
 #include "mos_vma.h"
 
+/* Subtree size for holes that may be NULL */
+static inline uint64_t
+mos_vma_hole_max_size(const mos_vma_hole *hole)
+{
+    return hole ? hole->max_size : 0;
+}
+
+static inline void
+mos_vma_hole_update_max(mos_vma_hole *hole)
+{
+    uint64_t max_size = hole->size;
+
+    if (mos_vma_hole_max_size(hole->left) > max_size)
+        max_size = hole->left->max_size;
+    if (mos_vma_hole_max_size(hole->right) > max_size)
+        max_size = hole->right->max_size;
+
+    hole->max_size = max_size;
+}
+
+/* Refresh max_size from @hole up to the root after its size changed */
+static void
+mos_vma_tree_update(mos_vma_hole *hole)
+{
+    while (hole) {
+        uint64_t old_max = hole->max_size;
+
+        mos_vma_hole_update_max(hole);
+        if (hole->max_size == old_max)
+            break;
+        hole = hole->parent;
+    }
+}
+
+static inline void
+mos_vma_tree_replace_child(mos_vma_heap *heap, mos_vma_hole *parent,
+                           mos_vma_hole *old_child, mos_vma_hole *new_child)
+{
+    if (parent == NULL)
+        heap->root = new_child;
+    else if (parent->left == old_child)
+        parent->left = new_child;
+    else
+        parent->right = new_child;
+}
+
+/* Rotate @hole above its parent, keeping offset order */
+static void
+mos_vma_tree_rotate_up(mos_vma_heap *heap, mos_vma_hole *hole)
+{
+    mos_vma_hole *parent = hole->parent;
+    mos_vma_hole *grand  = parent->parent;
+
+    if (parent->left == hole) {
+        parent->left = hole->right;
+        if (hole->right)
+            hole->right->parent = parent;
+        hole->right = parent;
+    } else {
+        parent->right = hole->left;
+        if (hole->left)
+            hole->left->parent = parent;
+        hole->left = parent;
+    }
+    parent->parent = hole;
+    hole->parent   = grand;
+    mos_vma_tree_replace_child(heap, grand, parent, hole);
+
+    mos_vma_hole_update_max(parent);
+    mos_vma_hole_update_max(hole);
+}
+
+static void
+mos_vma_tree_insert(mos_vma_heap *heap, mos_vma_hole *hole)
+{
+    mos_vma_hole *parent = NULL;
+    mos_vma_hole **link  = &heap->root;
+
+    /* xorshift32, only needs to be well spread to keep the treap balanced */
+    heap->seed ^= heap->seed << 13;
+    heap->seed ^= heap->seed >> 17;
+    heap->seed ^= heap->seed << 5;
+
+    hole->priority = heap->seed;
+    hole->left     = NULL;
+    hole->right    = NULL;
+    hole->max_size = hole->size;
+
+    while (*link) {
+        parent = *link;
+        link   = (hole->offset < parent->offset) ? &parent->left : &parent->right;
+    }
+    hole->parent = parent;
+    *link        = hole;
+    mos_vma_tree_update(parent);
+
+    while (hole->parent && hole->parent->priority < hole->priority)
+        mos_vma_tree_rotate_up(heap, hole);
+}
+
+static void
+mos_vma_tree_remove(mos_vma_heap *heap, mos_vma_hole *hole)
+{
+    mos_vma_hole *parent;
+
+    /* Rotate the hole down to a leaf, promoting the child with higher priority */
+    while (hole->left && hole->right) {
+        if (hole->left->priority > hole->right->priority)
+            mos_vma_tree_rotate_up(heap, hole->left);
+        else
+            mos_vma_tree_rotate_up(heap, hole->right);
+    }
+
+    mos_vma_hole *child = hole->left ? hole->left : hole->right;
+
+    parent = hole->parent;
+    if (child)
+        child->parent = parent;
+    mos_vma_tree_replace_child(heap, parent, hole, child);
+    mos_vma_tree_update(parent);
+}
+
+/* Hole with the highest offset <= @offset */
+static mos_vma_hole *
+mos_vma_tree_floor(mos_vma_heap *heap, uint64_t offset)
+{
+    mos_vma_hole *node  = heap->root;
+    mos_vma_hole *floor = NULL;
+
+    while (node) {
+        if (node->offset <= offset) {
+            floor = node;
+            node  = node->right;
+        } else {
+            node = node->left;
+        }
+    }
+
+    return floor;
+}
+
+/* Highest hole fitting @size at @alignment, same pick as a high-to-low first fit */
+static mos_vma_hole *
+mos_vma_tree_find_high(mos_vma_hole *node, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (node == NULL || node->max_size < size)
+        return NULL;
+
+    mos_vma_hole *hole = mos_vma_tree_find_high(node->right, size, alignment, offset);
+    if (hole)
+        return hole;
+
+    if (size <= node->size) {
+        /* Compute the offset as the highest address where a chunk of the
+        * given size can be without going over the top of the hole.
+        *
+        * This calculation is known to not overflow because we know that
+        * hole->size + hole->offset can only overflow to 0 and size > 0.
+        */
+        uint64_t candidate = (node->size - size) + node->offset;
+
+        /* Align the offset.  We align down and not up because we are
+        * allocating from the top of the hole and not the bottom.
+        */
+        candidate = (candidate / alignment) * alignment;
+
+        if (candidate >= node->offset) {
+            *offset = candidate;
+            return node;
+        }
+    }
+
+    return mos_vma_tree_find_high(node->left, size, alignment, offset);
+}
+
+/* Lowest hole fitting @size at @alignment, same pick as a low-to-high first fit */
+static mos_vma_hole *
+mos_vma_tree_find_low(mos_vma_hole *node, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (node == NULL || node->max_size < size)
+        return NULL;
+
+    mos_vma_hole *hole = mos_vma_tree_find_low(node->left, size, alignment, offset);
+    if (hole)
+        return hole;
+
+    if (size <= node->size) {
+        uint64_t candidate = node->offset;
+
+        /* Align the offset */
+        uint64_t misalign = candidate % alignment;
+        uint64_t pad      = misalign ? alignment - misalign : 0;
+
+        if (pad <= node->size - size) {
+            *offset = candidate + pad;
+            return node;
+        }
+    }
+
+    return mos_vma_tree_find_low(node->right, size, alignment, offset);
+}
+
 void
 mos_vma_heap_init(mos_vma_heap *heap, uint64_t start, uint64_t size)
 {
     assert(heap);
     list_inithead(&heap->holes);
+    heap->root = NULL;
+    heap->seed = 0x9e3779b9;
     mos_vma_heap_free(heap, start, size);
 
     /* Default to using high addresses */
@@ -45,14 +249,40 @@ mos_vma_heap_finish(mos_vma_heap *heap)
     {
         free(hole);
     }
+    heap->root = NULL;
 }
 
 #ifdef _DEBUG
+static uint32_t
+mos_vma_tree_validate(const mos_vma_hole *node)
+{
+    if (node == NULL)
+        return 0;
+
+    uint64_t max_size = node->size;
+    if (node->left) {
+        assert(node->left->parent == node);
+        assert(node->left->offset < node->offset);
+        assert(node->left->priority <= node->priority);
+        max_size = node->left->max_size > max_size ? node->left->max_size : max_size;
+    }
+    if (node->right) {
+        assert(node->right->parent == node);
+        assert(node->right->offset > node->offset);
+        assert(node->right->priority <= node->priority);
+        max_size = node->right->max_size > max_size ? node->right->max_size : max_size;
+    }
+    assert(node->max_size == max_size);
+
+    return 1 + mos_vma_tree_validate(node->left) + mos_vma_tree_validate(node->right);
+}
+
 static void
 mos_vma_heap_validate(mos_vma_heap *heap)
 {
     assert(heap);
     uint64_t prev_offset = 0;
+    uint32_t count = 0;
 
     list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
     {
@@ -78,14 +308,18 @@ mos_vma_heap_validate(mos_vma_heap *heap)
                     hole->size + hole->offset < prev_offset);
         }
         prev_offset = hole->offset;
+        count++;
    }
+
+   assert(heap->root == NULL || heap->root->parent == NULL);
+   assert(mos_vma_tree_validate(heap->root) == count);
 }
 #else
 #define mos_vma_heap_validate(heap)
 #endif
 
 static void
-mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
+mos_vma_hole_alloc(mos_vma_heap *heap, mos_vma_hole *hole, uint64_t offset, uint64_t size)
 {
     assert(hole);
     assert(hole->offset <= offset);
@@ -93,6 +327,7 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
 
     if (offset == hole->offset && size == hole->size) {
         /* Just get rid of the hole. */
+        mos_vma_tree_remove(heap, hole);
         list_del(&hole->link);
         free(hole);
         return;
@@ -102,6 +337,7 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
     if (waste == 0) {
         /* We allocated at the top.  Shrink the hole down. */
         hole->size -= size;
+        mos_vma_tree_update(hole);
         return;
     }
 
@@ -109,6 +345,7 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
         /* We allocated at the bottom. Shrink the hole up. */
         hole->offset += size;
         hole->size -= size;
+        mos_vma_tree_update(hole);
         return;
     }
 
@@ -130,11 +367,13 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
     * original hole.
     */
     hole->size = offset - hole->offset;
+    mos_vma_tree_update(hole);
 
     /* Place the new hole before the old hole so that the list is in order
     * from high to low.
     */
     list_addtail(&high_hole->link, &hole->link);
+    mos_vma_tree_insert(heap, high_hole);
 }
 
 uint64_t
@@ -147,57 +386,19 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
 
     mos_vma_heap_validate(heap);
 
-    if (heap->alloc_high) {
-        list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
-        {
-            if (size > hole->size)
-                continue;
-
-            /* Compute the offset as the highest address where a chunk of the
-            * given size can be without going over the top of the hole.
-            *
-            * This calculation is known to not overflow because we know that
-            * hole->size + hole->offset can only overflow to 0 and size > 0.
-            */
-            uint64_t offset = (hole->size - size) + hole->offset;
-
-            /* Align the offset.  We align down and not up because we are
-            * allocating from the top of the hole and not the bottom.
-            */
-            offset = (offset / alignment) * alignment;
-
-            if (offset < hole->offset)
-            continue;
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
-    } else {
-        list_for_each_entry_safe_rev(mos_vma_hole, hole, &heap->holes, link) {
-            if (size > hole->size)
-                continue;
-
-            uint64_t offset = hole->offset;
-
-            /* Align the offset */
-            uint64_t misalign = offset % alignment;
-            if (misalign) {
-                uint64_t pad = alignment - misalign;
-                if (pad > hole->size - size)
-                    continue;
+    uint64_t offset = 0;
+    mos_vma_hole *hole = heap->alloc_high ?
+        mos_vma_tree_find_high(heap->root, size, alignment, &offset) :
+        mos_vma_tree_find_low(heap->root, size, alignment, &offset);
 
-                offset += pad;
-            }
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
+    if (hole == NULL) {
+        /* Failed to allocate */
+        return 0;
     }
 
-    /* Failed to allocate */
-    return 0;
+    mos_vma_hole_alloc(heap, hole, offset, size);
+    mos_vma_heap_validate(heap);
+    return offset;
 }
 
 bool
@@ -217,26 +418,21 @@ mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     */
     assert(offset + size == 0 || offset + size > offset);
 
-    /* Find the hole if one exists. */
-    list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
-    {
-        if (hole->offset > offset)
-            continue;
-
-        /* Holes are ordered high-to-low so the first hole we find with
-        * hole->offset <= is our hole.  If it's not big enough to contain the
-        * requested range, then the allocation fails.
-        */
-        assert(hole->offset <= offset);
-        if (hole->size < offset - hole->offset + size)
-            return false;
-
-        mos_vma_hole_alloc(hole, offset, size);
-        return true;
+    /* The hole with the highest offset <= the address is our hole.  If it's
+    * not big enough to contain the requested range, then the allocation fails.
+    */
+    mos_vma_hole *hole = mos_vma_tree_floor(heap, offset);
+    if (hole == NULL) {
+        /* We didn't find a suitable hole */
+        return false;
     }
 
-    /* We didn't find a suitable hole */
-    return false;
+    assert(hole->offset <= offset);
+    if (hole->size < offset - hole->offset + size)
+        return false;
+
+    mos_vma_hole_alloc(heap, hole, offset, size);
+    return true;
 }
 
 void
@@ -258,16 +454,16 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
 
     mos_vma_heap_validate(heap);
 
-    /* Find immediately higher and lower holes if they exist. */
+    /* Find immediately higher and lower holes if they exist, the high hole
+    * precedes the low one in the high-to-low list.
+    */
     mos_vma_hole *high_hole = NULL, *low_hole = NULL;
-    list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
-    {
-        if (hole->offset <= offset) {
-            low_hole = hole;
-            break;
-        }
-        high_hole = hole;
-    }
+    struct list_head *high_link;
+
+    low_hole  = mos_vma_tree_floor(heap, offset);
+    high_link = low_hole ? low_hole->link.prev : heap->holes.prev;
+    if (high_link != &heap->holes)
+        high_hole = LIST_ENTRY(mos_vma_hole, high_link, link);
 
     if (high_hole)
     {
@@ -284,16 +480,20 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
 
     if (low_adjacent && high_adjacent) {
         /* Merge the two holes */
+        mos_vma_tree_remove(heap, high_hole);
         low_hole->size += size + high_hole->size;
+        mos_vma_tree_update(low_hole);
         list_del(&high_hole->link);
         free(high_hole);
     } else if (low_adjacent) {
         /* Merge into the low hole */
         low_hole->size += size;
+        mos_vma_tree_update(low_hole);
     } else if (high_adjacent) {
-        /* Merge into the high hole */
+        /* Merge into the high hole, its order among the holes is unchanged */
         high_hole->offset = offset;
         high_hole->size += size;
+        mos_vma_tree_update(high_hole);
     } else {
         /* Neither hole is adjacent; make a new one */
         mos_vma_hole *hole = (mos_vma_hole*)calloc(1, sizeof(*hole));
@@ -308,6 +508,7 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
                 list_add(&hole->link, &high_hole->link);
             else
                 list_add(&hole->link, &heap->holes);
+            mos_vma_tree_insert(heap, hole);
         }
     }
 
@@ -37,9 +37,18 @@
 extern "C" {
 #endif
 
+typedef struct _mos_vma_hole mos_vma_hole;
+
 typedef struct _mos_vma_heap {
+   /** Holes ordered from high to low addresses, used for coalescing */
    struct list_head holes;
 
+   /** Root of the treap indexing the same holes by offset */
+   mos_vma_hole *root;
+
+   /** State of the generator for treap priorities */
+   uint32_t seed;
+
    /** If true, util_vma_heap_alloc will prefer high addresses
     *
     * Default is true.
@@ -47,11 +56,20 @@ typedef struct _mos_vma_heap {
    bool alloc_high;
 } mos_vma_heap;
 
-typedef struct _mos_vma_hole {
+struct _mos_vma_hole {
    struct list_head link;
    uint64_t offset;
    uint64_t size;
-} mos_vma_hole;
+
+   /** Treap links, left holds lower and right holds higher offsets */
+   mos_vma_hole *parent;
+   mos_vma_hole *left;
+   mos_vma_hole *right;
+
+   /** Largest hole size in this subtree, lets alloc skip subtrees that can't fit */
+   uint64_t max_size;
+   uint32_t priority;
+};
 
 //!
 //! \brief  Initialize vma heap
@@ -0,0 +1,287 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_trace_ring.cpp
+//! \brief    Buffered binary backend for media trace events
+//!
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include "mos_trace_ring.h"
+
+std::atomic<bool>                       MosTraceRing::m_enabled(false);
+int32_t                                 MosTraceRing::m_fd             = -1;
+std::mutex                              MosTraceRing::m_mutex;
+std::condition_variable                 MosTraceRing::m_cond;
+bool                                    MosTraceRing::m_stop           = false;
+std::thread                             MosTraceRing::m_flusher;
+std::vector<MosTraceRing::Ring *>       MosTraceRing::m_rings;
+uint64_t                                MosTraceRing::m_droppedRetired = 0;
+thread_local MosTraceRing::RingOwner    MosTraceRing::m_owner;
+
+MosTraceRing::RingOwner::~RingOwner()
+{
+    if (ring == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_flusher.joinable())
+    {
+        // Let the flush thread write out what is left before freeing it
+        ring->orphaned.store(true, std::memory_order_release);
+    }
+    else
+    {
+        m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), ring), m_rings.end());
+        m_droppedRetired += ring->dropped.load(std::memory_order_relaxed);
+        delete ring;
+    }
+    ring = nullptr;
+}
+
+MosTraceRing::Ring *MosTraceRing::GetThreadRing()
+{
+    if (m_owner.ring)
+    {
+        return m_owner.ring;
+    }
+
+    // Rings live as long as their thread, which may outlast MosOsUtilitiesClose,
+    // so they are kept out of the MOS allocation counters on purpose.
+    Ring *ring = new (std::nothrow) Ring;
+    if (ring == nullptr)
+    {
+        return nullptr;
+    }
+    ring->tid = (uint32_t)syscall(SYS_gettid);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rings.push_back(ring);
+    m_owner.ring = ring;
+
+    return ring;
+}
+
+void MosTraceRing::Write(const void *event, uint32_t size)
+{
+    Ring *ring = GetThreadRing();
+    if (ring == nullptr)
+    {
+        return;
+    }
+
+    uint32_t total = sizeof(MOS_TRACE_RING_RECORD) + size;
+    uint64_t head  = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail  = ring->tail.load(std::memory_order_acquire);
+    if (m_ringSize - (head - tail) < total)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    MOS_TRACE_RING_RECORD record;
+    record.timestamp = (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    record.tid       = ring->tid;
+    record.size      = size;
+
+    // Records may wrap around the end of the ring, copy in up to two pieces
+    const uint8_t *src[2]  = {(const uint8_t *)&record, (const uint8_t *)event};
+    uint32_t       len[2]  = {sizeof(record), size};
+    uint64_t       pos     = head;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        uint32_t offset = (uint32_t)(pos & (m_ringSize - 1));
+        uint32_t first  = std::min(len[i], m_ringSize - offset);
+        memcpy(ring->data + offset, src[i], first);
+        memcpy(ring->data, src[i] + first, len[i] - first);
+        pos += len[i];
+    }
+
+    ring->head.store(head + total, std::memory_order_release);
+}
+
+void MosTraceRing::Drain(std::vector<uint8_t> &buffer)
+{
+    buffer.clear();
+
+    auto iterator = m_rings.begin();
+    while (iterator != m_rings.end())
+    {
+        Ring *ring     = *iterator;
+        bool  orphaned = ring->orphaned.load(std::memory_order_acquire);
+        uint64_t head  = ring->head.load(std::memory_order_acquire);
+        uint64_t tail  = ring->tail.load(std::memory_order_relaxed);
+
+        if (head != tail)
+        {
+            uint32_t offset = (uint32_t)(tail & (m_ringSize - 1));
+            uint32_t size   = (uint32_t)(head - tail);
+            uint32_t first  = std::min(size, m_ringSize - offset);
+
+            buffer.insert(buffer.end(), ring->data + offset, ring->data + offset + first);
+            buffer.insert(buffer.end(), ring->data, ring->data + size - first);
+        }
+        ring->tail.store(head, std::memory_order_release);
+
+        if (orphaned)
+        {
+            m_droppedRetired += ring->dropped.load(std::memory_order_relaxed);
+            delete ring;
+            iterator = m_rings.erase(iterator);
+        }
+        else
+        {
+            ++iterator;
+        }
+    }
+}
+
+void MosTraceRing::WriteOut(int32_t fd, const std::vector<uint8_t> &buffer)
+{
+    size_t written = 0;
+    while (fd >= 0 && written < buffer.size())
+    {
+        ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+        if (ret <= 0)
+        {
+            break;
+        }
+        written += ret;
+    }
+}
+
+void MosTraceRing::FlushThread()
+{
+    // Kept across periods so the copy buffer only grows during warm up
+    std::vector<uint8_t> buffer;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        m_cond.wait_for(lock, std::chrono::milliseconds(m_flushIntervalMs), [] { return m_stop; });
+        Drain(buffer);
+
+        // Producers registering a ring must not wait for the file system
+        int32_t fd = m_fd;
+        lock.unlock();
+        WriteOut(fd, buffer);
+        lock.lock();
+    }
+}
+
+bool MosTraceRing::Init(const char *path)
+{
+    if (path == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_enabled.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    m_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    // A joinable flush thread left at exit would terminate the process
+    static std::once_flag atExitOnce;
+    std::call_once(atExitOnce, [] { atexit(Close); });
+
+    m_stop    = false;
+    m_flusher = std::thread(FlushThread);
+    m_enabled.store(true, std::memory_order_release);
+
+    return true;
+}
+
+void MosTraceRing::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        m_enabled.store(false, std::memory_order_relaxed);
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    m_flusher.join();
+
+    std::vector<uint8_t> buffer;
+    uint64_t             dropped = 0;
+    int32_t              fd      = -1;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Drain(buffer);
+
+        dropped = m_droppedRetired;
+        for (auto ring : m_rings)
+        {
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+
+        fd   = m_fd;
+        m_fd = -1;
+    }
+
+    WriteOut(fd, buffer);
+
+    MOS_TRACE_RING_RECORD record = {};
+    record.size                  = sizeof(dropped);
+    struct iovec iov[2]          = {{&record, sizeof(record)}, {&dropped, sizeof(dropped)}};
+    ssize_t ret                  = writev(fd, iov, 2);
+    (void)ret;
+
+    close(fd);
+}
+
+uint64_t MosTraceRing::GetDroppedEvents()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t dropped = m_droppedRetired;
+    for (auto ring : m_rings)
+    {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+
+    return dropped;
+}
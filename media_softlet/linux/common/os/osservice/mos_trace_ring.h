@@ -0,0 +1,149 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_trace_ring.h
+//! \brief    Buffered binary backend for media trace events
+//! \details  Each thread records trace events into its own single producer ring
+//!           buffer without locks or syscalls. A background thread drains all rings
+//!           into the output file in large writes. Events which do not fit in a
+//!           full ring are dropped and counted.
+//!
+//!           The output file is a sequence of records, each a MOS_TRACE_RING_RECORD
+//!           followed by \a size bytes of the raw event exactly as it would have been
+//!           written to trace_marker_raw. A final record with tid 0 carries the total
+//!           number of dropped events as a uint64_t.
+//!
+#ifndef __MOS_TRACE_RING_H__
+#define __MOS_TRACE_RING_H__
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "media_class_trace.h"
+
+//!
+//! \brief    Record header preceding every event in the output file
+//!
+struct MOS_TRACE_RING_RECORD
+{
+    uint64_t timestamp;  //!< CLOCK_MONOTONIC time of the event in ns
+    uint32_t tid;        //!< Thread which emitted the event, 0 for the drop count trailer
+    uint32_t size;       //!< Size of the event following this header
+};
+
+class MosTraceRing
+{
+public:
+    MosTraceRing()  = delete;
+    ~MosTraceRing() = delete;
+
+    //!
+    //! \brief    Open the output file and start the flush thread
+    //! \param    [in] path
+    //!           Output file path
+    //! \return   bool
+    //!           true if the backend is ready to take events
+    //!
+    static bool Init(const char *path);
+
+    //!
+    //! \brief    Drain all rings, stop the flush thread and close the output file
+    //! \details  Also runs at exit if the backend is still open.
+    //!
+    static void Close();
+
+    //!
+    //! \brief    Check whether events are routed to the ring backend
+    //!
+    static bool IsEnabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    //!
+    //! \brief    Record one event into the calling thread's ring
+    //! \param    [in] event
+    //!           Raw event data, header included
+    //! \param    [in] size
+    //!           Size of the event in bytes
+    //!
+    static void Write(const void *event, uint32_t size);
+
+    //!
+    //! \brief    Get the number of events dropped because a ring was full
+    //!
+    static uint64_t GetDroppedEvents();
+
+    static const uint32_t m_ringSize        = 0x40000;  //!< Per thread ring size in bytes, power of 2
+    static const uint32_t m_flushIntervalMs = 10;       //!< Period of the flush thread
+
+private:
+    //!
+    //! \brief    Single producer single consumer byte ring owned by one thread
+    //!
+    struct Ring
+    {
+        std::atomic<uint64_t> head     = {0};      //!< Write position, advanced by the owning thread
+        std::atomic<uint64_t> tail     = {0};      //!< Read position, advanced by the flush thread
+        std::atomic<uint64_t> dropped  = {0};      //!< Events dropped on a full ring
+        std::atomic<bool>     orphaned = {false};  //!< Owning thread exited, free once drained
+        uint32_t              tid      = 0;
+        uint8_t               data[m_ringSize];
+    };
+
+    //!
+    //! \brief    Releases the calling thread's ring on thread exit
+    //!
+    struct RingOwner
+    {
+        ~RingOwner();
+        Ring *ring = nullptr;
+    };
+
+    static Ring *GetThreadRing();
+    static void  FlushThread();
+
+    //!
+    //! \brief    Copy the pending events of all rings and free drained orphaned rings
+    //! \details  Called with m_mutex held. The copy is written by WriteOut after
+    //!           unlocking, so the rings are free for new events meanwhile.
+    //! \param    [out] buffer
+    //!           Pending events of all rings
+    //!
+    static void Drain(std::vector<uint8_t> &buffer);
+
+    static void WriteOut(int32_t fd, const std::vector<uint8_t> &buffer);
+
+    static std::atomic<bool>       m_enabled;
+    static int32_t                 m_fd;
+    static std::mutex              m_mutex;         //!< Guards m_rings, m_fd and m_droppedRetired
+    static std::condition_variable m_cond;
+    static bool                    m_stop;
+    static std::thread             m_flusher;
+    static std::vector<Ring *>     m_rings;
+    static uint64_t                m_droppedRetired;  //!< Drop count of rings already freed
+    static thread_local RingOwner  m_owner;
+
+MEDIA_CLASS_DEFINE_END(MosTraceRing)
+};
+
+#endif  // __MOS_TRACE_RING_H__
@@ -42,6 +42,7 @@
 #include <sys/mman.h>
 #include "mos_user_setting.h"
 #include "mos_utilities_specific.h"
+#include "mos_trace_ring.h"
 #include "mos_utilities.h"
 #include "mos_util_debug.h"
 #include "inttypes.h"
@@ -87,6 +88,34 @@ MosMutex          MosUtilitiesSpecificNext::m_userSettingMutex;
 #define TRACE_EVENT_HEADER_SIZE        (sizeof(uint32_t)*3)
 #define TRACE_EVENT_MAX_DATA_SIZE      (TRACE_EVENT_MAX_SIZE - TRACE_EVENT_HEADER_SIZE - sizeof(uint16_t)) // Trace info data size section is in uint16_t
 
+//!
+//! \brief Per thread scratch buffer for events too large for the stack buffer
+//!
+static thread_local uint8_t g_traceEventBuf[TRACE_EVENT_MAX_SIZE];
+
+//!
+//! \brief Whether trace events have anywhere to go, trace marker or ring backend
+//!
+static inline bool MosTraceOutputValid()
+{
+    return MosUtilitiesSpecificNext::m_mosTraceFd >= 0 || MosTraceRing::IsEnabled();
+}
+
+//!
+//! \brief Emits one complete trace event
+//!
+static inline void MosTraceOutput(const void *event, uint32_t size)
+{
+    if (MosTraceRing::IsEnabled())
+    {
+        MosTraceRing::Write(event, size);
+    }
+    else
+    {
+        size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, event, size);
+    }
+}
+
 //!
 //! \brief for int64_t/uint64_t format print warning
 //!
@@ -2415,6 +2444,13 @@ void MosUtilities::MosTraceEventInit()
         close(MosUtilitiesSpecificNext::m_mosTraceFd);
         MosUtilitiesSpecificNext::m_mosTraceFd = -1;
     }
+
+    // Buffered binary output to a file instead of one trace marker write per event
+    val = getenv("GFX_MEDIA_TRACE_RING");
+    if (val && MosTraceRing::Init(val))
+    {
+        return;
+    }
     MosUtilitiesSpecificNext::m_mosTraceFd = open(MosUtilitiesSpecificNext::m_mosTracePath, O_WRONLY);
     return;
 }
@@ -2424,6 +2460,7 @@ void MosUtilities::MosTraceEventClose()
     m_mosTraceEnable.Reset();
     m_mosTraceFilter.Reset();
     m_mosTraceLevel.Reset();
+    MosTraceRing::Close();
     if (m_mosTraceControlData)
     {
         munmap((void *)m_mosTraceControlData, TRACE_SETTING_SIZE);
@@ -2457,7 +2494,7 @@ void MosUtilities::MosTraceEvent(
         return; // skip if trace not enabled from share memory
     }
 
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 &&
+    if (MosTraceOutputValid() &&
         TRACE_EVENT_MAX_SIZE > dwSize1 + dwSize2 + TRACE_EVENT_HEADER_SIZE)
     {
         uint8_t traceBuf[256];
@@ -2478,7 +2515,7 @@ void MosUtilities::MosTraceEvent(
 
         if (dwSize1 + dwSize2 + TRACE_EVENT_HEADER_SIZE > sizeof(traceBuf))
         {
-            pTraceBuf = (uint8_t *)MOS_AllocAndZeroMemory(TRACE_EVENT_MAX_SIZE);
+            pTraceBuf = g_traceEventBuf;
         }
 
         if (pTraceBuf)
@@ -2501,11 +2538,7 @@ void MosUtilities::MosTraceEvent(
                 MOS_SecureMemcpy(pTraceBuf+nLen, dwSize2, pArg2, dwSize2);
                 nLen += dwSize2;
             }
-            size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
-            if (traceBuf != pTraceBuf)
-            {
-                MOS_FreeMemory(pTraceBuf);
-            }
+            MosTraceOutput(pTraceBuf, nLen);
         }
 #if Backtrace_FOUND
         if (m_mosTraceFilter(TR_KEY_CALL_STACK))
@@ -2524,7 +2557,7 @@ void MosUtilities::MosTraceEvent(
                 header[2] = 0;
                 header[3] = (uint32_t)num;
                 nLen += num*sizeof(void *);
-                size_t ret = write(MosUtilitiesSpecificNext::m_mosTraceFd, traceBuf, nLen);
+                MosTraceOutput(traceBuf, nLen);
             }
         }
 #endif
@@ -2554,53 +2587,48 @@ void MosUtilities::MosTraceDataDump(
     const void *pBuf,
     uint32_t    dwSize)
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 && pBuf && pcName)
-    {
-        uint8_t *pTraceBuf = (uint8_t *)MOS_AllocAndZeroMemory(TRACE_EVENT_MAX_SIZE);
-        size_t writeSize = 0;
-
-        if (pTraceBuf)
+    if (MosTraceOutputValid() && pBuf && pcName)
+    {
+        uint8_t *pTraceBuf = g_traceEventBuf;
+
+        // trace header
+        uint32_t *header = (uint32_t *)pTraceBuf;
+        uint32_t    nLen = strlen(pcName) & 0xff;// 255 max pcName length
+
+        header[0] = 0x494D5445; // IMTE (IntelMediaTraceEvent) as ftrace raw marker tag
+        header[1] = (EVENT_DATA_DUMP << 16) | (8 + nLen + 1);
+        header[2] = EVENT_TYPE_START;
+        header[3] = dwSize;
+        header[4] = flags;
+        memcpy(&header[5], pcName, nLen);
+        ((uint8_t *)&header[5])[nLen] = 0;
+        nLen += TRACE_EVENT_HEADER_SIZE + 8 + 1;
+        MosTraceOutput(pTraceBuf, nLen);
+        // send dump data
+        header[2] = EVENT_TYPE_INFO;
+        const uint8_t *pData = static_cast<const uint8_t *>(pBuf);
+        while (dwSize > 0)
         {
-            // trace header
-            uint32_t *header = (uint32_t *)pTraceBuf;
-            uint32_t    nLen = strlen(pcName) & 0xff;// 255 max pcName length
-
-            header[0] = 0x494D5445; // IMTE (IntelMediaTraceEvent) as ftrace raw marker tag
-            header[1] = (EVENT_DATA_DUMP << 16) | (8 + nLen + 1);
-            header[2] = EVENT_TYPE_START;
-            header[3] = dwSize;
-            header[4] = flags;
-            memcpy(&header[5], pcName, nLen);
-            nLen += TRACE_EVENT_HEADER_SIZE + 8 + 1;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
-            // send dump data
-            header[2] = EVENT_TYPE_INFO;
-            const uint8_t *pData = static_cast<const uint8_t *>(pBuf);
-            while (dwSize > 0)
+            uint32_t size = dwSize;
+            if (size > TRACE_EVENT_MAX_DATA_SIZE)
             {
-                uint32_t size = dwSize;
-                if (size > TRACE_EVENT_MAX_DATA_SIZE)
-                {
-                    size = TRACE_EVENT_MAX_DATA_SIZE;
-                }
-                uint16_t len = ((size + 3) & ~3) / sizeof(uint32_t);
-                uint8_t *pDst = (uint8_t *)&header[3];
-
-                header[1] = (EVENT_DATA_DUMP << 16) | (size + sizeof(len));
-                memcpy(pDst, &len, sizeof(len));
-                memcpy(pDst+sizeof(len), pData, size);
-                nLen = TRACE_EVENT_HEADER_SIZE + size + sizeof(len);
-                writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
-                dwSize -= size;
-                pData += size;
+                size = TRACE_EVENT_MAX_DATA_SIZE;
             }
-            // send dump end
-            header[1] = EVENT_DATA_DUMP << 16;
-            header[2] = EVENT_TYPE_END;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, TRACE_EVENT_HEADER_SIZE);
-
-            MOS_FreeMemory(pTraceBuf);
+            uint16_t len = ((size + 3) & ~3) / sizeof(uint32_t);
+            uint8_t *pDst = (uint8_t *)&header[3];
+
+            header[1] = (EVENT_DATA_DUMP << 16) | (size + sizeof(len));
+            memcpy(pDst, &len, sizeof(len));
+            memcpy(pDst+sizeof(len), pData, size);
+            nLen = TRACE_EVENT_HEADER_SIZE + size + sizeof(len);
+            MosTraceOutput(pTraceBuf, nLen);
+            dwSize -= size;
+            pData += size;
         }
+        // send dump end
+        header[1] = EVENT_DATA_DUMP << 16;
+        header[2] = EVENT_TYPE_END;
+        MosTraceOutput(pTraceBuf, TRACE_EVENT_HEADER_SIZE);
     }
 }
 
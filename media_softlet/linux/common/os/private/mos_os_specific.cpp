@@ -923,11 +923,7 @@ MOS_STATUS Mos_DestroyInterface(PMOS_INTERFACE osInterface)
         perStreamParameters->m_waTable.reset();
         Mos_Specific_ClearGpuContext(perStreamParameters);
 
-        if (perStreamParameters->contextOffsetList.size())
-        {
-            perStreamParameters->contextOffsetList.clear();
-            perStreamParameters->contextOffsetList.shrink_to_fit();
-        }
+        perStreamParameters->contextOffsetCache.Clear();
 
         if(Mos_Solo_IsEnabled(perStreamParameters))
         {